@@ -0,0 +1,569 @@
+/******************************************************************************
+ *
+ * File        : Aggregation.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define aggregates computed over the columns of an
+ *               inventory, with AVX2 kernels and scalar fallbacks.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include "Aggregation.h"
+
+// AVX2 kernels are only built for x86 compilers that can target them per
+// function, so that the rest of the program runs on any x86 processor
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define AGGREGATION_AVX2
+#include <immintrin.h>
+#define AVX2_KERNEL __attribute__((target("avx2,popcnt,bmi")))
+#endif
+
+using namespace std;
+
+// Instruction set the aggregation kernels run with
+static SimdLevel simdLevel = getSupportedSimdLevel();
+
+/**
+ * Retrieves the best instruction set supported by the processor
+ *
+ * @return                          supported instruction set
+ */
+SimdLevel getSupportedSimdLevel() {
+#ifdef AGGREGATION_AVX2
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::AVX2;
+    }
+#endif
+
+    return SimdLevel::Scalar;
+}
+
+/**
+ * Retrieves the instruction set the aggregation kernels run with
+ *
+ * @return                          instruction set in use
+ */
+SimdLevel getSimdLevel() {
+    return simdLevel;
+}
+
+/**
+ * Sets the instruction set the aggregation kernels run with, which is
+ * limited to the best one the processor supports
+ *
+ * @param level                     instruction set to use
+ */
+void setSimdLevel(SimdLevel level) {
+    simdLevel = level == SimdLevel::AVX2 ? getSupportedSimdLevel()
+                                         : SimdLevel::Scalar;
+}
+
+#ifdef AGGREGATION_AVX2
+
+// Amount of 32 bit lanes in an AVX2 register
+static const size_t LANES = 8;
+
+/**
+ * Builds the mask of which of eight items starting at a slot pass a filter,
+ * each lane all ones if the item passes and all zeros if not
+ *
+ * @param columns                   columns of the items
+ * @param filter                    filter to check
+ * @param slot                      slot of the first item
+ * @return                          mask of the items that pass
+ */
+AVX2_KERNEL
+static inline __m256i filterMask(const StockColumns &columns,
+                                 const ColumnFilter &filter, size_t slot) {
+    __m256i mask = _mm256_set1_epi32(-1);
+
+    if (filter.matchComponentType) {
+        const void *types = columns.getComponentTypes().data() + slot;
+        __m256i type = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(static_cast<const __m128i *>(types)));
+        __m256i wanted = _mm256_set1_epi32(
+                static_cast<uint8_t>(filter.componentType));
+        mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(type, wanted));
+    }
+
+    // Only transistors have a device type, the others holding NPN
+    if (filter.matchDeviceType) {
+        const void *types = columns.getComponentTypes().data() + slot;
+        __m256i type = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(static_cast<const __m128i *>(types)));
+        __m256i transistor = _mm256_set1_epi32(
+                static_cast<uint8_t>(ComponentType::Transistor));
+        mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(type, transistor));
+
+        const void *devices = columns.getDeviceTypes().data() + slot;
+        __m256i device = _mm256_cvtepu8_epi32(
+                _mm_loadl_epi64(static_cast<const __m128i *>(devices)));
+        __m256i wanted = _mm256_set1_epi32(
+                static_cast<uint8_t>(filter.deviceType));
+        mask = _mm256_and_si256(mask, _mm256_cmpeq_epi32(device, wanted));
+    }
+
+    if (filter.inStockOnly) {
+        __m256i amount = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(
+                columns.getStockAmounts().data() + slot));
+        mask = _mm256_and_si256(mask, _mm256_cmpgt_epi32(
+                amount, _mm256_setzero_si256()));
+    }
+
+    return mask;
+}
+
+/**
+ * Counts the lanes of a mask that are set
+ *
+ * @param mask                      mask of all ones/all zeros lanes
+ * @return                          amount of lanes set
+ */
+AVX2_KERNEL
+static inline size_t countLanes(__m256i mask) {
+    return __builtin_popcount(_mm256_movemask_ps(_mm256_castsi256_ps(mask)));
+}
+
+/**
+ * Widens eight 32 bit integers into two registers of four 64 bit integers
+ *
+ * @param values                    integers to widen
+ * @param low                       widened first four integers
+ * @param high                      widened last four integers
+ */
+AVX2_KERNEL
+static inline void widen(__m256i values, __m256i &low, __m256i &high) {
+    low = _mm256_cvtepi32_epi64(_mm256_castsi256_si128(values));
+    high = _mm256_cvtepi32_epi64(_mm256_extracti128_si256(values, 1));
+}
+
+/**
+ * Adds up the four 64 bit integers of a register
+ *
+ * @param values                    integers to add up
+ * @return                          total of the integers
+ */
+AVX2_KERNEL
+static inline long long horizontalSum(__m256i values) {
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(lanes), values);
+
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3];
+}
+
+// AVX2 versions of the aggregates defined below, which work through eight
+// slots at a time and finish the last few slots one at a time
+
+AVX2_KERNEL
+static size_t countItemsAVX2(const StockColumns &columns,
+                             const ColumnFilter &filter) {
+    size_t size = columns.getSize();
+    size_t count = 0;
+    size_t slot = 0;
+
+    for (; slot + LANES <= size; slot += LANES) {
+        count += countLanes(filterMask(columns, filter, slot));
+    }
+
+    for (; slot < size; slot++) {
+        count += passesFilter(columns, filter, slot);
+    }
+
+    return count;
+}
+
+AVX2_KERNEL
+static size_t countPricesAboveAVX2(const StockColumns &columns,
+                                   int priceLimit) {
+    const int *unitPrices = columns.getUnitPrices().data();
+    size_t size = columns.getSize();
+    __m256i limit = _mm256_set1_epi32(priceLimit);
+    size_t count = 0;
+    size_t slot = 0;
+
+    for (; slot + LANES <= size; slot += LANES) {
+        __m256i prices = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(unitPrices + slot));
+        count += countLanes(_mm256_cmpgt_epi32(prices, limit));
+    }
+
+    for (; slot < size; slot++) {
+        count += unitPrices[slot] > priceLimit;
+    }
+
+    return count;
+}
+
+AVX2_KERNEL
+static long long sumStockAmountsAVX2(const StockColumns &columns,
+                                     const ColumnFilter &filter) {
+    const int *stockAmounts = columns.getStockAmounts().data();
+    size_t size = columns.getSize();
+    __m256i totals = _mm256_setzero_si256();
+    size_t slot = 0;
+
+    // Widens the amounts so that the totals cannot overflow
+    for (; slot + LANES <= size; slot += LANES) {
+        __m256i amounts = _mm256_and_si256(
+                filterMask(columns, filter, slot),
+                _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(stockAmounts +
+                                                          slot)));
+        __m256i low, high;
+        widen(amounts, low, high);
+        totals = _mm256_add_epi64(totals, _mm256_add_epi64(low, high));
+    }
+
+    long long total = horizontalSum(totals);
+
+    for (; slot < size; slot++) {
+        if (passesFilter(columns, filter, slot)) {
+            total += stockAmounts[slot];
+        }
+    }
+
+    return total;
+}
+
+AVX2_KERNEL
+static double sumValuesAVX2(const StockColumns &columns,
+                            const ColumnFilter &filter) {
+    const double *values = columns.getValues().data();
+    size_t size = columns.getSize();
+    double total = 0;
+    size_t slot = 0;
+
+    // Floating point addition is not associative, so the filtered values
+    // are added one at a time in slot order to give exactly the total of a
+    // scalar loop. Values of items that fail the filter are zeroed, and
+    // adding zero leaves the total unchanged.
+    for (; slot + LANES <= size; slot += LANES) {
+        __m256i mask = filterMask(columns, filter, slot);
+
+        if (_mm256_testz_si256(mask, mask)) {
+            continue;
+        }
+
+        __m256i lowMask, highMask;
+        widen(mask, lowMask, highMask);
+
+        alignas(32) double lanes[LANES];
+        _mm256_store_pd(lanes, _mm256_and_pd(
+                _mm256_castsi256_pd(lowMask), _mm256_loadu_pd(values + slot)));
+        _mm256_store_pd(lanes + 4, _mm256_and_pd(
+                _mm256_castsi256_pd(highMask),
+                _mm256_loadu_pd(values + slot + 4)));
+
+        for (size_t lane = 0; lane < LANES; lane++) {
+            total += lanes[lane];
+        }
+    }
+
+    for (; slot < size; slot++) {
+        if (passesFilter(columns, filter, slot)) {
+            total += values[slot];
+        }
+    }
+
+    return total;
+}
+
+AVX2_KERNEL
+static long long sumStockValuesAVX2(const StockColumns &columns,
+                                    const ColumnFilter &filter) {
+    const int *stockAmounts = columns.getStockAmounts().data();
+    const int *unitPrices = columns.getUnitPrices().data();
+    size_t size = columns.getSize();
+    __m256i totals = _mm256_setzero_si256();
+    size_t slot = 0;
+
+    // Multiplies the widened amounts and prices into 64 bit products
+    for (; slot + LANES <= size; slot += LANES) {
+        __m256i amounts = _mm256_and_si256(
+                filterMask(columns, filter, slot),
+                _mm256_loadu_si256(
+                        reinterpret_cast<const __m256i *>(stockAmounts +
+                                                          slot)));
+        __m256i prices = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(unitPrices + slot));
+        __m256i lowAmounts, highAmounts, lowPrices, highPrices;
+        widen(amounts, lowAmounts, highAmounts);
+        widen(prices, lowPrices, highPrices);
+
+        totals = _mm256_add_epi64(totals,
+                                  _mm256_mul_epi32(lowAmounts, lowPrices));
+        totals = _mm256_add_epi64(totals,
+                                  _mm256_mul_epi32(highAmounts, highPrices));
+    }
+
+    long long total = horizontalSum(totals);
+
+    for (; slot < size; slot++) {
+        if (passesFilter(columns, filter, slot)) {
+            total += static_cast<long long>(stockAmounts[slot]) *
+                     unitPrices[slot];
+        }
+    }
+
+    return total;
+}
+
+AVX2_KERNEL
+static void findStockAmountRangeAVX2(const StockColumns &columns,
+                                     int &minStockAmount,
+                                     int &maxStockAmount) {
+    const int *stockAmounts = columns.getStockAmounts().data();
+    size_t size = columns.getSize();
+    __m256i minimums = _mm256_set1_epi32(stockAmounts[0]);
+    __m256i maximums = minimums;
+    size_t slot = 0;
+
+    for (; slot + LANES <= size; slot += LANES) {
+        __m256i amounts = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(stockAmounts + slot));
+        minimums = _mm256_min_epi32(minimums, amounts);
+        maximums = _mm256_max_epi32(maximums, amounts);
+    }
+
+    alignas(32) int minimumLanes[LANES], maximumLanes[LANES];
+    _mm256_store_si256(reinterpret_cast<__m256i *>(minimumLanes), minimums);
+    _mm256_store_si256(reinterpret_cast<__m256i *>(maximumLanes), maximums);
+
+    minStockAmount = minimumLanes[0];
+    maxStockAmount = maximumLanes[0];
+
+    for (size_t lane = 1; lane < LANES; lane++) {
+        minStockAmount = min(minStockAmount, minimumLanes[lane]);
+        maxStockAmount = max(maxStockAmount, maximumLanes[lane]);
+    }
+
+    for (; slot < size; slot++) {
+        minStockAmount = min(minStockAmount, stockAmounts[slot]);
+        maxStockAmount = max(maxStockAmount, stockAmounts[slot]);
+    }
+}
+
+AVX2_KERNEL
+static size_t findStockAmountAVX2(const StockColumns &columns,
+                                  int stockAmount) {
+    const int *stockAmounts = columns.getStockAmounts().data();
+    size_t size = columns.getSize();
+    __m256i wanted = _mm256_set1_epi32(stockAmount);
+    size_t slot = 0;
+
+    for (; slot + LANES <= size; slot += LANES) {
+        __m256i amounts = _mm256_loadu_si256(
+                reinterpret_cast<const __m256i *>(stockAmounts + slot));
+        int found = _mm256_movemask_ps(_mm256_castsi256_ps(
+                _mm256_cmpeq_epi32(amounts, wanted)));
+
+        if (found != 0) {
+            return slot + __builtin_ctz(found);
+        }
+    }
+
+    for (; slot < size; slot++) {
+        if (stockAmounts[slot] == stockAmount) {
+            return slot;
+        }
+    }
+
+    return size;
+}
+
+#endif
+
+/**
+ * Counts the items that pass a filter
+ *
+ * @param columns                   columns of the items
+ * @param filter                    filter items must pass
+ * @return                          amount of items that pass
+ */
+size_t countItems(const StockColumns &columns, const ColumnFilter &filter) {
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        return countItemsAVX2(columns, filter);
+    }
+#endif
+
+    size_t count = 0;
+
+    for (size_t slot = 0; slot < columns.getSize(); slot++) {
+        count += passesFilter(columns, filter, slot);
+    }
+
+    return count;
+}
+
+/**
+ * Counts the items with a unit price above a limit
+ *
+ * @param columns                   columns of the items
+ * @param priceLimit                price items must be above
+ * @return                          amount of items above the limit
+ */
+size_t countPricesAbove(const StockColumns &columns, int priceLimit) {
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        return countPricesAboveAVX2(columns, priceLimit);
+    }
+#endif
+
+    const vector<int> &unitPrices = columns.getUnitPrices();
+    size_t count = 0;
+
+    for (int unitPrice : unitPrices) {
+        count += unitPrice > priceLimit;
+    }
+
+    return count;
+}
+
+/**
+ * Totals the stock amounts of the items that pass a filter
+ *
+ * @param columns                   columns of the items
+ * @param filter                    filter items must pass
+ * @return                          total stock amount
+ */
+long long sumStockAmounts(const StockColumns &columns,
+                          const ColumnFilter &filter) {
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        return sumStockAmountsAVX2(columns, filter);
+    }
+#endif
+
+    const vector<int> &stockAmounts = columns.getStockAmounts();
+    long long total = 0;
+
+    for (size_t slot = 0; slot < stockAmounts.size(); slot++) {
+        if (passesFilter(columns, filter, slot)) {
+            total += stockAmounts[slot];
+        }
+    }
+
+    return total;
+}
+
+/**
+ * Totals the resistances (ohms) or capacitances (picofarads) of the items
+ * that pass a filter, adding them in slot order
+ *
+ * @param columns                   columns of the items
+ * @param filter                    filter items must pass
+ * @return                          total value
+ */
+double sumValues(const StockColumns &columns, const ColumnFilter &filter) {
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        return sumValuesAVX2(columns, filter);
+    }
+#endif
+
+    const vector<double> &values = columns.getValues();
+    double total = 0;
+
+    for (size_t slot = 0; slot < values.size(); slot++) {
+        if (passesFilter(columns, filter, slot)) {
+            total += values[slot];
+        }
+    }
+
+    return total;
+}
+
+/**
+ * Totals the stock value (stock amount x unit price) of the items that pass
+ * a filter
+ *
+ * @param columns                   columns of the items
+ * @param filter                    filter items must pass
+ * @return                          total stock value in pence
+ */
+long long sumStockValues(const StockColumns &columns,
+                         const ColumnFilter &filter) {
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        return sumStockValuesAVX2(columns, filter);
+    }
+#endif
+
+    const vector<int> &stockAmounts = columns.getStockAmounts();
+    const vector<int> &unitPrices = columns.getUnitPrices();
+    long long total = 0;
+
+    for (size_t slot = 0; slot < stockAmounts.size(); slot++) {
+        if (passesFilter(columns, filter, slot)) {
+            total += static_cast<long long>(stockAmounts[slot]) *
+                     unitPrices[slot];
+        }
+    }
+
+    return total;
+}
+
+/**
+ * Finds the smallest and largest stock amounts of the items
+ *
+ * @param columns                   columns of the items
+ * @param minStockAmount            set to the smallest stock amount
+ * @param maxStockAmount            set to the largest stock amount
+ * @return                          false if there are no items
+ */
+bool findStockAmountRange(const StockColumns &columns, int &minStockAmount,
+                          int &maxStockAmount) {
+    const vector<int> &stockAmounts = columns.getStockAmounts();
+
+    if (stockAmounts.empty()) {
+        return false;
+    }
+
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        findStockAmountRangeAVX2(columns, minStockAmount, maxStockAmount);
+        return true;
+    }
+#endif
+
+    minStockAmount = stockAmounts[0];
+    maxStockAmount = stockAmounts[0];
+
+    for (int stockAmount : stockAmounts) {
+        minStockAmount = min(minStockAmount, stockAmount);
+        maxStockAmount = max(maxStockAmount, stockAmount);
+    }
+
+    return true;
+}
+
+/**
+ * Finds the first slot of the columns with a stock amount
+ *
+ * @param columns                   columns of the items
+ * @param stockAmount               stock amount to find
+ * @return                          first slot with the stock amount, the
+ *                                  amount of slots if there is none
+ */
+size_t findStockAmount(const StockColumns &columns, int stockAmount) {
+#ifdef AGGREGATION_AVX2
+    if (simdLevel == SimdLevel::AVX2) {
+        return findStockAmountAVX2(columns, stockAmount);
+    }
+#endif
+
+    const vector<int> &stockAmounts = columns.getStockAmounts();
+
+    for (size_t slot = 0; slot < stockAmounts.size(); slot++) {
+        if (stockAmounts[slot] == stockAmount) {
+            return slot;
+        }
+    }
+
+    return stockAmounts.size();
+}
@@ -0,0 +1,93 @@
+/******************************************************************************
+ *
+ * File        : Aggregation.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define aggregates (counts, totals, minimum
+ *               and maximum) computed over the columns of an inventory,
+ *               vectorised with AVX2 where the processor supports it.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef AGGREGATION_H
+#define AGGREGATION_H
+
+#include <cstddef>
+#include "StockColumns.h"
+
+// Instruction sets the aggregation kernels can be run with
+enum class SimdLevel {
+    Scalar, AVX2
+};
+
+// Items of the columns to include in an aggregate, every item by default
+struct ColumnFilter {
+    // Whether to only include items of a component type
+    bool matchComponentType = false;
+    ComponentType componentType = ComponentType::Resistor;
+
+    // Whether to only include transistors of a device type (other items
+    // hold NPN in the device type column, so never match)
+    bool matchDeviceType = false;
+    DeviceType deviceType = DeviceType::NPN;
+
+    // Whether to only include items with a stock amount above 0
+    bool inStockOnly = false;
+};
+
+/**
+ * Checks whether the item in a slot of the columns passes a filter
+ *
+ * @param columns                   columns of the item
+ * @param filter                    filter to check
+ * @param slot                      slot of the item
+ * @return                          true if the item passes
+ */
+inline bool passesFilter(const StockColumns &columns,
+                         const ColumnFilter &filter, size_t slot) {
+    return (!filter.matchComponentType ||
+            columns.getComponentTypes()[slot] == filter.componentType) &&
+           (!filter.matchDeviceType ||
+            (columns.getComponentTypes()[slot] == ComponentType::Transistor &&
+             columns.getDeviceTypes()[slot] == filter.deviceType)) &&
+           (!filter.inStockOnly || columns.getStockAmounts()[slot] > 0);
+}
+
+// Retrieves the best instruction set supported by the processor
+SimdLevel getSupportedSimdLevel();
+
+// Retrieves the instruction set the aggregation kernels run with
+SimdLevel getSimdLevel();
+
+// Sets the instruction set to run with (limited to the supported one)
+void setSimdLevel(SimdLevel simdLevel);
+
+// Counts the items that pass a filter
+size_t countItems(const StockColumns &columns, const ColumnFilter &filter);
+
+// Counts the items with a unit price above a limit
+size_t countPricesAbove(const StockColumns &columns, int priceLimit);
+
+// Totals the stock amounts of the items that pass a filter
+long long sumStockAmounts(const StockColumns &columns,
+                          const ColumnFilter &filter);
+
+// Totals the resistances/capacitances of the items that pass a filter
+double sumValues(const StockColumns &columns, const ColumnFilter &filter);
+
+// Totals the stock value (stock amount x unit price) in pence of the items
+// that pass a filter
+long long sumStockValues(const StockColumns &columns,
+                         const ColumnFilter &filter);
+
+// Finds the smallest and largest stock amounts (false if there are no items)
+bool findStockAmountRange(const StockColumns &columns, int &minStockAmount,
+                          int &maxStockAmount);
+
+// Finds the first slot with a stock amount (the amount of slots if none)
+size_t findStockAmount(const StockColumns &columns, int stockAmount);
+
+#endif /* AGGREGATION_H */
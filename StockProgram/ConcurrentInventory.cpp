@@ -0,0 +1,237 @@
+/******************************************************************************
+ *
+ * File        : ConcurrentInventory.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define an inventory shared between threads, read
+ *               through snapshots and changed by publishing new versions.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <thread>
+#include "ConcurrentInventory.h"
+
+using namespace std;
+
+/**
+ * Constructs a shared inventory, taking over an inventory as its first
+ * version
+ *
+ * @param inventory                 inventory to share
+ */
+ConcurrentInventory::ConcurrentInventory(Inventory &&inventory)
+        : current(new Inventory(move(inventory))), epoch(1),
+          readerSlots(new ReaderSlot[READER_SLOTS]) {
+    for (size_t slot = 0; slot < READER_SLOTS; slot++) {
+        this->readerSlots[slot].epoch.store(0);
+    }
+}
+
+/**
+ * Destroys the shared inventory and every version of it
+ */
+ConcurrentInventory::~ConcurrentInventory() {
+    delete this->current.load();
+}
+
+/**
+ * Takes a snapshot of the current version, which stays valid until the
+ * snapshot is destroyed. Never waits for a writer.
+ *
+ * @return                          snapshot of the current version
+ */
+ConcurrentInventory::Snapshot ConcurrentInventory::read() const {
+    size_t slot = this->pin();
+
+    return Snapshot(this, slot, this->current.load());
+}
+
+/**
+ * Changes a copy of the current version and publishes the copy. Readers
+ * carry on with the current version meanwhile, and see none of the change
+ * until it is published whole. As each change copies the inventory, many
+ * small changes are best made in one call.
+ *
+ * @param change                    function making the change
+ */
+void ConcurrentInventory::update(const function<void(Inventory &)> &change) {
+    lock_guard<mutex> lock(this->writerMutex);
+
+    // Only writers replace the current version, so it cannot change here
+    unique_ptr<Inventory> next(new Inventory(*this->current.load()));
+    change(*next);
+
+    this->publish(move(next));
+}
+
+/**
+ * Publishes a whole new inventory, such as one reloaded from a file, in
+ * place of the current version
+ *
+ * @param inventory                 inventory to publish
+ */
+void ConcurrentInventory::replace(Inventory &&inventory) {
+    lock_guard<mutex> lock(this->writerMutex);
+
+    this->publish(unique_ptr<Inventory>(new Inventory(move(inventory))));
+}
+
+/**
+ * Retrieves the amount of versions published so far, counting the first
+ *
+ * @return                          amount of versions
+ */
+uint64_t ConcurrentInventory::getVersion() const {
+    return this->epoch.load();
+}
+
+/**
+ * Retrieves the amount of replaced versions still kept for readers
+ *
+ * @return                          amount of replaced versions
+ */
+size_t ConcurrentInventory::getRetiredCount() {
+    lock_guard<mutex> lock(this->writerMutex);
+
+    return this->retired.size();
+}
+
+/**
+ * Claims a free reader slot, announcing the current epoch in it. The
+ * version a reader then loads was current at some point during or after
+ * that epoch, so is not deleted while the slot is claimed.
+ *
+ * @return                          slot claimed
+ */
+size_t ConcurrentInventory::pin() const {
+    // Starts each thread at its own slot, so threads rarely collide
+    static thread_local size_t firstSlot =
+            hash<thread::id>()(this_thread::get_id());
+
+    while (true) {
+        for (size_t i = 0; i < READER_SLOTS; i++) {
+            size_t slot = (firstSlot + i) % READER_SLOTS;
+            uint64_t free = 0;
+
+            if (this->readerSlots[slot].epoch.load(memory_order_relaxed) == 0
+                && this->readerSlots[slot].epoch.compare_exchange_strong(
+                        free, this->epoch.load())) {
+                firstSlot = slot;
+                return slot;
+            }
+        }
+
+        // Every slot is held, so waits for a reader to finish
+        this_thread::yield();
+    }
+}
+
+/**
+ * Frees a reader slot, once its snapshot no longer reads its version
+ *
+ * @param slot                      slot to free
+ */
+void ConcurrentInventory::unpin(size_t slot) const {
+    this->readerSlots[slot].epoch.store(0, memory_order_release);
+}
+
+/**
+ * Publishes a new version, advances the epoch and retires the replaced
+ * version until the readers that may hold it have finished. Called with
+ * the writer lock held.
+ *
+ * Readers that claim a slot after the epoch advances load the new version,
+ * so the replaced version is only held by readers announcing an earlier
+ * epoch.
+ *
+ * @param next                      version to publish
+ */
+void ConcurrentInventory::publish(unique_ptr<Inventory> next) {
+    const Inventory *replaced = this->current.exchange(next.release());
+    uint64_t replacedEpoch = this->epoch.fetch_add(1) + 1;
+
+    this->retired.push_back({unique_ptr<const Inventory>(replaced),
+                             replacedEpoch});
+    this->reclaim();
+}
+
+/**
+ * Deletes each replaced version no reader can still hold, those replaced
+ * no later than the earliest epoch announced by a reader. Called with the
+ * writer lock held.
+ */
+void ConcurrentInventory::reclaim() {
+    uint64_t earliestEpoch = UINT64_MAX;
+
+    for (size_t slot = 0; slot < READER_SLOTS; slot++) {
+        uint64_t readerEpoch = this->readerSlots[slot].epoch.load();
+
+        if (readerEpoch != 0 && readerEpoch < earliestEpoch) {
+            earliestEpoch = readerEpoch;
+        }
+    }
+
+    size_t kept = 0;
+
+    for (RetiredVersion &version : this->retired) {
+        if (version.epoch > earliestEpoch) {
+            this->retired[kept++] = move(version);
+        }
+    }
+
+    this->retired.resize(kept);
+}
+
+/**
+ * Constructs a snapshot of a version held through a reader slot
+ *
+ * @param owner                     inventory the snapshot was taken of
+ * @param slot                      reader slot claimed for the snapshot
+ * @param inventory                 version held
+ */
+ConcurrentInventory::Snapshot::Snapshot(const ConcurrentInventory *owner,
+                                        size_t slot,
+                                        const Inventory *inventory)
+        : owner(owner), slot(slot), inventory(inventory) {
+}
+
+/**
+ * Moves a snapshot, leaving the moved from snapshot holding nothing
+ *
+ * @param snapshot                  snapshot to move
+ */
+ConcurrentInventory::Snapshot::Snapshot(Snapshot &&snapshot) noexcept
+        : owner(snapshot.owner), slot(snapshot.slot),
+          inventory(snapshot.inventory) {
+    snapshot.owner = nullptr;
+}
+
+/**
+ * Destroys the snapshot, releasing its version
+ */
+ConcurrentInventory::Snapshot::~Snapshot() {
+    if (this->owner != nullptr) {
+        this->owner->unpin(this->slot);
+    }
+}
+
+/**
+ * Accesses the version held
+ *
+ * @return                          version held
+ */
+const Inventory &ConcurrentInventory::Snapshot::operator*() const {
+    return *this->inventory;
+}
+
+/**
+ * Accesses the version held
+ *
+ * @return                          version held
+ */
+const Inventory *ConcurrentInventory::Snapshot::operator->() const {
+    return this->inventory;
+}
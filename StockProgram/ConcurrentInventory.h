@@ -0,0 +1,146 @@
+/******************************************************************************
+ *
+ * File        : ConcurrentInventory.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define an inventory shared between threads,
+ *               which readers query through immutable snapshots without
+ *               locking while writers publish new versions of it.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef CONCURRENTINVENTORY_H
+#define CONCURRENTINVENTORY_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Inventory.h"
+
+/**
+ * An inventory that many threads can query while others change it. Each
+ * version of the inventory is immutable once published: a writer copies the
+ * current version, changes the copy and publishes it in place of the
+ * current one. Readers take a snapshot of whichever version is current,
+ * without taking a lock or waiting for writers.
+ * Old versions are reclaimed by epochs. A reader announces the epoch it
+ * started in while it holds a snapshot, and a replaced version is deleted
+ * once no reader that started before it was replaced remains.
+ */
+class ConcurrentInventory {
+private:
+    // Most readers that can hold a snapshot at once
+    static const size_t READER_SLOTS = 256;
+
+    // Epoch a reader holding a snapshot started in, 0 if the slot is free.
+    // Each slot has a cache line of its own so readers do not contend.
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch;
+    };
+
+    // A replaced version, and the epoch it was replaced in
+    struct RetiredVersion {
+        std::unique_ptr<const Inventory> inventory;
+        uint64_t epoch;
+    };
+
+    // Version of the inventory readers take snapshots of
+    std::atomic<const Inventory *> current;
+
+    // Current epoch, advanced each time a version is published
+    std::atomic<uint64_t> epoch;
+
+    // Slots readers announce their epoch in
+    std::unique_ptr<ReaderSlot[]> readerSlots;
+
+    // Lock held by writers, so that one version is changed at a time
+    std::mutex writerMutex;
+
+    // Replaced versions that readers may still hold
+    std::vector<RetiredVersion> retired;
+
+    // Claims a reader slot for the current epoch
+    size_t pin() const;
+
+    // Frees a reader slot
+    void unpin(size_t slot) const;
+
+    // Publishes a new version in place of the current one
+    void publish(std::unique_ptr<Inventory> next);
+
+    // Deletes the replaced versions no reader can still hold
+    void reclaim();
+
+public:
+    /**
+     * A version of the inventory held for reading. The version stays valid
+     * and unchanged for as long as the snapshot exists, however many
+     * versions are published meanwhile, so snapshots should be short lived.
+     * Items reached through a snapshot must not be changed.
+     */
+    class Snapshot {
+    private:
+        // Inventory the snapshot was taken of
+        const ConcurrentInventory *owner;
+
+        // Reader slot claimed for the snapshot
+        size_t slot;
+
+        // Version held
+        const Inventory *inventory;
+
+        // Snapshot Constructor
+        Snapshot(const ConcurrentInventory *owner, size_t slot,
+                 const Inventory *inventory);
+
+        friend class ConcurrentInventory;
+
+    public:
+        // Snapshot Destructor (releases the version)
+        ~Snapshot();
+
+        // Snapshots can be moved, but not copied
+        Snapshot(Snapshot &&snapshot) noexcept;
+        Snapshot(const Snapshot &snapshot) = delete;
+        Snapshot &operator=(const Snapshot &snapshot) = delete;
+
+        // Accesses the version held
+        const Inventory &operator*() const;
+        const Inventory *operator->() const;
+    };
+
+    // ConcurrentInventory Constructor
+    explicit ConcurrentInventory(Inventory &&inventory);
+
+    // ConcurrentInventory Destructor (no snapshots may still be held)
+    ~ConcurrentInventory();
+
+    // Shared inventories cannot be copied or moved
+    ConcurrentInventory(const ConcurrentInventory &inventory) = delete;
+    ConcurrentInventory &operator=(const ConcurrentInventory &inventory)
+            = delete;
+
+    // Takes a snapshot of the current version
+    Snapshot read() const;
+
+    // Changes a copy of the current version and publishes it
+    void update(const std::function<void(Inventory &)> &change);
+
+    // Publishes a whole new inventory in place of the current version
+    void replace(Inventory &&inventory);
+
+    // Retrieves the amount of versions published so far
+    uint64_t getVersion() const;
+
+    // Retrieves the amount of replaced versions not yet deleted
+    size_t getRetiredCount();
+};
+
+#endif /* CONCURRENTINVENTORY_H */
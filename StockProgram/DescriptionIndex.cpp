@@ -0,0 +1,440 @@
+/******************************************************************************
+ *
+ * File        : DescriptionIndex.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a full-text index of the descriptions of
+ *               integrated circuits.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cctype>
+#include <utility>
+#include "DescriptionIndex.h"
+
+using namespace std;
+
+// Lists of slots shorter than this many times another are intersected by
+// searching the longer list, rather than stepping through both
+static const size_t GALLOP_RATIO = 16;
+
+/**
+ * Adds a slot to a sorted list of slots, if it is not already in it
+ *
+ * @param slots                     sorted slots
+ * @param slot                      slot to add
+ */
+static void addPosting(vector<uint32_t> &slots, uint32_t slot) {
+    // Items are mostly indexed in the order they were added
+    if (slots.empty() || slots.back() < slot) {
+        slots.push_back(slot);
+        return;
+    }
+
+    auto position = lower_bound(slots.begin(), slots.end(), slot);
+
+    if (*position != slot) {
+        slots.insert(position, slot);
+    }
+}
+
+/**
+ * Removes a slot from a sorted list of slots, if it is in it
+ *
+ * @param slots                     sorted slots
+ * @param slot                      slot to remove
+ */
+static void removePosting(vector<uint32_t> &slots, uint32_t slot) {
+    auto position = lower_bound(slots.begin(), slots.end(), slot);
+
+    if (position != slots.end() && *position == slot) {
+        slots.erase(position);
+    }
+}
+
+/**
+ * Splits text into terms, which are runs of letters and digits converted to
+ * lower case, so "4-bit Counter" has the terms 4, bit and counter. A term
+ * directly followed by * is a prefix.
+ *
+ * @param text                      text to split
+ * @param visitor                   function taking each term and whether it
+ *                                  is a prefix
+ */
+template <typename Visitor>
+static void forEachTerm(string_view text, Visitor visitor) {
+    string term;
+
+    for (size_t i = 0; i <= text.size(); i++) {
+        unsigned char character = i < text.size() ? text[i] : ' ';
+
+        if (isalnum(character)) {
+            term += tolower(character);
+        } else if (!term.empty()) {
+            visitor(term, character == '*');
+            term.clear();
+        }
+    }
+}
+
+/**
+ * Calls a function with each trigram (three consecutive characters) of
+ * text, packed into the low 24 bits of an integer
+ *
+ * @param text                      lower case text
+ * @param visitor                   function taking each trigram
+ */
+template <typename Visitor>
+static void forEachTrigram(string_view text, Visitor visitor) {
+    for (size_t i = 0; i + 3 <= text.size(); i++) {
+        visitor(static_cast<unsigned char>(text[i]) << 16 |
+                static_cast<unsigned char>(text[i + 1]) << 8 |
+                static_cast<unsigned char>(text[i + 2]));
+    }
+}
+
+/**
+ * Converts text to lower case
+ *
+ * @param text                      text to convert
+ * @return                          text in lower case
+ */
+string DescriptionIndex::toLower(string_view text) {
+    string lower(text);
+
+    for (char &character : lower) {
+        character = tolower(static_cast<unsigned char>(character));
+    }
+
+    return lower;
+}
+
+/**
+ * Indexes the description of the item in a slot, by each of its terms and
+ * trigrams. An item already in the index is indexed again.
+ *
+ * @param slot                      slot of the item
+ * @param description               description of the item
+ */
+void DescriptionIndex::add(uint32_t slot, string_view description) {
+    if (this->descriptions.count(slot) != 0) {
+        this->remove(slot);
+    }
+
+    const string &lower = this->descriptions[slot] = toLower(description);
+
+    forEachTerm(lower, [this, slot](const string &term, bool) {
+        vector<uint32_t> &postings = this->termPostings[term];
+
+        if (postings.empty()) {
+            this->terms.insert(term);
+        }
+
+        addPosting(postings, slot);
+    });
+
+    forEachTrigram(lower, [this, slot](uint32_t trigram) {
+        addPosting(this->trigramPostings[trigram], slot);
+    });
+}
+
+/**
+ * Removes the item in a slot from the posting list of each term and trigram
+ * of the description it was indexed with
+ *
+ * @param slot                      slot of the item
+ */
+void DescriptionIndex::remove(uint32_t slot) {
+    auto description = this->descriptions.find(slot);
+
+    if (description == this->descriptions.end()) {
+        return;
+    }
+
+    forEachTerm(description->second, [this, slot](const string &term, bool) {
+        auto postings = this->termPostings.find(term);
+
+        if (postings != this->termPostings.end()) {
+            removePosting(postings->second, slot);
+
+            if (postings->second.empty()) {
+                this->termPostings.erase(postings);
+                this->terms.erase(term);
+            }
+        }
+    });
+
+    forEachTrigram(description->second, [this, slot](uint32_t trigram) {
+        auto postings = this->trigramPostings.find(trigram);
+
+        if (postings != this->trigramPostings.end()) {
+            removePosting(postings->second, slot);
+
+            if (postings->second.empty()) {
+                this->trigramPostings.erase(postings);
+            }
+        }
+    });
+
+    this->descriptions.erase(description);
+}
+
+/**
+ * Moves every slot in the index to its new slot, once the items in other
+ * slots have been removed from it and the slots compacted. Posting lists
+ * stay sorted, as the new slots keep the order of the old.
+ *
+ * @param newSlots                  new slot of each old slot, in the same
+ *                                  order as the old slots
+ */
+void DescriptionIndex::renumber(const vector<uint32_t> &newSlots) {
+    for (auto &postings : this->termPostings) {
+        for (uint32_t &slot : postings.second) {
+            slot = newSlots[slot];
+        }
+    }
+
+    for (auto &postings : this->trigramPostings) {
+        for (uint32_t &slot : postings.second) {
+            slot = newSlots[slot];
+        }
+    }
+
+    unordered_map<uint32_t, string> renumbered;
+    renumbered.reserve(this->descriptions.size());
+
+    for (auto &description : this->descriptions) {
+        renumbered.emplace(newSlots[description.first],
+                           move(description.second));
+    }
+
+    this->descriptions.swap(renumbered);
+}
+
+/**
+ * Removes every item from the index
+ */
+void DescriptionIndex::clear() {
+    this->termPostings.clear();
+    this->terms.clear();
+    this->trigramPostings.clear();
+    this->descriptions.clear();
+}
+
+/**
+ * Retrieves the amount of items in the index
+ *
+ * @return                          amount of items
+ */
+size_t DescriptionIndex::getSize() const {
+    return this->descriptions.size();
+}
+
+/**
+ * Retrieves the slots of the items with a term, or with any term starting
+ * with a prefix (joining the posting lists of each such term)
+ *
+ * @param term                      lower case term
+ * @param prefix                    true to match terms starting with it
+ * @return                          sorted slots of the items
+ */
+vector<uint32_t> DescriptionIndex::findTerm(const string &term,
+                                            bool prefix) const {
+    if (!prefix) {
+        auto postings = this->termPostings.find(term);
+
+        return postings == this->termPostings.end() ? vector<uint32_t>()
+                                                     : postings->second;
+    }
+
+    vector<uint32_t> slots;
+
+    for (auto prefixed = this->terms.lower_bound(term);
+         prefixed != this->terms.end() &&
+         prefixed->compare(0, term.size(), term) == 0; ++prefixed) {
+        const vector<uint32_t> &postings = this->termPostings.at(*prefixed);
+        slots.insert(slots.end(), postings.begin(), postings.end());
+    }
+
+    // Sorting once is quicker than merging each of many short lists
+    sort(slots.begin(), slots.end());
+    slots.erase(unique(slots.begin(), slots.end()), slots.end());
+
+    return slots;
+}
+
+/**
+ * Finds the slots in both of two sorted lists of slots. When one list is
+ * much shorter, each of its slots is searched for in the longer list, which
+ * skips over most of it.
+ *
+ * @param slots1                    sorted slots
+ * @param slots2                    sorted slots
+ * @return                          sorted slots in both lists
+ */
+vector<uint32_t> DescriptionIndex::intersect(const vector<uint32_t> &slots1,
+                                             const vector<uint32_t> &slots2) {
+    const vector<uint32_t> &shorter = slots1.size() <= slots2.size()
+                                      ? slots1 : slots2;
+    const vector<uint32_t> &longer = slots1.size() <= slots2.size()
+                                     ? slots2 : slots1;
+    vector<uint32_t> slots;
+
+    if (shorter.size() * GALLOP_RATIO < longer.size()) {
+        auto position = longer.begin();
+
+        for (uint32_t slot : shorter) {
+            position = lower_bound(position, longer.end(), slot);
+
+            if (position == longer.end()) {
+                break;
+            } else if (*position == slot) {
+                slots.push_back(slot);
+            }
+        }
+    } else {
+        set_intersection(shorter.begin(), shorter.end(), longer.begin(),
+                         longer.end(), back_inserter(slots));
+    }
+
+    return slots;
+}
+
+/**
+ * Finds the items whose descriptions have all (or any) of the terms of a
+ * search, ignoring case. A term ending in * matches every term it is a
+ * prefix of, so "count*" matches counter and counters.
+ *
+ * @param terms                     terms to search for
+ * @param match                     whether items need all terms or any
+ * @return                          slots of the items, in increasing order
+ */
+vector<uint32_t> DescriptionIndex::findTerms(string_view terms,
+                                             TermMatch match) const {
+    vector<vector<uint32_t>> postingLists;
+
+    forEachTerm(terms, [this, &postingLists](const string &term,
+                                             bool prefix) {
+        postingLists.push_back(this->findTerm(term, prefix));
+    });
+
+    if (postingLists.empty()) {
+        return vector<uint32_t>();
+    }
+
+    vector<uint32_t> slots;
+
+    if (match == TermMatch::All) {
+        // Intersecting the shortest lists first keeps every step small
+        sort(postingLists.begin(), postingLists.end(),
+             [](const vector<uint32_t> &slots1,
+                const vector<uint32_t> &slots2) {
+                 return slots1.size() < slots2.size();
+             });
+
+        slots = move(postingLists[0]);
+
+        for (size_t i = 1; i < postingLists.size() && !slots.empty(); i++) {
+            slots = intersect(slots, postingLists[i]);
+        }
+    } else {
+        for (const vector<uint32_t> &postings : postingLists) {
+            slots.insert(slots.end(), postings.begin(), postings.end());
+        }
+
+        sort(slots.begin(), slots.end());
+        slots.erase(unique(slots.begin(), slots.end()), slots.end());
+    }
+
+    return slots;
+}
+
+/**
+ * Finds the items whose description contains text anywhere, ignoring case.
+ * The items with every trigram of the text are found from the trigram
+ * posting lists, and then checked for the text itself. Text shorter than a
+ * trigram is looked for in every description.
+ *
+ * @param text                      text to search for
+ * @return                          slots of the items, in increasing order
+ */
+vector<uint32_t> DescriptionIndex::findText(string_view text) const {
+    string lower = toLower(text);
+    vector<uint32_t> candidates;
+
+    if (lower.size() < 3) {
+        for (const auto &description : this->descriptions) {
+            candidates.push_back(description.first);
+        }
+
+        sort(candidates.begin(), candidates.end());
+    } else {
+        vector<const vector<uint32_t> *> postingLists;
+        bool missing = false;
+
+        forEachTrigram(lower, [this, &postingLists, &missing](
+                uint32_t trigram) {
+            auto postings = this->trigramPostings.find(trigram);
+
+            if (postings == this->trigramPostings.end()) {
+                missing = true;
+            } else {
+                postingLists.push_back(&postings->second);
+            }
+        });
+
+        if (missing) {
+            return vector<uint32_t>();
+        }
+
+        sort(postingLists.begin(), postingLists.end(),
+             [](const vector<uint32_t> *slots1,
+                const vector<uint32_t> *slots2) {
+                 return slots1->size() < slots2->size();
+             });
+
+        candidates = *postingLists[0];
+
+        for (size_t i = 1; i < postingLists.size() && !candidates.empty();
+             i++) {
+            candidates = intersect(candidates, *postingLists[i]);
+        }
+    }
+
+    // Trigrams in a description may not be next to each other
+    vector<uint32_t> slots;
+
+    for (uint32_t slot : candidates) {
+        if (this->descriptions.at(slot).find(lower) != string::npos) {
+            slots.push_back(slot);
+        }
+    }
+
+    return slots;
+}
+
+/**
+ * Estimates how many items findText reads for text, as the length of the
+ * shortest posting list of its trigrams, which is at least as many items as
+ * contain the text
+ *
+ * @param text                      text to search for
+ * @return                          estimated amount of items
+ */
+size_t DescriptionIndex::estimateText(string_view text) const {
+    string lower = toLower(text);
+    size_t estimate = this->descriptions.size();
+
+    forEachTrigram(lower, [this, &estimate](uint32_t trigram) {
+        auto postings = this->trigramPostings.find(trigram);
+
+        estimate = min(estimate, postings == this->trigramPostings.end()
+                                 ? 0 : postings->second.size());
+    });
+
+    return estimate;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * File        : DescriptionIndex.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a full-text index of the
+ *               descriptions of integrated circuits, answering term, prefix
+ *               and substring searches without reading every description.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef DESCRIPTIONINDEX_H
+#define DESCRIPTIONINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <set>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Whether a search matches items with all of its terms or any of them
+enum class TermMatch {
+    All, Any
+};
+
+/**
+ * An inverted index of the descriptions of items: for each term (a run of
+ * letters and digits, in lower case) the sorted slots of the items whose
+ * description contains it, and for each trigram (three consecutive
+ * characters, in lower case) the sorted slots of the items whose description
+ * contains that. Searches intersect or merge these posting lists rather than
+ * reading every description.
+ */
+class DescriptionIndex {
+private:
+    // Slots of the items containing each term
+    std::unordered_map<std::string, std::vector<uint32_t>> termPostings;
+
+    // Every term in the index, in order so that the terms with a prefix
+    // are found together
+    std::set<std::string> terms;
+
+    // Slots of the items containing each trigram, packed into an integer
+    std::unordered_map<uint32_t, std::vector<uint32_t>> trigramPostings;
+
+    // Description indexed for each slot, in lower case
+    std::unordered_map<uint32_t, std::string> descriptions;
+
+    // Retrieves the slots of the items with a term (or with a prefix)
+    std::vector<uint32_t> findTerm(const std::string &term,
+                                   bool prefix) const;
+
+    // Finds the slots in both of two sorted lists of slots
+    static std::vector<uint32_t> intersect(const std::vector<uint32_t> &slots1,
+                                           const std::vector<uint32_t> &slots2);
+
+public:
+    // Converts text to lower case
+    static std::string toLower(std::string_view text);
+
+    // Indexes the description of the item in a slot
+    void add(uint32_t slot, std::string_view description);
+
+    // Removes the item in a slot from the index
+    void remove(uint32_t slot);
+
+    // Moves every slot to its new slot after others were removed, the new
+    // slots keeping the order of the old
+    void renumber(const std::vector<uint32_t> &newSlots);
+
+    // Removes every item from the index
+    void clear();
+
+    // Retrieves the amount of items in the index
+    size_t getSize() const;
+
+    // Finds the items with all/any of the terms of a search (terms ending
+    // in * match every term they prefix)
+    std::vector<uint32_t> findTerms(std::string_view terms,
+                                    TermMatch match = TermMatch::All) const;
+
+    // Finds the items whose description contains text, ignoring case
+    std::vector<uint32_t> findText(std::string_view text) const;
+
+    // Estimates how many items findText reads for text (at least as many
+    // as it finds)
+    size_t estimateText(std::string_view text) const;
+};
+
+#endif /* DESCRIPTIONINDEX_H */
@@ -11,42 +11,133 @@
  ******************************************************************************/
 
 #include <algorithm>
+#include <stdexcept>
+#include <unordered_set>
+#include <utility>
 #include "Inventory.h"
+#include "ParallelSort.h"
+#include "ReportWriter.h"
 
 using namespace std;
 
+/**
+ * Selects the items that come first when ordered by a key, without sorting
+ * every item. The stock is split into chunks, each scanned on its own thread
+ * keeping a bounded heap of the best k items seen so far, in O(n log k).
+ * The chunks' best items are then sorted together and cut down to k. Items
+ * with equal keys are ordered by their position in the stock, giving the
+ * same items as a stable sort of the stock cut down to k.
+ *
+ * @param stock                     items in their current order
+ * @param columns                   columns of the items
+ * @param k                         amount of items to select
+ * @param filter                    filter items must pass
+ * @param largest                   true to select the largest keys, false for
+ *                                  the smallest
+ * @param threadCount               amount of threads to select with, 0 uses
+ *                                  one per hardware thread
+ * @param keyOf                     function taking a slot, returning its key
+ * @return                          selected items, best first
+ */
+template <typename KeyFunction>
+static vector<StockItem *> selectItems(const vector<StockItem *> &stock,
+                                       const StockColumns &columns, size_t k,
+                                       const ColumnFilter &filter,
+                                       bool largest, unsigned int threadCount,
+                                       KeyFunction keyOf) {
+    // A candidate's key and position in the stock
+    typedef pair<decltype(keyOf(0)), size_t> Candidate;
+
+    // Lambda for whether a candidate comes before another
+    auto before = [largest](const Candidate &candidate1,
+                            const Candidate &candidate2) -> bool {
+        if (candidate1.first != candidate2.first) {
+            return largest ? candidate1.first > candidate2.first
+                           : candidate1.first < candidate2.first;
+        }
+        return candidate1.second < candidate2.second;
+    };
+
+    if (k == 0) {
+        return vector<StockItem *>();
+    }
+
+    if (threadCount == 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    size_t chunkCount = min<size_t>(threadCount,
+                                    stock.size() / MIN_SORT_RUN + 1);
+    vector<vector<Candidate>> chunkCandidates(chunkCount);
+
+    runInParallel(chunkCount, [&](size_t chunk) {
+        // Heap of the best candidates, the worst of them on top
+        vector<Candidate> &heap = chunkCandidates[chunk];
+        size_t last = stock.size() * (chunk + 1) / chunkCount;
+
+        for (size_t i = stock.size() * chunk / chunkCount; i < last; i++) {
+            uint32_t slot = stock[i]->getSlot();
+
+            if (!passesFilter(columns, filter, slot)) {
+                continue;
+            }
+
+            Candidate candidate(keyOf(slot), i);
+
+            if (heap.size() < k) {
+                heap.push_back(candidate);
+                push_heap(heap.begin(), heap.end(), before);
+            } else if (before(candidate, heap.front())) {
+                pop_heap(heap.begin(), heap.end(), before);
+                heap.back() = candidate;
+                push_heap(heap.begin(), heap.end(), before);
+            }
+        }
+    });
+
+    vector<Candidate> candidates;
+    for (const vector<Candidate> &heap : chunkCandidates) {
+        candidates.insert(candidates.end(), heap.begin(), heap.end());
+    }
+
+    sort(candidates.begin(), candidates.end(), before);
+    candidates.resize(min(k, candidates.size()));
+
+    vector<StockItem *> selected;
+    selected.reserve(candidates.size());
+
+    for (const Candidate &candidate : candidates) {
+        selected.push_back(stock[candidate.second]);
+    }
+
+    return selected;
+}
+
 /**
  * Constructs an empty inventory object
  */
-Inventory::Inventory() {
+Inventory::Inventory() : duplicateCodes(false), changeObserver(nullptr) {
 }
 
 /**
  * Destructs an inventory object
  */
 Inventory::~Inventory() {
-    for (StockItem *item : this->stock) {
-        delete item;
-    }
+    this->release();
 }
 
 /**
- * Copy constructor for inventory object
+ * Copy constructor for inventory object, copying every item
  *
  * @param inv           inventory to copy
  */
-Inventory::Inventory(const Inventory &inv) {
-    // Allocates space for stock
-    this->stock.reserve(inv.getSize());
-
-    // Copies passed inventory stock into this inventory
-    for (int i = 0; i < inv.getSize(); i++) {
-        this->stock.push_back(inv.stock.at(i));
-    }
+Inventory::Inventory(const Inventory &inv)
+        : duplicateCodes(false), changeObserver(nullptr) {
+    this->copyFrom(inv);
 }
 
 /**
- * Copy assignment operator for inventory object
+ * Copy assignment operator for inventory object, copying every item
  *
  * @param inv           inventory to assign
  * @return              reference to copy of inventory object
@@ -55,14 +146,92 @@ Inventory &Inventory::operator=(const Inventory &inv) {
     // Checks for self-assignment
     if (this != &inv) {
         // Clears this inventory's stock before starting copy
-        this->stock.clear();
+        this->release();
+
+        this->copyFrom(inv);
+    }
+
+    return *this;
+}
+
+/**
+ * Move constructor for inventory object, taking ownership of every item
+ *
+ * @param inv           inventory to move
+ */
+Inventory::Inventory(Inventory &&inv) noexcept
+        : stock(move(inv.stock)), columns(move(inv.columns)),
+          arena(move(inv.arena)), adoptedItems(move(inv.adoptedItems)),
+          codeIndex(move(inv.codeIndex)), codeTrie(move(inv.codeTrie)),
+          duplicateCodes(inv.duplicateCodes),
+          priceIndex(move(inv.priceIndex)),
+          resistanceIndex(move(inv.resistanceIndex)),
+          capacitanceIndex(move(inv.capacitanceIndex)),
+          descriptionIndex(move(inv.descriptionIndex)),
+          changeObserver(inv.changeObserver) {
+    inv.stock.clear();
+    inv.adoptedItems.clear();
+    inv.codeIndex.clear();
+    inv.codeTrie.clear();
+    inv.priceIndex.clear();
+    inv.resistanceIndex.clear();
+    inv.capacitanceIndex.clear();
+    inv.descriptionIndex.clear();
+    inv.changeObserver = nullptr;
+
+    for (int i = 0; i < COMPONENT_TYPE_COUNT; i++) {
+        this->typePartitions[i] = move(inv.typePartitions[i]);
+        inv.typePartitions[i].clear();
+    }
+
+    // Items now report their changes to this inventory
+    for (StockItem *item : this->columns.getItems()) {
+        item->attach(this, item->getSlot());
+    }
+}
+
+/**
+ * Move assignment operator for inventory object, taking ownership of every
+ * item
+ *
+ * @param inv           inventory to move
+ * @return              reference to this inventory
+ */
+Inventory &Inventory::operator=(Inventory &&inv) noexcept {
+    // Checks for self-assignment
+    if (this != &inv) {
+        this->release();
+
+        this->stock = move(inv.stock);
+        this->columns = move(inv.columns);
+        this->arena = move(inv.arena);
+        this->adoptedItems = move(inv.adoptedItems);
+        this->codeIndex = move(inv.codeIndex);
+        this->codeTrie = move(inv.codeTrie);
+        this->duplicateCodes = inv.duplicateCodes;
+        this->priceIndex = move(inv.priceIndex);
+        this->resistanceIndex = move(inv.resistanceIndex);
+        this->capacitanceIndex = move(inv.capacitanceIndex);
+        this->descriptionIndex = move(inv.descriptionIndex);
+        this->changeObserver = inv.changeObserver;
+        inv.stock.clear();
+        inv.adoptedItems.clear();
+        inv.codeIndex.clear();
+        inv.codeTrie.clear();
+        inv.priceIndex.clear();
+        inv.resistanceIndex.clear();
+        inv.capacitanceIndex.clear();
+        inv.descriptionIndex.clear();
+        inv.changeObserver = nullptr;
 
-        // Allocates space for stock
-        this->stock.reserve(inv.getSize());
+        for (int i = 0; i < COMPONENT_TYPE_COUNT; i++) {
+            this->typePartitions[i] = move(inv.typePartitions[i]);
+            inv.typePartitions[i].clear();
+        }
 
-        // Copies passed inventory stock into this inventory
-        for (int i = 0; i < inv.getSize(); i++) {
-            this->stock.push_back(inv.stock.at(i));
+        // Items now report their changes to this inventory
+        for (StockItem *item : this->columns.getItems()) {
+            item->attach(this, item->getSlot());
         }
     }
 
@@ -70,89 +239,1437 @@ Inventory &Inventory::operator=(const Inventory &inv) {
 }
 
 /**
- * Adds an item to the inventory
+ * Adds an item to the inventory. The inventory takes ownership of the item,
+ * which must have been allocated with new.
  *
  * @param item                      item to add to inventory
+ * @throws invalid_argument         if the inventory is watched and already
+ *                                  has an item with the item's stock code
  */
 void Inventory::add(StockItem *item) {
-    this->stock.push_back(item);
+    this->checkCodeUnique(item->getStockCode());
+
+    this->adoptedItems.push_back(item);
+    this->insert(item);
 }
 
 /**
- * Retrieves the amount of items in the inventory
+ * Copies an item into the inventory's arena, reusing the storage of an item
+ * removed if there is any, and adds the copy to the inventory
  *
- * @return                          amount of items in inventory
+ * @param item                      item to copy
+ * @return                          the copy added
+ * @throws invalid_argument         if the inventory is watched and already
+ *                                  has an item with the item's stock code
  */
-int Inventory::getSize() const {
-    return this->stock.size();
+StockItem *Inventory::addCopy(const StockItem &item) {
+    this->checkCodeUnique(item.getStockCode());
+
+    StockItem *copiedItem = this->arena.copy(item);
+    this->insert(copiedItem);
+
+    return copiedItem;
 }
 
 /**
- * Sorts the inventory by price
+ * Takes ownership of every item in an arena, adding the given items (which
+ * must belong to the arena) to the inventory in order
  *
- * @param ascending                 set to true to have in increasing order,
- *                                  false for decreasing order
+ * @param itemArena                 arena to take the items of
+ * @param items                     items of the arena to add
+ * @throws invalid_argument         if the inventory is watched and the
+ *                                  items would share a stock code
+ */
+void Inventory::splice(ItemArena &itemArena, const vector<StockItem *> &items) {
+    // A watched inventory refuses the items before taking any of them
+    if (this->changeObserver != nullptr) {
+        unordered_set<string_view> codes;
+
+        for (StockItem *item : items) {
+            this->checkCodeUnique(item->getStockCode());
+
+            if (!codes.insert(item->getStockCode()).second) {
+                throw invalid_argument("Stock code " +
+                                       string(item->getStockCode()) +
+                                       " is shared by items added to a "
+                                       "watched inventory.");
+            }
+        }
+    }
+
+    this->arena.absorb(itemArena);
+
+    // Grows the stock at least twofold, so that splicing a few items at a
+    // time does not copy the whole stock each time
+    size_t stockSize = this->stock.size() + items.size();
+
+    if (stockSize > this->stock.capacity()) {
+        this->stock.reserve(max(stockSize, 2 * this->stock.capacity()));
+    }
+
+    // Empty sorted indexes are quicker to build in one go than item by item
+    bool buildSortedIndexes = this->stock.empty();
+
+    for (StockItem *item : items) {
+        this->insert(item, !buildSortedIndexes);
+    }
+
+    if (buildSortedIndexes) {
+        this->rebuildSortedIndexes();
+    }
+}
+
+/**
+ * Takes ownership of every item in an arena, adding the given items (which
+ * must belong to the arena) in the order they were first added, and
+ * restores the stock order, trie of stock codes and sorted indexes stored
+ * with them rather than sorting and inserting every code again. Each stored
+ * index is checked against the items first, and any that is missing or
+ * does not match is rebuilt instead. Only an empty, unwatched inventory is
+ * restored; otherwise the items are spliced in.
+ *
+ * @param itemArena                 arena to take the items of
+ * @param items                     items of the arena, in the order they
+ *                                  were added
+ * @param indexes                   stock order and indexes stored with the
+ *                                  items
+ */
+void Inventory::restore(ItemArena &itemArena, const vector<StockItem *> &items,
+                        StoredIndexes indexes) {
+    if (!this->stock.empty() || this->changeObserver != nullptr) {
+        this->splice(itemArena, items);
+        return;
+    }
+
+    this->arena.absorb(itemArena);
+    this->codeIndex.reserve(items.size());
+
+    // Adds the items to the columns, then the code index and partitions,
+    // each in its own pass as probing the code index between items evicts
+    // the items from the cache. The trie and sorted indexes are restored
+    // once every item is in.
+    for (StockItem *item : items) {
+        item->attach(this, this->columns.add(item));
+    }
+
+    const vector<uint32_t> &codeIds = this->columns.getCodeIds();
+
+    for (uint32_t slot = 0; slot < items.size(); slot++) {
+        if (!this->codeIndex.insert(this->columns.getCode(codeIds[slot]),
+                                    slot)) {
+            this->duplicateCodes = true;
+        }
+    }
+
+    for (StockItem *item : items) {
+        this->typePartitions[static_cast<int>(item->getType())]
+                .push_back(item);
+
+        if (item->getType() == ComponentType::IntegratedCircuit) {
+            this->descriptionIndex.add(
+                    item->getSlot(),
+                    static_cast<IntegratedCircuit *>(item)->getDescription());
+        }
+    }
+
+    // Restores the stock order if it holds every slot once, otherwise the
+    // items are stocked in the order they were added
+    const vector<uint32_t> &stockOrder = indexes.stockOrder;
+    vector<bool> stocked(items.size(), false);
+    bool validOrder = stockOrder.size() == items.size();
+
+    for (size_t i = 0; validOrder && i < stockOrder.size(); i++) {
+        validOrder = stockOrder[i] < items.size() && !stocked[stockOrder[i]];
+
+        if (validOrder) {
+            stocked[stockOrder[i]] = true;
+        }
+    }
+
+    if (validOrder) {
+        this->stock.reserve(items.size());
+
+        for (uint32_t slot : stockOrder) {
+            this->stock.push_back(items[slot]);
+        }
+    } else {
+        this->stock = items;
+    }
+
+    // A code shared by several items is held by the first of them, which
+    // the stored trie is not checked against, so the trie is rebuilt then
+    const vector<int> &stockAmounts = this->columns.getStockAmounts();
+
+    if (this->duplicateCodes ||
+        !this->codeTrie.restore(move(indexes.trieNodes),
+                                move(indexes.trieLabels), stockAmounts) ||
+        this->codeTrie.getSize() != this->codeIndex.getSize()) {
+        this->codeTrie.clear();
+
+        for (uint32_t slot = 0; slot < items.size(); slot++) {
+            this->codeTrie.insert(this->columns.getCode(codeIds[slot]), slot,
+                                  stockAmounts[slot]);
+        }
+
+        this->codeTrie.compact();
+    }
+
+    if (!this->restoreSortedIndexes(indexes)) {
+        this->rebuildSortedIndexes();
+    }
+}
+
+/**
+ * Removes items from the inventory. The removed items are taken out of the
+ * indexes, then the columns are compacted in one pass and the indexes
+ * renumbered to match, so every slot keeps the order the items were added.
+ * The stock and type partitions are compacted in the same order. Items the
+ * inventory adopted are deleted, and items in its arena are destroyed with
+ * their storage kept for the next items created. Items with reservations
+ * still pending are refused, as the reservations point at them, and no
+ * pointers to the items removed may be used afterwards.
+ *
+ * @param items                     items of the inventory to remove
+ * @throws invalid_argument         if an item is not in the inventory, or
+ *                                  has a reservation pending
  */
-void Inventory::sortByPrice(bool ascending) {
-    // Lambda for comparing two stock items by price
-    auto comparisionMethod = [ascending](const StockItem *item1,
-                                         const StockItem *item2) -> bool {
-        // Comparision method changes if wanting to sort ascending/descending
-        if (ascending == true) {
-            return item1->getUnitPrice() < item2->getUnitPrice();
-        } else {
-            return item1->getUnitPrice() > item2->getUnitPrice();
+void Inventory::remove(const vector<StockItem *> &items) {
+    const vector<StockItem *> &slotItems = this->columns.getItems();
+
+    // Checks every item before changing anything
+    for (StockItem *item : items) {
+        uint32_t slot = item->getSlot();
+
+        if (slot >= slotItems.size() || slotItems[slot] != item) {
+            throw invalid_argument("Item to remove is not in the inventory.");
+        }
+
+        if (item->hasPendingReservations()) {
+            throw invalid_argument("Item to remove has a reservation "
+                                   "pending.");
+        }
+    }
+
+    if (items.empty()) {
+        return;
+    }
+
+    unordered_set<StockItem *> removedItems;
+
+    // Slots of the items removed, and the codes they held in the code index
+    // while other items share them
+    vector<uint32_t> removedSlots;
+    vector<uint32_t> handedOverCodeIds;
+
+    for (StockItem *item : items) {
+        if (!removedItems.insert(item).second) {
+            continue;
+        }
+
+        if (this->changeObserver != nullptr) {
+            this->changeObserver->itemRemoved(*item);
         }
+
+        uint32_t slot = item->getSlot();
+        removedSlots.push_back(slot);
+
+        if (this->unindex(slot) && this->duplicateCodes) {
+            handedOverCodeIds.push_back(item->getStockCodeId());
+        }
+
+        item->attach(nullptr, 0);
+    }
+
+    sort(removedSlots.begin(), removedSlots.end());
+
+    size_t slotCount = slotItems.size();
+    uint32_t firstSlot = removedSlots.front();
+    this->columns.remove(removedSlots);
+
+    // Moves the items after the first removed down in the indexes, as they
+    // were moved in the columns
+    if (firstSlot < slotItems.size()) {
+        vector<uint32_t> newSlots(slotCount);
+
+        for (uint32_t slot = 0; slot < firstSlot; slot++) {
+            newSlots[slot] = slot;
+        }
+
+        for (uint32_t slot = firstSlot; slot < slotItems.size(); slot++) {
+            newSlots[slotItems[slot]->getSlot()] = slot;
+            slotItems[slot]->attach(this, slot);
+        }
+
+        this->codeIndex.renumber(newSlots);
+        this->codeTrie.renumber(newSlots);
+        this->priceIndex.renumber(newSlots);
+        this->resistanceIndex.renumber(newSlots);
+        this->capacitanceIndex.renumber(newSlots);
+        this->descriptionIndex.renumber(newSlots);
+    }
+
+    // Hands each code over to another item that shares it
+    const vector<uint32_t> &codeIds = this->columns.getCodeIds();
+
+    for (uint32_t codeId : handedOverCodeIds) {
+        for (uint32_t slot = 0; slot < codeIds.size(); slot++) {
+            if (codeIds[slot] == codeId) {
+                this->indexStockCode(slot);
+                break;
+            }
+        }
+    }
+
+    // Lambda to check whether an item has been removed
+    auto isRemoved = [&removedItems](StockItem *item) {
+        return removedItems.count(item) != 0;
     };
 
-    // Sorts the vector of stock items
-    sort(this->stock.begin(), this->stock.end(), comparisionMethod);
+    this->stock.erase(remove_if(this->stock.begin(), this->stock.end(),
+                                isRemoved), this->stock.end());
+
+    // Only the partitions of the types removed need compacting
+    bool typeRemoved[COMPONENT_TYPE_COUNT] = {};
+
+    for (StockItem *item : removedItems) {
+        typeRemoved[static_cast<int>(item->getType())] = true;
+    }
+
+    for (int type = 0; type < COMPONENT_TYPE_COUNT; type++) {
+        vector<StockItem *> &partition = this->typePartitions[type];
+
+        if (typeRemoved[type]) {
+            partition.erase(remove_if(partition.begin(), partition.end(),
+                                      isRemoved), partition.end());
+        }
+    }
+
+    for (StockItem *&item : this->adoptedItems) {
+        if (isRemoved(item)) {
+            removedItems.erase(item);
+            delete item;
+            item = nullptr;
+        }
+    }
+
+    this->adoptedItems.erase(std::remove(this->adoptedItems.begin(),
+                                         this->adoptedItems.end(), nullptr),
+                             this->adoptedItems.end());
+
+    // The rest belong to the arena, which reuses their storage
+    for (StockItem *item : items) {
+        if (removedItems.erase(item) != 0) {
+            this->arena.destroy(item);
+        }
+    }
 }
 
+/**
+ * Removes the item in a slot from the code, price, parametric and
+ * description indexes, using the attributes stored in the columns
+ *
+ * @param slot                      slot of item to unindex
+ * @return                          true if the item held its stock code in
+ *                                  the code index (false for a duplicate)
+ */
+bool Inventory::unindex(uint32_t slot) {
+    ComponentType componentType = this->columns.getComponentTypes()[slot];
+    string_view code = this->columns.getCode(this->columns.getCodeIds()[slot]);
+    bool codeIndexed = this->codeIndex.erase(code, slot);
+
+    if (codeIndexed) {
+        this->codeTrie.erase(code, slot);
+    }
+
+    this->priceIndex.erase(this->columns.getUnitPrices()[slot], slot);
+
+    if (ParametricIndex *index = this->valueIndex(componentType)) {
+        index->erase(this->columns.getValues()[slot], slot);
+    } else if (componentType == ComponentType::IntegratedCircuit) {
+        this->descriptionIndex.remove(slot);
+    }
+
+    return codeIndexed;
+}
 
 /**
- * Searches for a particular component type
+ * Adds an item to the stock, columns and indexes, and watches it for changes
  *
- * @param componentType             component type to search for
- * @return                          search results of components that match
+ * @param item                      item to add to inventory
+ * @param indexSorted               false if the caller will rebuild the price
+ *                                  and parametric indexes itself
  */
-vector<StockItem *> Inventory::search(const string &componentType) {
-    vector<StockItem *> searchResults;
+void Inventory::insert(StockItem *item, bool indexSorted) {
+    this->stock.push_back(item);
 
-    // Loops through stock adding any matches found to search result
-    for (StockItem *item : this->stock) {
-        if (item->getComponentType() == componentType) {
-            searchResults.push_back(item);
+    // Stores the item's attributes in the columns and watches for changes
+    uint32_t slot = this->columns.add(item);
+    item->attach(this, slot);
+
+    this->indexStockCode(slot);
+    this->typePartitions[static_cast<int>(item->getType())].push_back(item);
+
+    if (item->getType() == ComponentType::IntegratedCircuit) {
+        this->descriptionIndex.add(
+                slot, static_cast<IntegratedCircuit *>(item)->getDescription());
+    }
+
+    if (indexSorted) {
+        this->priceIndex.insert(item->getUnitPrice(), slot);
+
+        if (ParametricIndex *index = this->valueIndex(item->getType())) {
+            index->insert(this->columns.getValues()[slot], slot);
         }
     }
 
-    return searchResults;
+    if (this->changeObserver != nullptr) {
+        this->changeObserver->itemAdded(*item);
+    }
 }
 
 /**
- * Overloads the [] operator to allow array-like access to the stock
+ * Rebuilds the price index from the unit price column and the parametric
+ * indexes from the value column, sorting the values once rather than
+ * inserting them one at a time, and lays out the trie of stock codes again
+ * now that every code has been added to it
+ */
+void Inventory::rebuildSortedIndexes() {
+    const vector<int> &unitPrices = this->columns.getUnitPrices();
+    vector<pair<int, uint32_t>> pricedSlots;
+    pricedSlots.reserve(unitPrices.size());
+
+    for (uint32_t slot = 0; slot < unitPrices.size(); slot++) {
+        pricedSlots.emplace_back(unitPrices[slot], slot);
+    }
+
+    sort(pricedSlots.begin(), pricedSlots.end());
+    this->priceIndex.assign(pricedSlots);
+
+    for (ComponentType componentType : {ComponentType::Resistor,
+                                        ComponentType::Capacitor}) {
+        vector<pair<double, uint32_t>> valuedSlots;
+
+        for (StockItem *item : this->typePartitions[
+                static_cast<int>(componentType)]) {
+            uint32_t slot = item->getSlot();
+            valuedSlots.emplace_back(this->columns.getValues()[slot], slot);
+        }
+
+        sort(valuedSlots.begin(), valuedSlots.end());
+        this->valueIndex(componentType)->assign(valuedSlots);
+    }
+
+    this->codeTrie.compact();
+}
+
+/**
+ * Restores the price index and parametric indexes from stored orders of
+ * slots, without sorting. Each order must hold every item of its index
+ * once, in strictly increasing (value, slot) order by the columns, or no
+ * index is restored.
  *
- * @param i                 index of element
- * @return                  stock item stored at position
+ * @param indexes                   stored orders of the slots
+ * @return                          false if an order does not match the
+ *                                  columns
  */
-StockItem *Inventory::operator[](int i) {
-    return this->stock[i];
+bool Inventory::restoreSortedIndexes(const StoredIndexes &indexes) {
+    const vector<int> &unitPrices = this->columns.getUnitPrices();
+    vector<pair<int, uint32_t>> pricedSlots;
+
+    if (indexes.priceOrder.size() != unitPrices.size()) {
+        return false;
+    }
+
+    pricedSlots.reserve(unitPrices.size());
+
+    for (uint32_t slot : indexes.priceOrder) {
+        if (slot >= unitPrices.size()) {
+            return false;
+        }
+
+        pair<int, uint32_t> pricedSlot(unitPrices[slot], slot);
+
+        if (!pricedSlots.empty() && !(pricedSlots.back() < pricedSlot)) {
+            return false;
+        }
+
+        pricedSlots.push_back(pricedSlot);
+    }
+
+    const vector<ComponentType> &componentTypes =
+            this->columns.getComponentTypes();
+    const vector<double> &values = this->columns.getValues();
+    vector<pair<double, uint32_t>> resistorSlots, capacitorSlots;
+
+    for (ComponentType componentType : {ComponentType::Resistor,
+                                        ComponentType::Capacitor}) {
+        bool resistors = componentType == ComponentType::Resistor;
+        const vector<uint32_t> &order = resistors ? indexes.resistanceOrder
+                                                  : indexes.capacitanceOrder;
+        vector<pair<double, uint32_t>> &valuedSlots =
+                resistors ? resistorSlots : capacitorSlots;
+
+        if (order.size() != this->typePartitions[
+                static_cast<int>(componentType)].size()) {
+            return false;
+        }
+
+        valuedSlots.reserve(order.size());
+
+        for (uint32_t slot : order) {
+            if (slot >= values.size() ||
+                componentTypes[slot] != componentType) {
+                return false;
+            }
+
+            pair<double, uint32_t> valuedSlot(values[slot], slot);
+
+            if (!valuedSlots.empty() && !(valuedSlots.back() < valuedSlot)) {
+                return false;
+            }
+
+            valuedSlots.push_back(valuedSlot);
+        }
+    }
+
+    // Only replaces the indexes once every order has been checked
+    this->priceIndex.assign(pricedSlots);
+    this->resistanceIndex.assign(resistorSlots);
+    this->capacitanceIndex.assign(capacitorSlots);
+
+    return true;
 }
 
 /**
- * Overloads the output operator to stream details about the inventory.
+ * Retrieves the parametric index of the items of a component type
  *
- * @param os                        the output stream to send info to
- * @param inventory                 inventory to stream info about
- * @return                          outstream with inventory information
+ * @param componentType             component type of the items
+ * @return                          index of the resistors by resistance or
+ *                                  capacitors by capacitance, null for other
+ *                                  component types
  */
-ostream &operator<<(ostream &os, Inventory &inventory) {
-    os << "Inventory Size: " << inventory.getSize() << endl << endl;
+ParametricIndex *Inventory::valueIndex(ComponentType componentType) {
+    switch (componentType) {
+        case ComponentType::Resistor:
+            return &this->resistanceIndex;
+        case ComponentType::Capacitor:
+            return &this->capacitanceIndex;
+        default:
+            return nullptr;
+    }
+}
+
+/**
+ * Indexes the item in a slot by its stock code in the code index and trie,
+ * noting if another item already has the code
+ *
+ * @param slot                      slot of item to index
+ */
+void Inventory::indexStockCode(uint32_t slot) {
+    string_view code = this->columns.getCode(this->columns.getCodeIds()[slot]);
+
+    if (this->codeIndex.insert(code, slot)) {
+        this->codeTrie.insert(code, slot,
+                              this->columns.getStockAmounts()[slot]);
+    } else {
+        this->duplicateCodes = true;
+    }
+}
+
+/**
+ * Copies every item of another inventory into this inventory's arena,
+ * keeping both the order the items were added and their stock order
+ *
+ * @param inv                       inventory to copy
+ */
+void Inventory::copyFrom(const Inventory &inv) {
+    const vector<StockItem *> &items = inv.columns.getItems();
+    vector<StockItem *> copiedItems;
+    copiedItems.reserve(items.size());
+
+    // Copies each item, in the order they were added, as its own type
+    for (const StockItem *item : items) {
+        StockItem *copiedItem = this->arena.copy(*item);
+
+        this->insert(copiedItem, false);
+        copiedItems.push_back(copiedItem);
+    }
+
+    this->rebuildSortedIndexes();
+
+    // Matches the stock order of the copied inventory
+    for (size_t i = 0; i < inv.stock.size(); i++) {
+        this->stock[i] = copiedItems[inv.stock[i]->getSlot()];
+    }
+}
+
+/**
+ * Destroys every item in the inventory, leaving it empty. Items created in
+ * the arena are freed together, rather than one at a time.
+ */
+void Inventory::release() {
+    for (StockItem *item : this->adoptedItems) {
+        delete item;
+    }
 
-    // Prints each item in inventory
-    for (StockItem *item : inventory.stock) {
-        os << *item << endl;
+    this->adoptedItems.clear();
+    this->stock.clear();
+    this->columns.clear();
+    this->codeIndex.clear();
+    this->codeTrie.clear();
+    this->duplicateCodes = false;
+    this->priceIndex.clear();
+    this->resistanceIndex.clear();
+    this->capacitanceIndex.clear();
+    this->descriptionIndex.clear();
+
+    for (vector<StockItem *> &partition : this->typePartitions) {
+        partition.clear();
     }
+    this->arena = ItemArena();
+}
+
+/**
+ * Retrieves the amount of items in the inventory
+ *
+ * @return                          amount of items in inventory
+ */
+int Inventory::getSize() const {
+    return this->stock.size();
+}
+
+/**
+ * Allocates space for an amount of items ahead of them being added
+ *
+ * @param size                      amount of items to make space for
+ */
+void Inventory::reserve(int size) {
+    this->stock.reserve(size);
+    this->codeIndex.reserve(size);
+}
+
+/**
+ * Sorts the inventory by price, by radix sort on large inventories and by
+ * comparison sort on small ones
+ *
+ * @param ascending                 set to true to have in increasing order,
+ *                                  false for decreasing order
+ * @param method                    sorting algorithm to use
+ */
+void Inventory::sortByPrice(bool ascending, PriceSortMethod method) {
+    if (method == PriceSortMethod::Automatic) {
+        method = this->stock.size() >= RADIX_SORT_THRESHOLD
+                 ? PriceSortMethod::Radix : PriceSortMethod::Comparison;
+    }
+
+    // Pairs each item with a key that orders as its price does in the wanted
+    // direction, so that sorting reads contiguous keys rather than following
+    // each item pointer. Flipping the sign bit orders negative prices first
+    // as unsigned keys, and inverting every bit reverses the order.
+    const vector<int> &unitPrices = this->columns.getUnitPrices();
+    uint32_t keyMask = ascending ? 0x80000000u : 0x7FFFFFFFu;
+    vector<pair<uint32_t, StockItem *>> keyedStock;
+    keyedStock.reserve(this->stock.size());
+
+    for (StockItem *item : this->stock) {
+        uint32_t price = unitPrices[item->getSlot()];
+        keyedStock.emplace_back(price ^ keyMask, item);
+    }
+
+    if (method == PriceSortMethod::Radix) {
+        radixSort(keyedStock);
+    } else {
+        // Sorts the stock items, keeping items of equal price in their order
+        stable_sort(keyedStock.begin(), keyedStock.end(),
+                    [](const pair<uint32_t, StockItem *> &item1,
+                       const pair<uint32_t, StockItem *> &item2) -> bool {
+                        return item1.first < item2.first;
+                    });
+    }
+
+    for (size_t i = 0; i < keyedStock.size(); i++) {
+        this->stock[i] = keyedStock[i].second;
+    }
+}
+
+/**
+ * Sorts keyed items into increasing order of key by a least significant
+ * digit radix sort, keeping items of equal key in their order
+ *
+ * @param keyedItems                items paired with their sort keys
+ */
+void Inventory::radixSort(vector<pair<uint32_t, StockItem *>> &keyedItems) {
+    const int DIGIT_BITS = 8;
+    const int DIGIT_COUNT = 32 / DIGIT_BITS;
+    const int RADIX = 1 << DIGIT_BITS;
+
+    if (keyedItems.empty()) {
+        return;
+    }
+
+    // Counts every digit of every key in one pass
+    vector<size_t> counts(DIGIT_COUNT * RADIX, 0);
+
+    for (const pair<uint32_t, StockItem *> &keyedItem : keyedItems) {
+        for (int digit = 0; digit < DIGIT_COUNT; digit++) {
+            counts[digit * RADIX +
+                   ((keyedItem.first >> (digit * DIGIT_BITS)) & (RADIX - 1))]++;
+        }
+    }
+
+    vector<pair<uint32_t, StockItem *>> buffer(keyedItems.size());
+
+    for (int digit = 0; digit < DIGIT_COUNT; digit++) {
+        size_t *digitCounts = &counts[digit * RADIX];
+        int shift = digit * DIGIT_BITS;
+
+        // Every key shares this digit (such as the high digits of small
+        // prices), so a pass would leave the order as it is
+        uint32_t firstDigit = (keyedItems[0].first >> shift) & (RADIX - 1);
+        if (digitCounts[firstDigit] == keyedItems.size()) {
+            continue;
+        }
+
+        // Turns the counts into the position each digit's items start at
+        size_t offset = 0;
+        for (int i = 0; i < RADIX; i++) {
+            size_t count = digitCounts[i];
+            digitCounts[i] = offset;
+            offset += count;
+        }
+
+        for (const pair<uint32_t, StockItem *> &keyedItem : keyedItems) {
+            buffer[digitCounts[(keyedItem.first >> shift) & (RADIX - 1)]++] =
+                    keyedItem;
+        }
+
+        keyedItems.swap(buffer);
+    }
+}
+
+/**
+ * Sorts the inventory by several keys, comparing by each key only when the
+ * keys before it are equal. The keys of each item are packed into a single
+ * 128 bit sort key, which is then sorted stably on several threads, so that
+ * items with equal keys keep their order and repeated sorts match.
+ *
+ * @param keys                      keys to sort by, in order of precedence
+ * @param threadCount               amount of threads to sort with, 0 uses
+ *                                  one per hardware thread
+ */
+void Inventory::sortBy(const vector<SortKey> &keys, unsigned int threadCount) {
+    // Packed sort key of an item, compared as a 128 bit unsigned integer
+    struct PackedItem {
+        uint64_t high;
+        uint64_t low;
+        StockItem *item;
+    };
+
+    const vector<ComponentType> &componentTypes =
+            this->columns.getComponentTypes();
+    const vector<int> &unitPrices = this->columns.getUnitPrices();
+    const vector<int> &stockAmounts = this->columns.getStockAmounts();
+    const vector<uint32_t> &codeIds = this->columns.getCodeIds();
+
+    // Rank of the code of each slot in alphabetical order (equal codes
+    // sharing a rank), only if needed
+    vector<uint32_t> codeRanks;
+
+    int keyBits = 0;
+
+    for (const SortKey &key : keys) {
+        keyBits += key.field == SortField::ComponentType ? 8 : 32;
+
+        if (key.field == SortField::StockCode && codeRanks.empty()) {
+            vector<uint32_t> sortedSlots(codeIds.size());
+            for (size_t i = 0; i < sortedSlots.size(); i++) {
+                sortedSlots[i] = i;
+            }
+
+            parallelStableSort(sortedSlots,
+                               [this, &codeIds](uint32_t slot1,
+                                                uint32_t slot2) {
+                                   return this->columns.getCode(
+                                                  codeIds[slot1]) <
+                                          this->columns.getCode(
+                                                  codeIds[slot2]);
+                               }, threadCount);
+
+            // Interned codes are equal only if their ids are
+            codeRanks.resize(sortedSlots.size());
+            for (size_t i = 0; i < sortedSlots.size(); i++) {
+                codeRanks[sortedSlots[i]] =
+                        i > 0 && codeIds[sortedSlots[i]] ==
+                                 codeIds[sortedSlots[i - 1]]
+                        ? codeRanks[sortedSlots[i - 1]] : i;
+            }
+        }
+    }
+
+    if (keyBits > 128) {
+        throw invalid_argument("Sort keys do not fit in 128 bits");
+    }
+
+    // Packs the keys of each item, most significant first, flipping the
+    // sign bit of signed values so they order as unsigned values and
+    // inverting the bits of keys that are descending
+    vector<PackedItem> packedStock;
+    packedStock.reserve(this->stock.size());
+
+    for (StockItem *item : this->stock) {
+        uint32_t slot = item->getSlot();
+        PackedItem packedItem = {0, 0, item};
+
+        for (const SortKey &key : keys) {
+            int bits = 32;
+            uint64_t value = 0;
+
+            switch (key.field) {
+                case SortField::ComponentType:
+                    bits = 8;
+                    value = static_cast<uint8_t>(componentTypes[slot]);
+                    break;
+                case SortField::UnitPrice:
+                    value = static_cast<uint32_t>(unitPrices[slot]) ^
+                            0x80000000u;
+                    break;
+                case SortField::StockAmount:
+                    value = static_cast<uint32_t>(stockAmounts[slot]) ^
+                            0x80000000u;
+                    break;
+                case SortField::StockCode:
+                    value = codeRanks[slot];
+                    break;
+            }
+
+            if (!key.ascending) {
+                value ^= (uint64_t(1) << bits) - 1;
+            }
+
+            packedItem.high = packedItem.high << bits |
+                              packedItem.low >> (64 - bits);
+            packedItem.low = packedItem.low << bits | value;
+        }
+
+        packedStock.push_back(packedItem);
+    }
+
+    parallelStableSort(packedStock,
+                       [](const PackedItem &item1, const PackedItem &item2) {
+                           return item1.high < item2.high ||
+                                  (item1.high == item2.high &&
+                                   item1.low < item2.low);
+                       }, threadCount);
+
+    for (size_t i = 0; i < packedStock.size(); i++) {
+        this->stock[i] = packedStock[i].item;
+    }
+}
+
+/**
+ * Finds the k items with the largest keys that pass a filter, largest first.
+ * Items with equal keys are in the order they are in the inventory, so the
+ * result matches sorting the inventory by decreasing key and keeping the
+ * first k items.
+ *
+ * @param key                       attribute to order items by
+ * @param k                         amount of items to find
+ * @param filter                    filter items must pass
+ * @param threadCount               amount of threads to search with, 0 uses
+ *                                  one per hardware thread
+ * @return                          up to k items, largest key first
+ */
+vector<StockItem *> Inventory::topK(SortField key, size_t k,
+                                    const ColumnFilter &filter,
+                                    unsigned int threadCount) const {
+    return this->selectK(key, k, filter, true, threadCount);
+}
+
+/**
+ * Finds the k items with the smallest keys that pass a filter, smallest
+ * first. Items with equal keys are in the order they are in the inventory.
+ *
+ * @param key                       attribute to order items by
+ * @param k                         amount of items to find
+ * @param filter                    filter items must pass
+ * @param threadCount               amount of threads to search with, 0 uses
+ *                                  one per hardware thread
+ * @return                          up to k items, smallest key first
+ */
+vector<StockItem *> Inventory::bottomK(SortField key, size_t k,
+                                       const ColumnFilter &filter,
+                                       unsigned int threadCount) const {
+    return this->selectK(key, k, filter, false, threadCount);
+}
+
+/**
+ * Finds the k items with the largest or smallest keys that pass a filter,
+ * reading the keys from the columns
+ *
+ * @param key                       attribute to order items by
+ * @param k                         amount of items to find
+ * @param filter                    filter items must pass
+ * @param largest                   true for the largest keys, false for the
+ *                                  smallest
+ * @param threadCount               amount of threads to search with
+ * @return                          up to k items, best first
+ */
+vector<StockItem *> Inventory::selectK(SortField key, size_t k,
+                                       const ColumnFilter &filter,
+                                       bool largest,
+                                       unsigned int threadCount) const {
+    const StockColumns &columns = this->columns;
+
+    switch (key) {
+        case SortField::ComponentType:
+            return selectItems(this->stock, columns, k, filter, largest,
+                               threadCount, [&columns](uint32_t slot) {
+                        return static_cast<int>(
+                                columns.getComponentTypes()[slot]);
+                    });
+        case SortField::UnitPrice:
+            return selectItems(this->stock, columns, k, filter, largest,
+                               threadCount, [&columns](uint32_t slot) {
+                        return columns.getUnitPrices()[slot];
+                    });
+        case SortField::StockAmount:
+            return selectItems(this->stock, columns, k, filter, largest,
+                               threadCount, [&columns](uint32_t slot) {
+                        return columns.getStockAmounts()[slot];
+                    });
+        default:
+            return selectItems(this->stock, columns, k, filter, largest,
+                               threadCount, [&columns](uint32_t slot) {
+                        return columns.getCode(columns.getCodeIds()[slot]);
+                    });
+    }
+}
+
+/**
+ * Searches for a particular component type
+ *
+ * @param componentType             component type to search for
+ * @return                          search results of components that match
+ */
+const vector<StockItem *> &Inventory::search(const string &componentType) {
+    static const vector<StockItem *> noResults;
+    ComponentType type;
+
+    // Unknown component types have no matches
+    if (!componentTypeNamed(componentType, type)) {
+        return noResults;
+    }
+
+    return this->search(type);
+}
+
+/**
+ * Searches for a particular component type. Items are partitioned by type as
+ * they are added, so no items are compared or copied.
+ *
+ * @param componentType             component type to search for
+ * @return                          search results of components that match,
+ *                                  in the order they were added
+ */
+const vector<StockItem *> &Inventory::search(
+        ComponentType componentType) const {
+    return this->typePartitions[static_cast<int>(componentType)];
+}
+
+/**
+ * Retrieves the columnar storage of the inventory's items, for scans that
+ * only need some of each item's attributes
+ *
+ * @return                          columns of the inventory's items
+ */
+const StockColumns &Inventory::getColumns() const {
+    return this->columns;
+}
+
+/**
+ * Retrieves the index of the inventory's items ordered by unit price, which
+ * gives the items in price order without sorting the inventory
+ *
+ * @return                          price index of the inventory's items
+ */
+const PriceIndex &Inventory::getPriceIndex() const {
+    return this->priceIndex;
+}
+
+/**
+ * Retrieves the index of resistors by resistance or of capacitors by
+ * capacitance
+ *
+ * @param componentType             resistor or capacitor
+ * @return                          parametric index of the component type
+ */
+const ParametricIndex &Inventory::getValueIndex(
+        ComponentType componentType) const {
+    switch (componentType) {
+        case ComponentType::Resistor:
+            return this->resistanceIndex;
+        case ComponentType::Capacitor:
+            return this->capacitanceIndex;
+        default:
+            throw invalid_argument("Only resistors and capacitors are "
+                                   "indexed by value.");
+    }
+}
+
+/**
+ * Finds the resistors with a resistance (ohms) or capacitors with a
+ * capacitance (picofarads) in a range using the parametric index, rather
+ * than checking every resistor or capacitor
+ *
+ * @param componentType             resistor or capacitor
+ * @param lowValue                  lowest value to find (inclusive)
+ * @param highValue                 highest value to find (inclusive)
+ * @param inStockOnly               true to only find items in stock
+ * @return                          matching items in order of value
+ */
+vector<StockItem *> Inventory::searchValueRange(ComponentType componentType,
+                                                double lowValue,
+                                                double highValue,
+                                                bool inStockOnly) const {
+    const vector<int> &stockAmounts = this->columns.getStockAmounts();
+    vector<StockItem *> results;
+
+    this->getValueIndex(componentType).forEachInRange(
+            lowValue, highValue,
+            [this, &stockAmounts, &results, inStockOnly](uint32_t slot) {
+                if (!inStockOnly || stockAmounts[slot] > 0) {
+                    results.push_back(this->columns.getItems()[slot]);
+                }
+                return true;
+            });
+
+    return results;
+}
+
+/**
+ * Finds the resistor or capacitor with the value nearest a value, such as
+ * the closest substitute in stock for a part. Values are compared by ratio,
+ * the scale preferred value series are spaced on.
+ *
+ * @param componentType             resistor or capacitor
+ * @param value                     resistance (ohms) or capacitance
+ *                                  (picofarads) wanted
+ * @param inStockOnly               true to only find items in stock
+ * @return                          nearest item, null if there is none
+ */
+StockItem *Inventory::findNearestValue(ComponentType componentType,
+                                       double value, bool inStockOnly) const {
+    const vector<int> &stockAmounts = this->columns.getStockAmounts();
+    uint32_t slot;
+
+    bool found = this->getValueIndex(componentType).findNearest(
+            value, [&stockAmounts, inStockOnly](uint32_t candidate) {
+                return !inStockOnly || stockAmounts[candidate] > 0;
+            }, slot);
+
+    return found ? this->columns.getItems()[slot] : nullptr;
+}
+
+/**
+ * Retrieves the full-text index of the descriptions of the inventory's
+ * integrated circuits
+ *
+ * @return                          description index of the inventory
+ */
+const DescriptionIndex &Inventory::getDescriptionIndex() const {
+    return this->descriptionIndex;
+}
+
+/**
+ * Finds the integrated circuits whose descriptions have all (or any) of the
+ * terms of a search, ignoring case, using the description index rather than
+ * reading every description. Terms ending in * match any term they prefix.
+ *
+ * @param terms                     terms to search for, such as "4-bit count*"
+ * @param match                     whether items need all terms or any
+ * @return                          matching items, in the order added
+ */
+vector<StockItem *> Inventory::searchDescriptions(string_view terms,
+                                                  TermMatch match) const {
+    vector<StockItem *> results;
+
+    for (uint32_t slot : this->descriptionIndex.findTerms(terms, match)) {
+        results.push_back(this->columns.getItems()[slot]);
+    }
+
+    return results;
+}
+
+/**
+ * Finds the integrated circuits whose descriptions contain text anywhere,
+ * ignoring case, using the trigrams of the description index
+ *
+ * @param text                      text to search for, such as "op-am"
+ * @return                          matching items, in the order added
+ */
+vector<StockItem *> Inventory::searchDescriptionText(string_view text) const {
+    vector<StockItem *> results;
+
+    for (uint32_t slot : this->descriptionIndex.findText(text)) {
+        results.push_back(this->columns.getItems()[slot]);
+    }
+
+    return results;
+}
+
+/**
+ * Retrieves the item stored in a slot of the columns and indexes
+ *
+ * @param slot                      slot of item
+ * @return                          item in slot
+ */
+StockItem *Inventory::getItemInSlot(uint32_t slot) const {
+    return this->columns.getItems()[slot];
+}
+
+/**
+ * Checks that an item other than the one given does not already have a
+ * stock code, if the inventory is watched. Its observer (such as a
+ * write-ahead log) records items by stock code, so tells them apart only
+ * while codes are unique.
+ *
+ * @param code                      stock code to check
+ * @param item                      item allowed to have the code
+ * @throws invalid_argument         if the inventory is watched and another
+ *                                  item has the code
+ */
+void Inventory::checkCodeUnique(string_view code,
+                                const StockItem *item) const {
+    if (this->changeObserver == nullptr) {
+        return;
+    }
+
+    StockItem *other = this->find(code);
+
+    if (other != nullptr && other != item) {
+        throw invalid_argument("Stock code " + string(code) +
+                               " is already used in a watched inventory.");
+    }
+}
+
+/**
+ * Refuses a new stock code for an item if the inventory is watched and
+ * another item has the code
+ *
+ * @param item                      item changing
+ * @param newCode                   stock code the item is given
+ * @throws invalid_argument         if another item of a watched inventory
+ *                                  has the code
+ */
+void Inventory::stockCodeChanging(StockItem &item, string_view newCode) {
+    this->checkCodeUnique(newCode, &item);
+}
+
+/**
+ * Refreshes the columns after an item's stock code changes
+ *
+ * @param item                      item that changed
+ * @param oldCode                   previous stock code of item
+ */
+void Inventory::stockCodeChanged(StockItem &item, string_view oldCode) {
+    uint32_t slot = item.getSlot();
+    bool wasIndexed = this->codeIndex.erase(oldCode, slot);
+
+    if (wasIndexed) {
+        this->codeTrie.erase(oldCode, slot);
+    }
+
+    this->columns.update(slot);
+    this->indexStockCode(slot);
+
+    // Hands the old code over to another item that shares it
+    uint32_t oldCodeId;
+
+    if (wasIndexed && this->duplicateCodes &&
+        this->columns.findCode(oldCode, oldCodeId)) {
+        const vector<uint32_t> &codeIds = this->columns.getCodeIds();
+
+        for (uint32_t otherSlot = 0; otherSlot < codeIds.size();
+             otherSlot++) {
+            if (codeIds[otherSlot] == oldCodeId) {
+                this->indexStockCode(otherSlot);
+                break;
+            }
+        }
+    }
+
+    if (this->changeObserver != nullptr) {
+        this->changeObserver->stockCodeChanged(item, oldCode);
+    }
+}
+
+/**
+ * Refreshes the columns after an item's stock amount changes
+ *
+ * @param item                      item that changed
+ * @param oldAmount                 previous stock amount of item
+ */
+void Inventory::stockAmountChanged(StockItem &item, int oldAmount) {
+    uint32_t slot = item.getSlot();
+
+    this->columns.update(slot);
+    this->codeTrie.updateAmount(item.getStockCode(), slot,
+                                item.getStockAmount());
+
+    if (this->changeObserver != nullptr) {
+        this->changeObserver->stockAmountChanged(item, oldAmount);
+    }
+}
+
+/**
+ * Refreshes the columns after an item's unit price changes
+ *
+ * @param item                      item that changed
+ * @param oldPrice                  previous unit price of item
+ */
+void Inventory::unitPriceChanged(StockItem &item, int oldPrice) {
+    uint32_t slot = item.getSlot();
+
+    this->columns.update(slot);
+    this->priceIndex.erase(oldPrice, slot);
+    this->priceIndex.insert(item.getUnitPrice(), slot);
+
+    if (this->changeObserver != nullptr) {
+        this->changeObserver->unitPriceChanged(item, oldPrice);
+    }
+}
+
+/**
+ * Refreshes the columns after a type specific attribute of an item changes
+ *
+ * @param item                      item that changed
+ */
+void Inventory::attributeChanged(StockItem &item) {
+    uint32_t slot = item.getSlot();
+    double oldValue = this->columns.getValues()[slot];
+
+    this->columns.update(slot);
+
+    if (ParametricIndex *index = this->valueIndex(item.getType())) {
+        index->erase(oldValue, slot);
+        index->insert(this->columns.getValues()[slot], slot);
+    } else if (item.getType() == ComponentType::IntegratedCircuit) {
+        // Reindexes the description, which replaces the old one
+        this->descriptionIndex.add(
+                slot, static_cast<IntegratedCircuit &>(item).getDescription());
+    }
+
+    if (this->changeObserver != nullptr) {
+        this->changeObserver->attributeChanged(item);
+    }
+}
+
+/**
+ * Retrieves the trie of the inventory's stock codes
+ *
+ * @return                          code trie of the inventory
+ */
+const StockCodeTrie &Inventory::getCodeTrie() const {
+    return this->codeTrie;
+}
+
+/**
+ * Finds the items with stock codes starting with a prefix using the code
+ * trie, such as for completing a partly typed code. The items with the most
+ * stock come first, items with equal stock in order of code.
+ *
+ * @param prefix                    start of the codes to find, such as RES_4
+ * @param limit                     most items to find
+ * @return                          matching items, most stock first
+ */
+vector<StockItem *> Inventory::searchCodePrefix(string_view prefix,
+                                                size_t limit) const {
+    vector<StockItem *> results;
+
+    for (uint32_t slot : this->codeTrie.findPrefix(prefix, limit)) {
+        results.push_back(this->columns.getItems()[slot]);
+    }
+
+    return results;
+}
+
+/**
+ * Finds the items with stock codes within an edit distance of a code using
+ * the code trie, such as for correcting a mistyped code, or with codes
+ * starting with text within the distance for completing one. The items with
+ * the most stock come first, items with equal stock in order of code.
+ *
+ * @param code                      code to find codes close to
+ * @param maxDistance               most characters inserted, removed or
+ *                                  replaced to accept
+ * @param matchPrefix               true to find codes starting with text
+ *                                  close to the code
+ * @param limit                     most items to find
+ * @return                          matching items, most stock first
+ */
+vector<StockItem *> Inventory::searchCodeFuzzy(string_view code,
+                                               unsigned int maxDistance,
+                                               bool matchPrefix,
+                                               size_t limit) const {
+    vector<StockItem *> results;
+
+    for (uint32_t slot : this->codeTrie.findFuzzy(code, maxDistance,
+                                                  matchPrefix, limit)) {
+        results.push_back(this->columns.getItems()[slot]);
+    }
+
+    return results;
+}
+
+/**
+ * Finds the item with a stock code using the stock code index, rather than
+ * searching through every item
+ *
+ * @param code                      stock code to find
+ * @return                          item with code, null if there is none
+ */
+StockItem *Inventory::find(string_view code) const {
+    uint32_t slot;
+
+    if (!this->codeIndex.find(code, slot)) {
+        return nullptr;
+    }
+
+    return this->columns.getItems()[slot];
+}
+
+/**
+ * Checks whether more than one item has been given the same stock code, in
+ * which case find only returns one of them
+ *
+ * @return                          true if any stock code is shared
+ */
+bool Inventory::hasDuplicateCodes() const {
+    return this->duplicateCodes;
+}
+
+/**
+ * Takes an amount of stock of the item with a stock code for an order, only
+ * if at least that much is left. The stock is taken by compare and swap on
+ * the item's stock amount, so many threads may reserve stock at once, even
+ * of the same item, and alongside the const methods. Nothing but the item's
+ * stock amount changes, so the columns and indexes keep the amounts from
+ * before until syncStockAmounts is called. The reservation points at the
+ * item, so must be committed or released before the item is removed or the
+ * inventory is destroyed or reloaded (remove refuses the item until then).
+ *
+ * @param code                      stock code of item to reserve
+ * @param quantity                  amount of stock to reserve
+ * @return                          reservation of the stock, not pending if
+ *                                  too little is left
+ */
+StockReservation Inventory::tryReserve(string_view code, int quantity) {
+    StockItem *item = this->find(code);
+
+    if (item == nullptr) {
+        throw invalid_argument("No item has the stock code " +
+                               string(code) + ".");
+    }
+
+    if (!item->tryTakeStock(quantity)) {
+        return StockReservation();
+    }
+
+    return StockReservation(item, quantity);
+}
+
+/**
+ * Commits a reservation, keeping its stock taken for good as the order is
+ * fulfilled. Static, as nothing but the reservation changes, so any holder
+ * of a reservation may commit it. Safe to call from many threads at once.
+ *
+ * @param reservation               pending reservation to commit
+ */
+void Inventory::commit(StockReservation &reservation) {
+    if (!reservation.isPending()) {
+        throw invalid_argument("Reservation holds no stock to commit.");
+    }
+
+    reservation.item->settleReservation();
+    reservation.item = nullptr;
+}
+
+/**
+ * Releases a reservation, putting its stock back for other orders. Static,
+ * as nothing but the item's atomic stock amount changes. Safe to call from
+ * many threads at once.
+ *
+ * @param reservation               pending reservation to release
+ */
+void Inventory::release(StockReservation &reservation) {
+    if (!reservation.isPending()) {
+        throw invalid_argument("Reservation holds no stock to release.");
+    }
+
+    reservation.item->returnStock(reservation.quantity);
+    reservation.item->settleReservation();
+    reservation.item = nullptr;
+}
+
+/**
+ * Refreshes the columns and indexes with the stock amounts of items that
+ * reservations have changed since they were last refreshed. Must not be
+ * called while reservations are being made.
+ */
+void Inventory::syncStockAmounts() {
+    const vector<StockItem *> &items = this->columns.getItems();
+    const vector<int> &stockAmounts = this->columns.getStockAmounts();
+
+    for (size_t slot = 0; slot < items.size(); slot++) {
+        int oldAmount = stockAmounts[slot];
+
+        if (items[slot]->getStockAmount() != oldAmount) {
+            this->stockAmountChanged(*items[slot], oldAmount);
+        }
+    }
+}
+
+/**
+ * Sets an observer to tell of every change made to the inventory's items,
+ * after the columns and indexes are refreshed, and of every item added.
+ * Stock amounts changed by reservations are told once they are synced.
+ * Copies of the inventory are not watched. While watched, the inventory
+ * refuses items and code changes that would share a stock code, so the
+ * observer can tell items apart by their codes.
+ *
+ * @param observer                  observer to tell, null to stop
+ * @throws invalid_argument         if the inventory already has items
+ *                                  sharing a stock code
+ */
+void Inventory::watch(StockItemObserver *observer) {
+    if (observer != nullptr && this->duplicateCodes) {
+        throw invalid_argument("An inventory with items sharing a stock "
+                               "code cannot be watched.");
+    }
+
+    this->changeObserver = observer;
+}
+
+/**
+ * Overloads the [] operator to allow array-like access to the stock
+ *
+ * @param i                 index of element
+ * @return                  stock item stored at position
+ */
+StockItem *Inventory::operator[](int i) {
+    return this->stock[i];
+}
+
+/**
+ * Overloads the output operator to stream details about the inventory.
+ *
+ * @param os                        the output stream to send info to
+ * @param inventory                 inventory to stream info about
+ * @return                          outstream with inventory information
+ */
+ostream &operator<<(ostream &os, Inventory &inventory) {
+    // Prints each item in inventory, writing the stream in large blocks
+    ReportWriter(os).writeInventory(inventory);
 
     return os;
 }
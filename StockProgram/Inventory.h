@@ -17,12 +17,150 @@
 #include <vector>
 #include <map>
 #include "StockItem.h"
+#include "StockReservation.h"
+#include "Aggregation.h"
+#include "StockColumns.h"
+#include "ItemArena.h"
+#include "StockCodeIndex.h"
+#include "StockCodeTrie.h"
+#include "DescriptionIndex.h"
+#include "ParametricIndex.h"
+#include "PriceIndex.h"
 
-class Inventory {
+// Algorithms for sorting an inventory by price
+enum class PriceSortMethod {
+    Automatic, Comparison, Radix
+};
+
+// Attributes an inventory can be sorted by
+enum class SortField {
+    ComponentType, UnitPrice, StockAmount, StockCode
+};
+
+// An attribute to sort by and the direction to sort it in
+struct SortKey {
+    SortField field;
+    bool ascending;
+
+    SortKey(SortField field, bool ascending = true)
+            : field(field), ascending(ascending) {
+    }
+};
+
+// The stock order and sorted indexes of an inventory, stored alongside its
+// items (such as in a snapshot) so they are restored rather than rebuilt.
+// Orders list slots; any left empty are rebuilt.
+struct StoredIndexes {
+    // Slot of each item, in stock order
+    std::vector<uint32_t> stockOrder;
+
+    // Slots of every item ordered by unit price, then slot
+    std::vector<uint32_t> priceOrder;
+
+    // Slots of the resistors and of the capacitors ordered by value, then
+    // slot
+    std::vector<uint32_t> resistanceOrder;
+    std::vector<uint32_t> capacitanceOrder;
+
+    // Nodes and labels of the trie of stock codes
+    std::vector<StockCodeTrie::Node> trieNodes;
+    std::string trieLabels;
+};
+
+class Inventory : private StockItemObserver {
 private:
     // Stores the inventory of stockitems
     std::vector<StockItem *> stock;
+
+    // Stores the attributes of each item in columns, in the order added
+    StockColumns columns;
+
+    // Pools the items created by the inventory, freeing them all at once
+    ItemArena arena;
+
+    // Items added from outside the arena, which are deleted individually
+    std::vector<StockItem *> adoptedItems;
+
+    // Index of the slot of each item by its stock code
+    StockCodeIndex codeIndex;
+
+    // Trie of the stock codes, for completing and correcting codes
+    StockCodeTrie codeTrie;
+
+    // Whether more than one item has been given the same stock code
+    bool duplicateCodes;
+
+    // Items of each component type, in the order they were added
+    std::vector<StockItem *> typePartitions[COMPONENT_TYPE_COUNT];
+
+    // Indexes an item by its stock code
+    void indexStockCode(uint32_t slot);
+
+    // Removes the item in a slot from every index, returning whether it
+    // held its stock code in the code index
+    bool unindex(uint32_t slot);
+
+    // Index of the slot of each item ordered by unit price
+    PriceIndex priceIndex;
+
+    // Indexes of the slots of resistors ordered by resistance and of
+    // capacitors ordered by capacitance
+    ParametricIndex resistanceIndex;
+    ParametricIndex capacitanceIndex;
+
+    // Full-text index of the descriptions of integrated circuits
+    DescriptionIndex descriptionIndex;
+
+    // Observer told of every change to the items (null if none)
+    StockItemObserver *changeObserver;
+
+    // Retrieves the parametric index of a component type (null if none)
+    ParametricIndex *valueIndex(ComponentType componentType);
+
+    // Throws if the inventory is watched and an item other than the one
+    // given already has a stock code
+    void checkCodeUnique(std::string_view code,
+                         const StockItem *item = nullptr) const;
+
+    // Adds an item to the stock and indexes (ownership is handled by caller)
+    void insert(StockItem *item, bool indexSorted = true);
+
+    // Rebuilds the price and parametric indexes from the columns in one pass
+    void rebuildSortedIndexes();
+
+    // Restores the price and parametric indexes from stored orders,
+    // returning false if the orders do not match the columns
+    bool restoreSortedIndexes(const StoredIndexes &indexes);
+
+    // Copies the items of another inventory into this inventory's arena
+    void copyFrom(const Inventory &inv);
+
+    // Sorts keyed items by key, keeping items of equal key in their order
+    static void radixSort(
+            std::vector<std::pair<uint32_t, StockItem *>> &keyedItems);
+
+    // Finds the items with the largest/smallest keys, best first
+    std::vector<StockItem *> selectK(SortField key, size_t k,
+                                     const ColumnFilter &filter,
+                                     bool largest,
+                                     unsigned int threadCount) const;
+
+    // Destroys every item in the inventory
+    void release();
+
+    // Keeps the columns up to date with changes made to the items, refusing
+    // stock codes that would be shared while the inventory is watched
+    void stockCodeChanging(StockItem &item,
+                           std::string_view newCode) override;
+    void stockCodeChanged(StockItem &item,
+                          std::string_view oldCode) override;
+    void stockAmountChanged(StockItem &item, int oldAmount) override;
+    void unitPriceChanged(StockItem &item, int oldPrice) override;
+    void attributeChanged(StockItem &item) override;
 public:
+    // Inventory size from which sorting by price uses a radix sort
+    static const size_t RADIX_SORT_THRESHOLD = 128;
+
     // Inventory Constructor
     Inventory();
 
@@ -35,17 +173,153 @@ public:
     // Inventory Copy Assignment Operator Overload
     Inventory &operator=(const Inventory &inv);
 
-    // Adds an item to the inventory
+    // Inventory Move Constructor
+    Inventory(Inventory &&inv) noexcept;
+
+    // Inventory Move Assignment Operator Overload
+    Inventory &operator=(Inventory &&inv) noexcept;
+
+    // Adds an item to the inventory, taking ownership of it
     void add(StockItem *item);
 
+    /**
+     * Creates a new item in the inventory's arena and adds it to the
+     * inventory
+     *
+     * @param args                      arguments for the item's constructor
+     * @return                          pointer to the new item
+     */
+    template <typename T, typename... Args>
+    T *create(Args &&... args) {
+        T *item = this->arena.create<T>(std::forward<Args>(args)...);
+        this->insert(item);
+
+        return item;
+    }
+
+    // Copies an item into the inventory's arena and adds the copy
+    StockItem *addCopy(const StockItem &item);
+
+    // Takes ownership of an arena's items, adding the given items in order
+    void splice(ItemArena &itemArena, const std::vector<StockItem *> &items);
+
+    // Takes ownership of an arena's items, given in the order they were
+    // added, restoring the stock order and indexes stored with them
+    void restore(ItemArena &itemArena, const std::vector<StockItem *> &items,
+                 StoredIndexes indexes);
+
+    // Removes items from the inventory, destroying those it owns (refusing
+    // items with reservations pending)
+    void remove(const std::vector<StockItem *> &items);
+
     // Retrieves the amount of items in the inventory
     int getSize() const;
 
+    // Allocates space for an amount of items ahead of adding them
+    void reserve(int size);
+
     // Sorts the inventory by price (increasing/decreasing)
-    void sortByPrice(bool decreasing);
+    void sortByPrice(bool ascending,
+                     PriceSortMethod method = PriceSortMethod::Automatic);
+
+    // Sorts the inventory by several keys, in order of precedence
+    void sortBy(const std::vector<SortKey> &keys,
+                unsigned int threadCount = 0);
+
+    // Finds the items with the largest keys, best first
+    std::vector<StockItem *> topK(SortField key, size_t k,
+                                  const ColumnFilter &filter = ColumnFilter(),
+                                  unsigned int threadCount = 0) const;
+
+    // Finds the items with the smallest keys, best first
+    std::vector<StockItem *> bottomK(
+            SortField key, size_t k,
+            const ColumnFilter &filter = ColumnFilter(),
+            unsigned int threadCount = 0) const;
 
     // Searches for an array of items in the inventory
-    std::vector<StockItem *> search(const std::string &componentType);
+    const std::vector<StockItem *> &search(const std::string &componentType);
+
+    // Searches for an array of items of a component type in the inventory
+    const std::vector<StockItem *> &search(
+            ComponentType componentType) const;
+
+    // Retrieves the columnar storage of the inventory's items
+    const StockColumns &getColumns() const;
+
+    // Retrieves the index of the inventory's items ordered by unit price
+    const PriceIndex &getPriceIndex() const;
+
+    // Retrieves the index of resistors by resistance or capacitors by
+    // capacitance
+    const ParametricIndex &getValueIndex(ComponentType componentType) const;
+
+    // Finds the resistors/capacitors with a value in a range, in value order
+    std::vector<StockItem *> searchValueRange(ComponentType componentType,
+                                              double lowValue,
+                                              double highValue,
+                                              bool inStockOnly = false) const;
+
+    // Finds the resistor/capacitor with the value nearest a value
+    StockItem *findNearestValue(ComponentType componentType, double value,
+                                bool inStockOnly = true) const;
+
+    // Retrieves the full-text index of integrated circuit descriptions
+    const DescriptionIndex &getDescriptionIndex() const;
+
+    // Finds the integrated circuits with all/any terms in their description
+    std::vector<StockItem *> searchDescriptions(
+            std::string_view terms, TermMatch match = TermMatch::All) const;
+
+    // Finds the integrated circuits with text anywhere in their description
+    std::vector<StockItem *> searchDescriptionText(
+            std::string_view text) const;
+
+    // Retrieves the item stored in a slot of the columns and indexes
+    StockItem *getItemInSlot(uint32_t slot) const;
+
+    // Retrieves the trie of the inventory's stock codes
+    const StockCodeTrie &getCodeTrie() const;
+
+    // Finds the items with codes starting with a prefix, most stock first
+    std::vector<StockItem *> searchCodePrefix(
+            std::string_view prefix,
+            size_t limit = std::numeric_limits<size_t>::max()) const;
+
+    // Finds the items with codes close to a (mistyped) code, most stock
+    // first
+    std::vector<StockItem *> searchCodeFuzzy(
+            std::string_view code, unsigned int maxDistance = 1,
+            bool matchPrefix = false,
+            size_t limit = std::numeric_limits<size_t>::max()) const;
+
+    // Finds the item with a stock code (null if there is none)
+    StockItem *find(std::string_view code) const;
+
+    // Checks whether more than one item has been given the same stock code
+    bool hasDuplicateCodes() const;
+
+    // Takes stock of the item with a code for an order, if enough is left
+    // (safe to call from many threads at once). The reservation must be
+    // settled before the item is removed or the inventory destroyed.
+    StockReservation tryReserve(std::string_view code, int quantity);
+
+    // Keeps the stock of a reservation taken for good (needs no inventory,
+    // as only the reservation changes)
+    static void commit(StockReservation &reservation);
+
+    // Puts the stock of a reservation back (needs no inventory, as only the
+    // item's atomic stock amount changes)
+    static void release(StockReservation &reservation);
+
+    // Refreshes the columns and indexes with stock amounts changed by
+    // reservations
+    void syncStockAmounts();
+
+    // Sets an observer to tell of every change to the items and every item
+    // added, such as a write-ahead log (null to stop). A watched inventory
+    // keeps its stock codes unique.
+    void watch(StockItemObserver *observer);
 
     // Allows for array like access to inventory
     StockItem *operator[](int i);
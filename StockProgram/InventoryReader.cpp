@@ -0,0 +1,457 @@
+/******************************************************************************
+ *
+ * File        : InventoryReader.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define the loading of inventory files.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "MappedFile.h"
+#include "InventoryReader.h"
+
+using namespace std;
+
+// Characters treated as whitespace around each detail of a line
+static const char WHITESPACE[] = "\t\n\v\f\r ";
+
+// Most details a stock item is built from
+static const size_t MAX_DETAILS = 5;
+
+// Splits a line into its trimmed details, returning the amount found
+static size_t splitDetails(string_view line, string_view *details);
+
+// Converts a detail into an integer, the same way stoi would
+static int parseInteger(string_view detail);
+
+// Smallest chunk of a file worth handing to its own thread
+static const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+/**
+ * Calls a function for every line of some text, splitting lines the same way
+ * getline would (a final newline does not start another line).
+ *
+ * @param text              text to split into lines
+ * @param lineFunction      function to call with each line
+ */
+template <typename LineFunction>
+static void forEachLine(string_view text, LineFunction lineFunction) {
+    size_t lineStart = 0;
+
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+
+        if (lineEnd == string_view::npos) {
+            lineEnd = text.size();
+        }
+
+        lineFunction(text.substr(lineStart, lineEnd - lineStart));
+        lineStart = lineEnd + 1;
+    }
+}
+
+/**
+ * A batch of stock items parsed from part of an inventory file
+ */
+struct ItemBatch {
+    // Arena the items of the batch are created in
+    ItemArena arena;
+
+    // Items parsed, in file order, with null in place of any rejected line
+    vector<StockItem *> items;
+};
+
+/**
+ * Parses every line of some text into a batch of stock items
+ *
+ * @param text              lines of an inventory file
+ * @param batch             batch to add parsed items to
+ */
+static void parseBatch(string_view text, ItemBatch &batch) {
+    forEachLine(text, [&batch](string_view line) {
+        try {
+            batch.items.push_back(parseStockItem(line, batch.arena));
+        } catch (const exception &) {
+            batch.items.push_back(nullptr);
+        }
+    });
+}
+
+/**
+ * Adds the items of parsed batches to an inventory in order, reporting each
+ * rejected line
+ *
+ * @param batches           batches to add, in file order
+ * @param inv               inventory to add items to
+ */
+static void addBatches(vector<ItemBatch> &batches, Inventory &inv) {
+    for (ItemBatch &batch : batches) {
+        vector<StockItem *> parsedItems;
+        parsedItems.reserve(batch.items.size());
+
+        for (StockItem *item : batch.items) {
+            if (item != nullptr) {
+                parsedItems.push_back(item);
+            } else {
+                cerr << "Failed to add item to inventory." << endl;
+            }
+        }
+
+        inv.splice(batch.arena, parsedItems);
+    }
+}
+
+/**
+ * Reads and loads in an inventory file
+ *
+ * @param file              inventory file to read in
+ * @return                  inventory object filled with data from file
+ */
+Inventory readInventoryFile(string &file) {
+    Inventory inv;
+
+    ifstream fileStream(file);
+
+    if (fileStream) {
+        string line;
+        const char DELIMITER = ',';
+
+        // For each line in the file, creates a stock item
+        while (getline(fileStream, line)) {
+            // Allows line to be manipulated as a stream so as to store each
+            // word on the line
+            stringstream stringStream(line);
+            string word;
+
+            // Stores the details of a stock item from a line
+            vector<string> stockItemDetails;
+
+            // For each word on a line trim whitespace and add to list
+            while (getline(stringStream, word, DELIMITER)) {
+                trim(word);
+                stockItemDetails.push_back(word);
+            }
+
+            try {
+                StockItem *newItem;
+
+                // Creates a new stock item of the correct type
+                if (stockItemDetails.at(0) == "resistor") {
+                    newItem = new Resistor(stockItemDetails.at(1),
+                                           stoi(stockItemDetails.at(2)),
+                                           stoi(stockItemDetails.at(3)),
+                                           stockItemDetails.at(4));
+                } else if (stockItemDetails.at(0) == "capacitor") {
+                    newItem = new Capacitor(stockItemDetails.at(1),
+                                            stoi(stockItemDetails.at(2)),
+                                            stoi(stockItemDetails.at(3)),
+                                            stockItemDetails.at(4));
+                } else if (stockItemDetails.at(0) == "transistor") {
+                    newItem = new Transistor(stockItemDetails.at(1),
+                                             stoi(stockItemDetails.at(2)),
+                                             stoi(stockItemDetails.at(3)),
+                                             stockItemDetails.at(4));
+                } else if (stockItemDetails.at(0) == "diode") {
+                    newItem = new Diode(stockItemDetails.at(1),
+                                        stoi(stockItemDetails.at(2)),
+                                        stoi(stockItemDetails.at(3)));
+                } else if (stockItemDetails.at(0) == "IC") {
+                    newItem = new IntegratedCircuit(stockItemDetails.at(1),
+                                                    stoi(stockItemDetails.at(
+                                                            2)),
+                                                    stoi(stockItemDetails.at(
+                                                            3)),
+                                                    stockItemDetails.at(4));
+                } else {
+                    throw invalid_argument(
+                            "Invalid component " + stockItemDetails.at(0) +
+                            " could not be added");
+                }
+
+                // Adds the newly created item to inventory
+                inv.add(newItem);
+
+            } catch (const exception &) {
+                cerr << "Failed to add item to inventory." << endl;
+            }
+
+
+        }
+    } else {
+        cerr << "Unable to open file " << file << endl;
+    }
+
+    fileStream.close();
+
+    return inv;
+}
+
+/**
+ * Reads and loads in an inventory file by mapping it into memory. Details are
+ * parsed as slices of the mapping, only copying out the values that are kept
+ * by the stock items. Accepts and rejects exactly the same lines as
+ * readInventoryFile.
+ *
+ * @param file              inventory file to read in
+ * @return                  inventory object filled with data from file
+ */
+Inventory readMappedInventoryFile(const string &file) {
+    Inventory inv;
+
+    MappedFile mappedFile(file);
+
+    if (mappedFile.isOpen()) {
+        vector<ItemBatch> batches(1);
+        parseBatch(mappedFile.getContents(), batches[0]);
+        addBatches(batches, inv);
+    } else {
+        cerr << "Unable to open file " << file << endl;
+    }
+
+    return inv;
+}
+
+/**
+ * Reads and loads in an inventory file by splitting the mapped file into
+ * chunks of whole lines and parsing each chunk on its own thread. The parsed
+ * batches are then added to the inventory in their original file order, so
+ * the result (including the lines rejected) matches readInventoryFile.
+ *
+ * @param file              inventory file to read in
+ * @param threadCount       amount of threads to parse with, 0 uses one per
+ *                          hardware thread
+ * @return                  inventory object filled with data from file
+ */
+Inventory readParallelInventoryFile(const string &file,
+                                    unsigned int threadCount) {
+    Inventory inv;
+
+    MappedFile mappedFile(file);
+
+    if (!mappedFile.isOpen()) {
+        cerr << "Unable to open file " << file << endl;
+        return inv;
+    }
+
+    string_view contents = mappedFile.getContents();
+
+    if (threadCount == 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    // Never gives a thread less than a worthwhile amount of the file
+    size_t chunkCount = min<size_t>(threadCount,
+                                    contents.size() / MIN_CHUNK_SIZE + 1);
+
+    // Splits the file into chunks which each end just after a newline
+    vector<string_view> chunks;
+    size_t chunkStart = 0;
+
+    for (size_t i = 1; i <= chunkCount && chunkStart < contents.size(); i++) {
+        size_t chunkEnd = contents.size();
+
+        if (i < chunkCount) {
+            chunkEnd = contents.find('\n', max(chunkStart,
+                                               contents.size() * i /
+                                               chunkCount));
+            chunkEnd = chunkEnd == string_view::npos ? contents.size()
+                                                     : chunkEnd + 1;
+        }
+
+        chunks.push_back(contents.substr(chunkStart, chunkEnd - chunkStart));
+        chunkStart = chunkEnd;
+    }
+
+    // Parses each chunk into its own batch, the first on this thread
+    vector<ItemBatch> batches(chunks.size());
+    vector<thread> workers;
+
+    for (size_t i = 1; i < chunks.size(); i++) {
+        workers.emplace_back(parseBatch, chunks[i], ref(batches[i]));
+    }
+
+    if (!chunks.empty()) {
+        parseBatch(chunks[0], batches[0]);
+    }
+
+    for (thread &worker : workers) {
+        worker.join();
+    }
+
+    // Splices the batches together in file order
+    size_t itemCount = 0;
+
+    for (const ItemBatch &batch : batches) {
+        itemCount += batch.items.size();
+    }
+
+    inv.reserve(itemCount);
+    addBatches(batches, inv);
+
+    return inv;
+}
+
+/**
+ * Creates a new stock item of the correct type from a line of an inventory
+ * file.
+ *
+ * @param line              line of an inventory file
+ * @param arena             arena to create the item in
+ * @return                  newly created stock item
+ * @throws exception        if the line does not describe a valid item
+ */
+StockItem *parseStockItem(string_view line, ItemArena &arena) {
+    string_view details[MAX_DETAILS];
+    size_t detailCount = splitDetails(line, details);
+
+    // Lambda to check that a line has enough details for its item type
+    auto requireDetails = [detailCount](size_t amount) {
+        if (detailCount < amount) {
+            throw out_of_range("Missing details for stock item.");
+        }
+    };
+
+    requireDetails(1);
+    string_view componentType = details[0];
+
+    if (componentType == "resistor") {
+        requireDetails(5);
+        return arena.create<Resistor>(
+                details[1], parseInteger(details[2]),
+                parseInteger(details[3]),
+                Resistor::calculateResistance(details[4]));
+    } else if (componentType == "capacitor") {
+        requireDetails(5);
+        return arena.create<Capacitor>(
+                details[1], parseInteger(details[2]),
+                parseInteger(details[3]),
+                Capacitor::convertToPicoFarads(details[4]));
+    } else if (componentType == "transistor") {
+        requireDetails(5);
+        return arena.create<Transistor>(
+                details[1], parseInteger(details[2]),
+                parseInteger(details[3]),
+                Transistor::parseDeviceType(details[4]));
+    } else if (componentType == "diode") {
+        requireDetails(4);
+        return arena.create<Diode>(
+                details[1], parseInteger(details[2]),
+                parseInteger(details[3]));
+    } else if (componentType == "IC") {
+        requireDetails(5);
+        return arena.create<IntegratedCircuit>(
+                details[1], parseInteger(details[2]),
+                parseInteger(details[3]), details[4]);
+    } else {
+        throw invalid_argument("Invalid component " + string(componentType) +
+                               " could not be added");
+    }
+}
+
+/**
+ * Splits a line into trimmed details, separated the same way as getline with
+ * a comma delimiter would (a trailing empty detail is not counted).
+ *
+ * @param line              line to split
+ * @param details           array of MAX_DETAILS to store the details in
+ * @return                  amount of details on the line
+ */
+static size_t splitDetails(string_view line, string_view *details) {
+    const char DELIMITER = ',';
+    size_t detailCount = 0;
+    size_t detailStart = 0;
+
+    while (detailStart < line.size() && detailCount < MAX_DETAILS) {
+        size_t detailEnd = line.find(DELIMITER, detailStart);
+
+        if (detailEnd == string_view::npos) {
+            detailEnd = line.size();
+        }
+
+        details[detailCount++] = trim(line.substr(detailStart,
+                                                  detailEnd - detailStart));
+        detailStart = detailEnd + 1;
+    }
+
+    return detailCount;
+}
+
+/**
+ * Converts a detail into an integer, accepting an optional sign and ignoring
+ * anything after the digits just as stoi does
+ *
+ * @param detail            trimmed detail to convert
+ * @return                  integer value of detail
+ */
+static int parseInteger(string_view detail) {
+    const char *start = detail.data();
+    const char *end = detail.data() + detail.size();
+
+    // from_chars only understands a minus sign
+    if (start != end && *start == '+') {
+        start++;
+    }
+
+    int value = 0;
+    from_chars_result result = from_chars(start, end, value);
+
+    if (result.ec == errc::invalid_argument || start == end ||
+        (*start == '-' && start != detail.data())) {
+        throw invalid_argument("Invalid integer " + string(detail));
+    } else if (result.ec == errc::result_out_of_range) {
+        throw out_of_range("Integer out of range " + string(detail));
+    }
+
+    return value;
+}
+
+/**
+ * Trims whitespace of a given string
+ *
+ * Please note that this has been modified from a version of another trim
+ * function found here:
+ * http://www.martinbroadhurst.com/how-to-trim-a-stdstring.html
+ *
+ * @param str               string to trim whitespace of
+ * @return                  trimmed string
+ */
+string &trim(string &str) {
+    const string whiteSpace = WHITESPACE;
+
+    // Removes whitespace from end of string
+    str.erase(str.find_last_not_of(whiteSpace) + 1);
+
+    // Removes whitespace from front of string
+    str.erase(0, str.find_first_not_of(whiteSpace));
+
+    return str;
+}
+
+/**
+ * Trims whitespace of a given string view without copying it
+ *
+ * @param str               string view to trim whitespace of
+ * @return                  trimmed view of the same characters
+ */
+string_view trim(string_view str) {
+    size_t first = str.find_first_not_of(WHITESPACE);
+
+    if (first == string_view::npos) {
+        return string_view();
+    }
+
+    size_t last = str.find_last_not_of(WHITESPACE);
+
+    return str.substr(first, last - first + 1);
+}
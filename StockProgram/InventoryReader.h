@@ -0,0 +1,41 @@
+/******************************************************************************
+ *
+ * File        : InventoryReader.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define the loading of inventory files.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef INVENTORYREADER_H
+#define INVENTORYREADER_H
+
+#include <string>
+#include <string_view>
+#include "StockItem.h"
+#include "Inventory.h"
+#include "ItemArena.h"
+
+// Reads and loads in an inventory file using stream based parsing
+Inventory readInventoryFile(std::string &file);
+
+// Reads and loads in an inventory file by mapping it into memory
+Inventory readMappedInventoryFile(const std::string &file);
+
+// Reads and loads in an inventory file, parsing chunks of it in parallel
+Inventory readParallelInventoryFile(const std::string &file,
+                                    unsigned int threadCount = 0);
+
+// Creates a stock item in an arena from a single line of an inventory file
+StockItem *parseStockItem(std::string_view line, ItemArena &arena);
+
+// Trims whitespace of a given string
+std::string &trim(std::string &str);
+
+// Trims whitespace of a given string view
+std::string_view trim(std::string_view str);
+
+#endif /* INVENTORYREADER_H */
@@ -0,0 +1,356 @@
+/******************************************************************************
+ *
+ * File        : InventoryReloader.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a reloader of an inventory file that
+ *               applies only the lines changed since the last reload.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include "InventoryReader.h"
+#include "InventoryReloader.h"
+#include "ItemArena.h"
+#include "MappedFile.h"
+
+using namespace std;
+
+// Mixes the hash of each line into the checksum of its block
+static const uint64_t CHECKSUM_MULTIPLIER = 0x9E3779B97F4A7C15ULL;
+
+// Changes an item to match one parsed from its line
+static bool applyChanges(StockItem &item, const StockItem &parsedItem);
+
+/**
+ * Constructs a reloader of an inventory file, which has not been loaded yet
+ *
+ * @param fileName                  name of the inventory file
+ */
+InventoryReloader::InventoryReloader(const string &fileName)
+        : fileName(fileName) {
+}
+
+/**
+ * Splits text into blocks of whole lines. A block ends after a line whose
+ * hash has its low bits clear, or after MAX_BLOCK_LINES lines, so the
+ * boundaries depend on the lines themselves rather than where they are.
+ * Each block's checksum combines the hashes of its lines in order.
+ *
+ * @param text                      lines of an inventory file
+ * @return                          each block, with no items, and its text
+ */
+vector<pair<InventoryReloader::Block, string_view>>
+InventoryReloader::splitBlocks(string_view text) {
+    vector<pair<Block, string_view>> blocks;
+    size_t blockStart = 0;
+    size_t lineStart = 0;
+    size_t lineCount = 0;
+    uint64_t checksum = 0;
+
+    while (lineStart < text.size()) {
+        size_t lineEnd = text.find('\n', lineStart);
+
+        if (lineEnd == string_view::npos) {
+            lineEnd = text.size();
+        }
+
+        uint64_t lineHash = hash<string_view>()(
+                text.substr(lineStart, lineEnd - lineStart));
+        checksum = (checksum ^ lineHash) * CHECKSUM_MULTIPLIER;
+        lineCount++;
+        lineStart = lineEnd + 1;
+
+        if ((lineHash & (AVERAGE_BLOCK_LINES - 1)) == 0 ||
+            lineCount == MAX_BLOCK_LINES || lineStart >= text.size()) {
+            size_t blockEnd = min(lineStart, text.size());
+            Block block = {checksum, blockEnd - blockStart, {}};
+
+            blocks.emplace_back(move(block), text.substr(
+                    blockStart, blockEnd - blockStart));
+            blockStart = blockEnd;
+            lineCount = 0;
+            checksum = 0;
+        }
+    }
+
+    return blocks;
+}
+
+/**
+ * Reloads the file into an inventory, applying only the changes made to it
+ * since the last reload. Blocks with the checksum and size of a block of
+ * the last reload keep their items untouched. The lines of every other
+ * block are parsed, and each is matched by stock code to an item of the
+ * last reload's blocks that are gone: an item of the same type is changed
+ * to match the line, one of another type is replaced, and a line with no
+ * match is added as a new item. Items left unmatched are removed, and the
+ * storage of items removed is reused for those added, so the memory held
+ * stays proportional to the inventory rather than to every change made.
+ * Lines that cannot be parsed are reported and skipped, as when loading a
+ * file.
+ *
+ * @param inventory                 inventory last reloaded from the file
+ *                                  (empty for the first reload)
+ * @return                          amounts of blocks and items looked at
+ *                                  and changed
+ * @throws runtime_error            if the file cannot be opened
+ */
+ReloadSummary InventoryReloader::reload(Inventory &inventory) {
+    MappedFile file(this->fileName);
+
+    if (!file.isOpen()) {
+        throw runtime_error("Unable to open file " + this->fileName);
+    }
+
+    vector<pair<Block, string_view>> newBlocks = splitBlocks(
+            file.getContents());
+    ReloadSummary summary;
+    summary.blockCount = newBlocks.size();
+
+    // Finds the blocks that are unchanged by their checksums, each old
+    // block being kept by at most one new block
+    unordered_multimap<uint64_t, size_t> oldBlockIndexes;
+    vector<bool> oldBlockKept(this->blocks.size(), false);
+    vector<size_t> changedBlocks;
+    oldBlockIndexes.reserve(this->blocks.size());
+
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        oldBlockIndexes.emplace(this->blocks[i].checksum, i);
+    }
+
+    for (size_t i = 0; i < newBlocks.size(); i++) {
+        Block &block = newBlocks[i].first;
+        auto matches = oldBlockIndexes.equal_range(block.checksum);
+        bool kept = false;
+
+        for (auto match = matches.first; match != matches.second && !kept;
+             ++match) {
+            Block &oldBlock = this->blocks[match->second];
+
+            if (!oldBlockKept[match->second] &&
+                oldBlock.size == block.size) {
+                oldBlockKept[match->second] = true;
+                block.items = move(oldBlock.items);
+                kept = true;
+            }
+        }
+
+        if (kept) {
+            summary.unchangedBlockCount++;
+        } else {
+            changedBlocks.push_back(i);
+        }
+    }
+
+    // Items of the blocks that are gone, by stock code
+    vector<StockItem *> oldItems;
+    unordered_map<uint32_t, vector<StockItem *>> oldItemsByCode;
+
+    for (size_t i = 0; i < this->blocks.size(); i++) {
+        if (oldBlockKept[i]) {
+            continue;
+        }
+
+        for (StockItem *item : this->blocks[i].items) {
+            oldItems.push_back(item);
+            oldItemsByCode[item->getStockCodeId()].push_back(item);
+        }
+    }
+
+    // Earlier items with a code are matched first
+    for (auto &codeItems : oldItemsByCode) {
+        reverse(codeItems.second.begin(), codeItems.second.end());
+    }
+
+    // Lines parsed as new items, and where each goes in the new blocks
+    ItemArena parsedArena;
+    vector<StockItem *> addedItems;
+    vector<pair<size_t, size_t>> addedPositions;
+    vector<StockItem *> removedItems;
+    unordered_set<StockItem *> matchedItems;
+
+    for (size_t i : changedBlocks) {
+        Block &block = newBlocks[i].first;
+        string_view text = newBlocks[i].second;
+        size_t lineStart = 0;
+
+        while (lineStart < text.size()) {
+            size_t lineEnd = text.find('\n', lineStart);
+
+            if (lineEnd == string_view::npos) {
+                lineEnd = text.size();
+            }
+
+            string_view line = text.substr(lineStart, lineEnd - lineStart);
+            lineStart = lineEnd + 1;
+            summary.parsedLineCount++;
+
+            StockItem *parsedItem;
+
+            try {
+                parsedItem = parseStockItem(line, parsedArena);
+            } catch (const exception &) {
+                cerr << "Failed to add item to inventory." << endl;
+                summary.rejectedLineCount++;
+                continue;
+            }
+
+            StockItem *item = nullptr;
+            auto codeItems = oldItemsByCode.find(
+                    parsedItem->getStockCodeId());
+
+            if (codeItems != oldItemsByCode.end() &&
+                !codeItems->second.empty()) {
+                item = codeItems->second.back();
+                codeItems->second.pop_back();
+                matchedItems.insert(item);
+
+                if (item->getType() != parsedItem->getType()) {
+                    removedItems.push_back(item);
+                    item = nullptr;
+                } else if (applyChanges(*item, *parsedItem)) {
+                    summary.modifiedCount++;
+                }
+            }
+
+            if (item == nullptr) {
+                item = parsedItem;
+                addedItems.push_back(parsedItem);
+                addedPositions.emplace_back(i, block.items.size());
+            }
+
+            block.items.push_back(item);
+        }
+    }
+
+    for (StockItem *item : oldItems) {
+        if (matchedItems.count(item) == 0) {
+            removedItems.push_back(item);
+        }
+    }
+
+    // Removes first, so an item replaced is never a duplicate of its
+    // replacement
+    inventory.remove(removedItems);
+
+    // An empty inventory takes the parsed items as they are (every item
+    // parsed is new), otherwise each new item is copied into the
+    // inventory's arena, reusing the storage of the items removed
+    if (inventory.getSize() == 0) {
+        inventory.splice(parsedArena, addedItems);
+    } else {
+        for (size_t i = 0; i < addedItems.size(); i++) {
+            const pair<size_t, size_t> &position = addedPositions[i];
+            newBlocks[position.first].first.items[position.second] =
+                    inventory.addCopy(*addedItems[i]);
+        }
+    }
+
+    summary.addedCount = addedItems.size();
+    summary.removedCount = removedItems.size();
+
+    this->blocks.clear();
+    this->blocks.reserve(newBlocks.size());
+
+    for (pair<Block, string_view> &newBlock : newBlocks) {
+        this->blocks.push_back(move(newBlock.first));
+    }
+
+    return summary;
+}
+
+/**
+ * Retrieves the amount of blocks the file was split into when it was last
+ * reloaded
+ *
+ * @return                          amount of blocks
+ */
+size_t InventoryReloader::getBlockCount() const {
+    return this->blocks.size();
+}
+
+/**
+ * Changes the attributes of an item that differ from those of an item of
+ * the same type parsed from its line, through its setters so that its
+ * inventory is told of each change
+ *
+ * @param item                      item to change
+ * @param parsedItem                item parsed from the item's line
+ * @return                          true if anything was changed
+ */
+static bool applyChanges(StockItem &item, const StockItem &parsedItem) {
+    bool changed = false;
+
+    if (item.getStockAmount() != parsedItem.getStockAmount()) {
+        item.setStockAmount(parsedItem.getStockAmount());
+        changed = true;
+    }
+
+    if (item.getUnitPrice() != parsedItem.getUnitPrice()) {
+        item.setUnitPrice(parsedItem.getUnitPrice());
+        changed = true;
+    }
+
+    // Changes the attributes specific to each type of item
+    switch (item.getType()) {
+        case ComponentType::Resistor: {
+            Resistor &resistor = static_cast<Resistor &>(item);
+            double resistance = static_cast<const Resistor &>(parsedItem)
+                    .getResistance();
+
+            if (resistor.getResistance() != resistance) {
+                resistor.setResistance(resistance);
+                changed = true;
+            }
+            break;
+        }
+        case ComponentType::Capacitor: {
+            Capacitor &capacitor = static_cast<Capacitor &>(item);
+            double capacitance = static_cast<const Capacitor &>(parsedItem)
+                    .getCapacitance();
+
+            if (capacitor.getCapacitance() != capacitance) {
+                capacitor.setCapacitance(capacitance);
+                changed = true;
+            }
+            break;
+        }
+        case ComponentType::Transistor: {
+            Transistor &transistor = static_cast<Transistor &>(item);
+            DeviceType deviceType = static_cast<const Transistor &>(
+                    parsedItem).getDeviceType();
+
+            if (transistor.getDeviceType() != deviceType) {
+                transistor.setDeviceType(deviceType);
+                changed = true;
+            }
+            break;
+        }
+        case ComponentType::IntegratedCircuit: {
+            IntegratedCircuit &circuit = static_cast<IntegratedCircuit &>(
+                    item);
+            const IntegratedCircuit &parsedCircuit =
+                    static_cast<const IntegratedCircuit &>(parsedItem);
+
+            if (circuit.getDescriptionId() !=
+                parsedCircuit.getDescriptionId()) {
+                circuit.setDescription(parsedCircuit.getDescription());
+                changed = true;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+
+    return changed;
+}
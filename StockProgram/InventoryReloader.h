@@ -0,0 +1,97 @@
+/******************************************************************************
+ *
+ * File        : InventoryReloader.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a reloader of an inventory file that
+ *               applies only the lines changed since the last reload.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef INVENTORYRELOADER_H
+#define INVENTORYRELOADER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Inventory.h"
+
+// Amounts of blocks and items a reload looked at and changed
+struct ReloadSummary {
+    // Blocks of lines in the file, and those skipped as unchanged
+    size_t blockCount = 0;
+    size_t unchangedBlockCount = 0;
+
+    // Lines parsed from changed blocks, and those that could not be
+    size_t parsedLineCount = 0;
+    size_t rejectedLineCount = 0;
+
+    // Items added, changed in place and removed
+    size_t addedCount = 0;
+    size_t modifiedCount = 0;
+    size_t removedCount = 0;
+};
+
+/**
+ * Reloads an inventory file into an inventory, applying only the lines that
+ * changed since the previous reload, so the cost of parsing and applying a
+ * reload is proportional to how much of the file changed.
+ *
+ * The file is split into blocks of lines, each ending after a line whose
+ * hash has its low bits clear, so inserting or removing lines only moves
+ * the boundaries of the blocks around the change. Each block is remembered
+ * by its checksum along with the items its lines became. Blocks whose
+ * checksum matches one of the previous reload are skipped; only the lines
+ * of the others are parsed, and matched by stock code against the items of
+ * the previous blocks that are gone. Matched items are changed in place
+ * (through their setters, so indexes and any watching log see the change),
+ * items of lines no longer in the file are removed, and the rest are added.
+ *
+ * The first reload loads every line, so should be given an empty inventory,
+ * and later reloads the same inventory, whose items may only be added or
+ * removed by the reloader (its items are remembered between reloads).
+ * Items added by a reload come after the items already loaded.
+ */
+class InventoryReloader {
+private:
+    // A run of lines of the file, and the items they were loaded as
+    struct Block {
+        uint64_t checksum;
+        size_t size;
+        std::vector<StockItem *> items;
+    };
+
+    // Name of the inventory file
+    std::string fileName;
+
+    // Blocks of the file as it was last reloaded, in file order
+    std::vector<Block> blocks;
+
+    // Splits text into blocks of whole lines, without their items
+    static std::vector<std::pair<Block, std::string_view>> splitBlocks(
+            std::string_view text);
+
+public:
+    // Average amount of lines in a block (a power of 2)
+    static const size_t AVERAGE_BLOCK_LINES = 16;
+
+    // Most lines in a block
+    static const size_t MAX_BLOCK_LINES = 256;
+
+    // InventoryReloader Constructor
+    explicit InventoryReloader(const std::string &fileName);
+
+    // Applies the changes made to the file since the last reload
+    ReloadSummary reload(Inventory &inventory);
+
+    // Retrieves the amount of blocks the file was split into
+    size_t getBlockCount() const;
+};
+
+#endif /* INVENTORYRELOADER_H */
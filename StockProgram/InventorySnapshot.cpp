@@ -0,0 +1,460 @@
+/******************************************************************************
+ *
+ * File        : InventorySnapshot.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a binary snapshot of an inventory, which can
+ *               be mapped into memory and queried without parsing.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "InventorySnapshot.h"
+
+using namespace std;
+
+// Magic string identifying a snapshot file
+static const char SNAPSHOT_MAGIC[8] = {'S', 'T', 'K', 'S', 'N', 'A', 'P',
+                                       '\0'};
+
+// Alignment of each section in the file
+static const uint64_t SECTION_ALIGNMENT = 8;
+
+/**
+ * Views the elements of an array as bytes, to be written to a file
+ *
+ * @param elements          array to view
+ * @return                  bytes of the elements
+ */
+template <typename T>
+static string_view asBytes(const vector<T> &elements) {
+    return string_view(reinterpret_cast<const char *>(elements.data()),
+                       elements.size() * sizeof(T));
+}
+
+/**
+ * Copies the elements stored in a section of a snapshot
+ *
+ * @param snapshot          snapshot to read
+ * @param section           section holding the elements
+ * @return                  elements of the section, empty if the section is
+ *                          missing or not a whole amount of elements
+ */
+template <typename T>
+static vector<T> readSection(const InventorySnapshot &snapshot,
+                             SnapshotSection section) {
+    string_view contents = snapshot.getSection(section);
+    vector<T> elements;
+
+    if (contents.size() % sizeof(T) == 0) {
+        elements.resize(contents.size() / sizeof(T));
+        memcpy(elements.data(), contents.data(), contents.size());
+    }
+
+    return elements;
+}
+
+/**
+ * Maps a snapshot file into memory, checking its header
+ *
+ * @param fileName          name of snapshot file
+ */
+InventorySnapshot::InventorySnapshot(const string &fileName)
+        : file(fileName), header(nullptr), records(nullptr) {
+    string_view contents = this->file.getContents();
+
+    if (contents.size() < sizeof(SnapshotHeader)) {
+        return;
+    }
+
+    const SnapshotHeader *fileHeader =
+            reinterpret_cast<const SnapshotHeader *>(contents.data());
+
+    // Checks the header describes a file of this version and size
+    uint64_t recordsEnd = sizeof(SnapshotHeader) +
+                          fileHeader->itemCount * sizeof(SnapshotRecord);
+
+    if (memcmp(fileHeader->magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0
+        || fileHeader->version != SNAPSHOT_VERSION
+        || fileHeader->recordSize != sizeof(SnapshotRecord)
+        || fileHeader->itemCount > contents.size() / sizeof(SnapshotRecord)
+        || recordsEnd > fileHeader->stringTableOffset
+        || fileHeader->stringTableOffset > contents.size()
+        || fileHeader->stringTableSize >
+           contents.size() - fileHeader->stringTableOffset) {
+        return;
+    }
+
+    this->header = fileHeader;
+    this->records = reinterpret_cast<const SnapshotRecord *>(
+            contents.data() + sizeof(SnapshotHeader));
+    this->stringTable = contents.substr(fileHeader->stringTableOffset,
+                                        fileHeader->stringTableSize);
+
+    // Sections outside the file, or trie nodes of another layout, are left
+    // missing so their indexes are rebuilt instead
+    bool trieLayout = fileHeader->trieNodeSize == sizeof(StockCodeTrie::Node);
+
+    for (size_t i = 0; i < SNAPSHOT_SECTION_COUNT; i++) {
+        bool trieSection =
+                i == static_cast<size_t>(SnapshotSection::TrieNodes) ||
+                i == static_cast<size_t>(SnapshotSection::TrieLabels);
+
+        if (fileHeader->sectionOffsets[i] <= contents.size() &&
+            fileHeader->sectionSizes[i] <=
+            contents.size() - fileHeader->sectionOffsets[i] &&
+            (trieLayout || !trieSection)) {
+            this->sections[i] = contents.substr(fileHeader->sectionOffsets[i],
+                                                fileHeader->sectionSizes[i]);
+        }
+    }
+}
+
+/**
+ * Checks if the file is a valid snapshot of this version
+ *
+ * @return                  true if the snapshot can be read
+ */
+bool InventorySnapshot::isValid() const {
+    return this->header != nullptr;
+}
+
+/**
+ * Retrieves the amount of items in the snapshot
+ *
+ * @return                  amount of items
+ */
+size_t InventorySnapshot::getSize() const {
+    return this->isValid() ? this->header->itemCount : 0;
+}
+
+/**
+ * Allows for array like access to the records
+ *
+ * @param i                 index of record
+ * @return                  record stored at position
+ */
+const SnapshotRecord &InventorySnapshot::operator[](size_t i) const {
+    return this->records[i];
+}
+
+/**
+ * Retrieves the stock code of a record
+ *
+ * @param record            record of snapshot
+ * @return                  stock code of record
+ */
+string_view InventorySnapshot::getStockCode(
+        const SnapshotRecord &record) const {
+    return this->getString(record.codeOffset, record.codeLength);
+}
+
+/**
+ * Retrieves the description of a record (empty if not an integrated circuit)
+ *
+ * @param record            record of snapshot
+ * @return                  description of record
+ */
+string_view InventorySnapshot::getDescription(
+        const SnapshotRecord &record) const {
+    return this->getString(record.descriptionOffset,
+                           record.descriptionLength);
+}
+
+/**
+ * Retrieves the contents of a section
+ *
+ * @param section           section to retrieve
+ * @return                  bytes of the section, empty if it is missing
+ */
+string_view InventorySnapshot::getSection(SnapshotSection section) const {
+    return this->sections[static_cast<size_t>(section)];
+}
+
+/**
+ * Retrieves a string from the string table
+ *
+ * @param offset            position of string in table
+ * @param length            length of string
+ * @return                  string stored in table
+ * @throws out_of_range     if the string lies outside the table
+ */
+string_view InventorySnapshot::getString(uint32_t offset,
+                                         uint32_t length) const {
+    if (offset > this->stringTable.size() ||
+        length > this->stringTable.size() - offset) {
+        throw out_of_range("Snapshot string outside of string table.");
+    }
+
+    return this->stringTable.substr(offset, length);
+}
+
+/**
+ * Writes an inventory to a snapshot file. Attributes are stored decoded and
+ * all strings are stored once in a single string table. Items are stored in
+ * the order they were added, followed by the stock order, the orders of the
+ * sorted indexes and the trie of stock codes, so loading the snapshot
+ * restores them rather than rebuilding them.
+ *
+ * @param inv               inventory to write
+ * @param file              name of snapshot file
+ * @return                  true if the snapshot was written
+ */
+bool writeInventorySnapshot(Inventory &inv, const string &file) {
+    vector<SnapshotRecord> records(inv.getSize());
+    string stringTable;
+
+    // Descriptions are shared between many items so are only stored once,
+    // found by their handle in the string pool
+    unordered_map<uint32_t, uint32_t> descriptionOffsets;
+
+    // Lambda to append a string to the string table
+    auto addString = [&stringTable](string_view str) -> uint32_t {
+        if (stringTable.size() + str.size() >
+            numeric_limits<uint32_t>::max()) {
+            throw length_error("Snapshot string table too large.");
+        }
+
+        uint32_t offset = stringTable.size();
+        stringTable += str;
+
+        return offset;
+    };
+
+    const vector<StockItem *> &items = inv.getColumns().getItems();
+
+    for (size_t slot = 0; slot < items.size(); slot++) {
+        StockItem *item = items[slot];
+        SnapshotRecord &record = records[slot];
+
+        string_view code = item->getStockCode();
+        record.codeOffset = addString(code);
+        record.codeLength = code.size();
+        record.stockAmount = item->getStockAmount();
+        record.unitPrice = item->getUnitPrice();
+
+        // Decodes the attributes specific to each type of item
+        if (Resistor *resistor = dynamic_cast<Resistor *>(item)) {
+            record.componentType = SnapshotType::Resistor;
+            record.value = resistor->getResistance();
+        } else if (Capacitor *capacitor = dynamic_cast<Capacitor *>(item)) {
+            record.componentType = SnapshotType::Capacitor;
+            record.value = capacitor->getCapacitance();
+        } else if (Transistor *transistor = dynamic_cast<Transistor *>(item)) {
+            record.componentType = SnapshotType::Transistor;
+            record.deviceType =
+                    static_cast<uint8_t>(transistor->getDeviceType());
+        } else if (IntegratedCircuit *ic =
+                dynamic_cast<IntegratedCircuit *>(item)) {
+            string_view description = ic->getDescription();
+
+            auto found = descriptionOffsets.find(ic->getDescriptionId());
+            if (found == descriptionOffsets.end()) {
+                found = descriptionOffsets.emplace(ic->getDescriptionId(),
+                                                   addString(description))
+                        .first;
+            }
+
+            record.componentType = SnapshotType::IntegratedCircuit;
+            record.descriptionOffset = found->second;
+            record.descriptionLength = description.size();
+        } else {
+            record.componentType = SnapshotType::Diode;
+        }
+    }
+
+    // Stores the slots of the items in stock order and in the order of each
+    // sorted index
+    vector<uint32_t> stockOrder, priceOrder, resistanceOrder,
+            capacitanceOrder;
+    stockOrder.reserve(inv.getSize());
+    priceOrder.reserve(inv.getSize());
+
+    for (int i = 0; i < inv.getSize(); i++) {
+        stockOrder.push_back(inv[i]->getSlot());
+    }
+
+    inv.getPriceIndex().forEachAscending([&priceOrder](uint32_t slot) {
+        priceOrder.push_back(slot);
+        return true;
+    });
+
+    double infinity = numeric_limits<double>::infinity();
+
+    for (ComponentType componentType : {ComponentType::Resistor,
+                                        ComponentType::Capacitor}) {
+        vector<uint32_t> &order = componentType == ComponentType::Resistor
+                                  ? resistanceOrder : capacitanceOrder;
+
+        inv.getValueIndex(componentType).forEachInRange(
+                -infinity, infinity, [&order](uint32_t slot) {
+                    order.push_back(slot);
+                    return true;
+                });
+    }
+
+    const StockCodeTrie &codeTrie = inv.getCodeTrie();
+    string_view sections[SNAPSHOT_SECTION_COUNT] = {
+            asBytes(stockOrder), asBytes(priceOrder),
+            asBytes(resistanceOrder), asBytes(capacitanceOrder),
+            asBytes(codeTrie.getNodes()), codeTrie.getLabels()
+    };
+
+    SnapshotHeader header = {};
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    header.version = SNAPSHOT_VERSION;
+    header.recordSize = sizeof(SnapshotRecord);
+    header.itemCount = records.size();
+    header.stringTableOffset = sizeof(SnapshotHeader) +
+                               records.size() * sizeof(SnapshotRecord);
+    header.stringTableSize = stringTable.size();
+    header.trieNodeSize = sizeof(StockCodeTrie::Node);
+
+    // Sections follow the string table, each aligned
+    uint64_t position = header.stringTableOffset + header.stringTableSize;
+
+    for (size_t i = 0; i < SNAPSHOT_SECTION_COUNT; i++) {
+        position += (SECTION_ALIGNMENT - position % SECTION_ALIGNMENT) %
+                    SECTION_ALIGNMENT;
+        header.sectionOffsets[i] = position;
+        header.sectionSizes[i] = sections[i].size();
+        position += sections[i].size();
+    }
+
+    ofstream fileStream(file, ios::binary | ios::trunc);
+
+    fileStream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    fileStream.write(reinterpret_cast<const char *>(records.data()),
+                     records.size() * sizeof(SnapshotRecord));
+    fileStream.write(stringTable.data(), stringTable.size());
+
+    position = header.stringTableOffset + header.stringTableSize;
+
+    for (size_t i = 0; i < SNAPSHOT_SECTION_COUNT; i++) {
+        const char padding[SECTION_ALIGNMENT] = {};
+
+        fileStream.write(padding, header.sectionOffsets[i] - position);
+        fileStream.write(sections[i].data(), sections[i].size());
+        position = header.sectionOffsets[i] + sections[i].size();
+    }
+
+    fileStream.close();
+
+    if (!fileStream) {
+        cerr << "Unable to write file " << file << endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Reads and loads in an inventory from a snapshot file. No text is parsed,
+ * each item is built straight from its decoded record, and the stock order
+ * and indexes stored in the snapshot are restored rather than rebuilt
+ * (unless some records could not be loaded, which leaves them out of step).
+ *
+ * @param file              snapshot file to read in
+ * @return                  inventory object filled with data from file
+ */
+Inventory readInventorySnapshot(const string &file) {
+    Inventory inv;
+
+    InventorySnapshot snapshot(file);
+
+    if (!snapshot.isValid()) {
+        cerr << "Unable to read snapshot " << file << endl;
+        return inv;
+    }
+
+    // Items are created in an arena, then handed to the inventory together
+    ItemArena arena;
+    vector<StockItem *> items;
+    items.reserve(snapshot.getSize());
+
+    for (size_t i = 0; i < snapshot.getSize(); i++) {
+        const SnapshotRecord &record = snapshot[i];
+
+        try {
+            string_view code = snapshot.getStockCode(record);
+            StockItem *newItem;
+
+            // Creates a new stock item of the correct type
+            switch (record.componentType) {
+                case SnapshotType::Resistor:
+                    newItem = arena.create<Resistor>(
+                            code, record.stockAmount, record.unitPrice,
+                            record.value);
+                    break;
+                case SnapshotType::Capacitor:
+                    newItem = arena.create<Capacitor>(
+                            code, record.stockAmount, record.unitPrice,
+                            record.value);
+                    break;
+                case SnapshotType::Diode:
+                    newItem = arena.create<Diode>(
+                            code, record.stockAmount, record.unitPrice);
+                    break;
+                case SnapshotType::Transistor:
+                    newItem = arena.create<Transistor>(
+                            code, record.stockAmount, record.unitPrice,
+                            static_cast<DeviceType>(record.deviceType));
+                    break;
+                case SnapshotType::IntegratedCircuit:
+                    newItem = arena.create<IntegratedCircuit>(
+                            code, record.stockAmount, record.unitPrice,
+                            snapshot.getDescription(record));
+                    break;
+                default:
+                    throw invalid_argument("Invalid component in snapshot.");
+            }
+
+            items.push_back(newItem);
+
+        } catch (const exception &) {
+            cerr << "Failed to add item to inventory." << endl;
+        }
+    }
+
+    StoredIndexes indexes;
+
+    if (items.size() == snapshot.getSize()) {
+        indexes.stockOrder = readSection<uint32_t>(
+                snapshot, SnapshotSection::StockOrder);
+        indexes.priceOrder = readSection<uint32_t>(
+                snapshot, SnapshotSection::PriceOrder);
+        indexes.resistanceOrder = readSection<uint32_t>(
+                snapshot, SnapshotSection::ResistanceOrder);
+        indexes.capacitanceOrder = readSection<uint32_t>(
+                snapshot, SnapshotSection::CapacitanceOrder);
+        indexes.trieNodes = readSection<StockCodeTrie::Node>(
+                snapshot, SnapshotSection::TrieNodes);
+        indexes.trieLabels = string(
+                snapshot.getSection(SnapshotSection::TrieLabels));
+    }
+
+    // Adds the newly created items to inventory with their indexes
+    inv.restore(arena, items, move(indexes));
+
+    return inv;
+}
+
+/**
+ * Checks if a file is an inventory snapshot
+ *
+ * @param file              name of file to check
+ * @return                  true if the file is a valid snapshot
+ */
+bool isInventorySnapshot(const string &file) {
+    return InventorySnapshot(file).isValid();
+}
@@ -0,0 +1,160 @@
+/******************************************************************************
+ *
+ * File        : InventorySnapshot.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a binary snapshot of an inventory,
+ *               which can be mapped into memory and queried without parsing.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef INVENTORYSNAPSHOT_H
+#define INVENTORYSNAPSHOT_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "MappedFile.h"
+#include "Inventory.h"
+
+// Current version of the snapshot format, increased on any layout change
+const uint32_t SNAPSHOT_VERSION = 2;
+
+// Component types as stored in a snapshot (values must never change)
+enum class SnapshotType : uint8_t {
+    Resistor, Capacitor, Diode, Transistor, IntegratedCircuit
+};
+
+// Sections stored after the string table, holding the stock order and
+// indexes of the inventory so they are restored rather than rebuilt
+enum class SnapshotSection : uint32_t {
+    StockOrder, PriceOrder, ResistanceOrder, CapacitanceOrder, TrieNodes,
+    TrieLabels
+};
+
+// Amount of sections a snapshot can hold
+const size_t SNAPSHOT_SECTION_COUNT = 6;
+
+/**
+ * Header at the start of every snapshot file. Snapshots are written in the
+ * byte order of the machine that wrote them.
+ */
+struct SnapshotHeader {
+    // Identifies the file as a snapshot
+    char magic[8];
+
+    // Version of the format the snapshot was written with
+    uint32_t version;
+
+    // Size of each record, to detect layout mismatches
+    uint32_t recordSize;
+
+    // Amount of records following the header
+    uint64_t itemCount;
+
+    // Position and size of the string table in the file
+    uint64_t stringTableOffset;
+    uint64_t stringTableSize;
+
+    // Size of each node of the code trie, to detect layout mismatches
+    uint32_t trieNodeSize;
+
+    uint32_t reserved;
+
+    // Position and size of each section in the file (size 0 if missing)
+    uint64_t sectionOffsets[SNAPSHOT_SECTION_COUNT];
+    uint64_t sectionSizes[SNAPSHOT_SECTION_COUNT];
+};
+
+/**
+ * Fixed size record of a single stock item, with all attributes decoded.
+ * Records are stored in the order the items were added to the inventory,
+ * which the stored indexes refer to.
+ */
+struct SnapshotRecord {
+    // Component type of the item
+    SnapshotType componentType;
+
+    // Device type of a transistor (0 for other items)
+    uint8_t deviceType;
+
+    uint16_t reserved;
+
+    // Stock amount and unit price (in pence) of the item
+    int32_t stockAmount;
+    int32_t unitPrice;
+
+    // Position of the stock code in the string table
+    uint32_t codeOffset;
+    uint32_t codeLength;
+
+    // Position of an integrated circuit's description in the string table
+    uint32_t descriptionOffset;
+    uint32_t descriptionLength;
+
+    uint32_t padding;
+
+    // Resistance in ohms or capacitance in picofarads (0 for other items)
+    double value;
+};
+
+/**
+ * Models a snapshot file mapped into memory, giving direct access to its
+ * records
+ */
+class InventorySnapshot {
+private:
+    // Mapped snapshot file
+    MappedFile file;
+
+    // Header of snapshot (null if file is not a valid snapshot)
+    const SnapshotHeader *header;
+
+    // Records of each item
+    const SnapshotRecord *records;
+
+    // Strings referred to by the records
+    std::string_view stringTable;
+
+    // Contents of each section (empty if missing)
+    std::string_view sections[SNAPSHOT_SECTION_COUNT];
+
+    // Retrieves a string from the string table
+    std::string_view getString(uint32_t offset, uint32_t length) const;
+
+public:
+    // InventorySnapshot Constructor
+    explicit InventorySnapshot(const std::string &fileName);
+
+    // Checks if the file is a valid snapshot of this version
+    bool isValid() const;
+
+    // Retrieves the amount of items in the snapshot
+    size_t getSize() const;
+
+    // Allows for array like access to the records
+    const SnapshotRecord &operator[](size_t i) const;
+
+    // Retrieves the stock code of a record
+    std::string_view getStockCode(const SnapshotRecord &record) const;
+
+    // Retrieves the description of a record
+    std::string_view getDescription(const SnapshotRecord &record) const;
+
+    // Retrieves the contents of a section (empty if missing)
+    std::string_view getSection(SnapshotSection section) const;
+};
+
+// Writes an inventory to a snapshot file
+bool writeInventorySnapshot(Inventory &inv, const std::string &file);
+
+// Reads and loads in an inventory from a snapshot file
+Inventory readInventorySnapshot(const std::string &file);
+
+// Checks if a file is an inventory snapshot
+bool isInventorySnapshot(const std::string &file);
+
+#endif /* INVENTORYSNAPSHOT_H */
@@ -0,0 +1,258 @@
+/******************************************************************************
+ *
+ * File        : ItemArena.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define pooled, contiguous allocation of
+ *               stock items.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef ITEMARENA_H
+#define ITEMARENA_H
+
+#include <algorithm>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "StockItem.h"
+
+/**
+ * Allocates objects of one type contiguously in large blocks. Objects live
+ * until they are destroyed one at a time, when their storage is kept on a
+ * free list for the next object created, or until the pool is destroyed,
+ * when they are all destroyed and their blocks freed at once.
+ */
+template <typename T>
+class ObjectPool {
+private:
+    // Amount of objects stored in each block
+    static const size_t BLOCK_SIZE = 1024;
+
+    // A block of storage and the amount of objects constructed in it
+    struct Block {
+        T *objects;
+        size_t count;
+    };
+
+    // Blocks of objects, new objects are placed in the last block
+    std::vector<Block> blocks;
+
+    // Storage of objects destroyed one at a time, reused before the blocks
+    std::vector<T *> freeObjects;
+
+    // Destroys every object still alive and frees every block
+    void release() {
+        std::sort(this->freeObjects.begin(), this->freeObjects.end());
+
+        for (Block &block : this->blocks) {
+            if (!std::is_trivially_destructible<T>::value) {
+                for (size_t i = 0; i < block.count; i++) {
+                    if (!std::binary_search(this->freeObjects.begin(),
+                                            this->freeObjects.end(),
+                                            block.objects + i)) {
+                        block.objects[i].~T();
+                    }
+                }
+            }
+
+            ::operator delete(block.objects);
+        }
+
+        this->blocks.clear();
+        this->freeObjects.clear();
+    }
+
+public:
+    // ObjectPool Constructor
+    ObjectPool() {
+    }
+
+    // ObjectPool Destructor
+    ~ObjectPool() {
+        this->release();
+    }
+
+    // Pools own their objects, so cannot be copied
+    ObjectPool(const ObjectPool &pool) = delete;
+    ObjectPool &operator=(const ObjectPool &pool) = delete;
+
+    // ObjectPool Move Constructor
+    ObjectPool(ObjectPool &&pool) noexcept
+            : blocks(std::move(pool.blocks)),
+              freeObjects(std::move(pool.freeObjects)) {
+        pool.blocks.clear();
+        pool.freeObjects.clear();
+    }
+
+    // ObjectPool Move Assignment Operator Overload
+    ObjectPool &operator=(ObjectPool &&pool) noexcept {
+        if (this != &pool) {
+            this->release();
+            this->blocks = std::move(pool.blocks);
+            this->freeObjects = std::move(pool.freeObjects);
+            pool.blocks.clear();
+            pool.freeObjects.clear();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Constructs a new object in the pool
+     *
+     * @param args              arguments for the object's constructor
+     * @return                  pointer to the new object
+     */
+    template <typename... Args>
+    T *create(Args &&... args) {
+        // Reuses the storage of a destroyed object, only taking it off the
+        // free list once the constructor has succeeded
+        if (!this->freeObjects.empty()) {
+            T *object = new(this->freeObjects.back())
+                    T(std::forward<Args>(args)...);
+            this->freeObjects.pop_back();
+
+            return object;
+        }
+
+        if (this->blocks.empty() || this->blocks.back().count == BLOCK_SIZE) {
+            T *objects = static_cast<T *>(
+                    ::operator new(BLOCK_SIZE * sizeof(T)));
+            this->blocks.push_back({objects, 0});
+        }
+
+        // Only counts the object once its constructor has succeeded
+        Block &block = this->blocks.back();
+        T *object = new(block.objects + block.count)
+                T(std::forward<Args>(args)...);
+        block.count++;
+
+        return object;
+    }
+
+    /**
+     * Destroys an object of the pool, keeping its storage for reuse
+     *
+     * @param object            object to destroy
+     */
+    void destroy(T *object) {
+        object->~T();
+        this->freeObjects.push_back(object);
+    }
+
+    /**
+     * Moves all the objects of another pool into this pool
+     *
+     * @param pool              pool to take the objects of
+     */
+    void absorb(ObjectPool &pool) {
+        this->blocks.insert(this->blocks.end(), pool.blocks.begin(),
+                            pool.blocks.end());
+        this->freeObjects.insert(this->freeObjects.end(),
+                                 pool.freeObjects.begin(),
+                                 pool.freeObjects.end());
+        pool.blocks.clear();
+        pool.freeObjects.clear();
+    }
+};
+
+/**
+ * Allocates stock items in one object pool per type of item
+ */
+class ItemArena {
+private:
+    // Pools of each type of stock item
+    std::tuple<ObjectPool<Resistor>, ObjectPool<Capacitor>,
+            ObjectPool<Diode>, ObjectPool<Transistor>,
+            ObjectPool<IntegratedCircuit>> pools;
+
+public:
+    /**
+     * Constructs a new stock item in the pool for its type
+     *
+     * @param args              arguments for the item's constructor
+     * @return                  pointer to the new item
+     */
+    template <typename T, typename... Args>
+    T *create(Args &&... args) {
+        return std::get<ObjectPool<T>>(this->pools).create(
+                std::forward<Args>(args)...);
+    }
+
+    /**
+     * Constructs a copy of an item in the pool for its type
+     *
+     * @param item              item to copy
+     * @return                  pointer to the copy
+     */
+    StockItem *copy(const StockItem &item) {
+        switch (item.getType()) {
+            case ComponentType::Resistor:
+                return this->create<Resistor>(
+                        static_cast<const Resistor &>(item));
+            case ComponentType::Capacitor:
+                return this->create<Capacitor>(
+                        static_cast<const Capacitor &>(item));
+            case ComponentType::Diode:
+                return this->create<Diode>(static_cast<const Diode &>(item));
+            case ComponentType::Transistor:
+                return this->create<Transistor>(
+                        static_cast<const Transistor &>(item));
+            default:
+                return this->create<IntegratedCircuit>(
+                        static_cast<const IntegratedCircuit &>(item));
+        }
+    }
+
+    /**
+     * Destroys an item of the arena, keeping its storage for the next item
+     * of its type
+     *
+     * @param item              item to destroy
+     */
+    void destroy(StockItem *item) {
+        switch (item->getType()) {
+            case ComponentType::Resistor:
+                std::get<ObjectPool<Resistor>>(this->pools).destroy(
+                        static_cast<Resistor *>(item));
+                break;
+            case ComponentType::Capacitor:
+                std::get<ObjectPool<Capacitor>>(this->pools).destroy(
+                        static_cast<Capacitor *>(item));
+                break;
+            case ComponentType::Diode:
+                std::get<ObjectPool<Diode>>(this->pools).destroy(
+                        static_cast<Diode *>(item));
+                break;
+            case ComponentType::Transistor:
+                std::get<ObjectPool<Transistor>>(this->pools).destroy(
+                        static_cast<Transistor *>(item));
+                break;
+            default:
+                std::get<ObjectPool<IntegratedCircuit>>(this->pools).destroy(
+                        static_cast<IntegratedCircuit *>(item));
+                break;
+        }
+    }
+
+    /**
+     * Moves all the items of another arena into this arena
+     *
+     * @param arena             arena to take the items of
+     */
+    void absorb(ItemArena &arena) {
+        std::get<0>(this->pools).absorb(std::get<0>(arena.pools));
+        std::get<1>(this->pools).absorb(std::get<1>(arena.pools));
+        std::get<2>(this->pools).absorb(std::get<2>(arena.pools));
+        std::get<3>(this->pools).absorb(std::get<3>(arena.pools));
+        std::get<4>(this->pools).absorb(std::get<4>(arena.pools));
+    }
+};
+
+#endif /* ITEMARENA_H */
@@ -0,0 +1,116 @@
+/******************************************************************************
+ *
+ * File        : MappedFile.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a read only, memory mapped view of a file on
+ *               disk.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <fstream>
+#include <sstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+/**
+ * Opens and maps a file into memory
+ *
+ * @param fileName          name of file to map
+ */
+MappedFile::MappedFile(const string &fileName)
+        : data(nullptr), size(0), opened(false) {
+#ifdef _WIN32
+    ifstream fileStream(fileName, ios::binary);
+
+    if (fileStream) {
+        stringstream contents;
+        contents << fileStream.rdbuf();
+
+        this->buffer = contents.str();
+        this->data = this->buffer.data();
+        this->size = this->buffer.size();
+        this->opened = true;
+    }
+#else
+    int fd = open(fileName.c_str(), O_RDONLY);
+
+    if (fd >= 0) {
+        struct stat fileStats;
+
+        if (fstat(fd, &fileStats) == 0) {
+            this->size = fileStats.st_size;
+            this->opened = true;
+
+            // Empty files cannot be mapped, they simply have no contents
+            if (this->size > 0) {
+                void *mapping = mmap(nullptr, this->size, PROT_READ,
+                                     MAP_PRIVATE, fd, 0);
+
+                if (mapping != MAP_FAILED) {
+                    this->data = static_cast<const char *>(mapping);
+
+                    // Files are always parsed from front to back
+                    madvise(mapping, this->size, MADV_SEQUENTIAL);
+                } else {
+                    this->size = 0;
+                    this->opened = false;
+                }
+            }
+        }
+
+        // The mapping stays valid once the descriptor is closed
+        close(fd);
+    }
+#endif
+}
+
+/**
+ * Unmaps the file from memory
+ */
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (this->data != nullptr) {
+        munmap(const_cast<char *>(this->data), this->size);
+    }
+#endif
+}
+
+/**
+ * Checks if the file was opened and mapped successfully
+ *
+ * @return                  true if the file is open
+ */
+bool MappedFile::isOpen() const {
+    return this->opened;
+}
+
+/**
+ * Retrieves the contents of the file
+ *
+ * @return                  view over the whole file
+ */
+string_view MappedFile::getContents() const {
+    return string_view(this->data, this->size);
+}
+
+/**
+ * Retrieves the size of the file in bytes
+ *
+ * @return                  size of file
+ */
+size_t MappedFile::getSize() const {
+    return this->size;
+}
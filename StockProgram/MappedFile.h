@@ -0,0 +1,61 @@
+/******************************************************************************
+ *
+ * File        : MappedFile.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a read only, memory mapped view of a
+ *               file on disk.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <string>
+#include <string_view>
+
+/**
+ * Models a read only file mapped into memory, the contents of which can be
+ * sliced without copying
+ */
+class MappedFile {
+private:
+    // Start of the mapped contents
+    const char *data;
+
+    // Size of the mapped contents in bytes
+    size_t size;
+
+    // Whether the file could be opened
+    bool opened;
+
+#ifdef _WIN32
+    // Windows builds read the file into memory instead of mapping it
+    std::string buffer;
+#endif
+
+public:
+    // MappedFile Constructor
+    explicit MappedFile(const std::string &fileName);
+
+    // MappedFile Destructor
+    ~MappedFile();
+
+    // Mappings are unique, so cannot be copied
+    MappedFile(const MappedFile &file) = delete;
+    MappedFile &operator=(const MappedFile &file) = delete;
+
+    // Checks if the file was opened and mapped successfully
+    bool isOpen() const;
+
+    // Retrieves the contents of the file
+    std::string_view getContents() const;
+
+    // Retrieves the size of the file in bytes
+    size_t getSize() const;
+};
+
+#endif /* MAPPEDFILE_H */
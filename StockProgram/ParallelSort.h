@@ -0,0 +1,129 @@
+/******************************************************************************
+ *
+ * File        : ParallelSort.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define running tasks on several threads,
+ *               and a stable merge sort which sorts and merges runs of a
+ *               range on several threads.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Smallest run of elements worth sorting on its own thread
+const size_t MIN_SORT_RUN = 1 << 14;
+
+/**
+ * Runs a task for each index from 0 up to an amount of tasks, each on its
+ * own thread (the first on the calling thread), waiting for them all
+ *
+ * @param taskCount                 amount of tasks to run
+ * @param task                      task taking the index of the task
+ */
+inline void runInParallel(size_t taskCount,
+                          const std::function<void(size_t)> &task) {
+    std::vector<std::thread> workers;
+
+    for (size_t i = 1; i < taskCount; i++) {
+        workers.emplace_back(task, i);
+    }
+
+    if (taskCount > 0) {
+        task(0);
+    }
+
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+}
+
+/**
+ * Sorts a vector stably, sorting equal runs of it on separate threads and
+ * then merging neighbouring runs in rounds, each merge on its own thread.
+ * Merging only ever neighbouring runs, taking from the earlier run on ties,
+ * keeps elements that compare equal in their original order.
+ *
+ * @param elements                  elements to sort
+ * @param compare                   strict weak ordering of the elements
+ * @param threadCount               amount of threads to sort with, 0 uses
+ *                                  one per hardware thread
+ */
+template <typename T, typename Compare>
+void parallelStableSort(std::vector<T> &elements, Compare compare,
+                        unsigned int threadCount = 0) {
+    if (threadCount == 0) {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Never gives a thread less than a worthwhile run of the elements
+    size_t runCount = std::min<size_t>(threadCount,
+                                       elements.size() / MIN_SORT_RUN + 1);
+
+    if (runCount <= 1) {
+        std::stable_sort(elements.begin(), elements.end(), compare);
+        return;
+    }
+
+    // Bounds of each run, run i being [bounds[i], bounds[i + 1])
+    std::vector<size_t> bounds;
+    for (size_t i = 0; i <= runCount; i++) {
+        bounds.push_back(elements.size() * i / runCount);
+    }
+
+    runInParallel(runCount, [&elements, &bounds, &compare](size_t i) {
+        std::stable_sort(elements.begin() + bounds[i],
+                         elements.begin() + bounds[i + 1], compare);
+    });
+
+    // Merges pairs of neighbouring runs until a single run is left,
+    // alternating between the elements and a buffer
+    std::vector<T> buffer(elements.size());
+    std::vector<T> *source = &elements;
+    std::vector<T> *destination = &buffer;
+
+    while (bounds.size() > 2) {
+        size_t pairCount = bounds.size() / 2;
+
+        runInParallel(pairCount, [source, destination, &bounds, &compare](
+                size_t i) {
+            size_t first = bounds[2 * i];
+            size_t middle = bounds[std::min(2 * i + 1, bounds.size() - 1)];
+            size_t last = bounds[std::min(2 * i + 2, bounds.size() - 1)];
+
+            std::merge(std::make_move_iterator(source->begin() + first),
+                       std::make_move_iterator(source->begin() + middle),
+                       std::make_move_iterator(source->begin() + middle),
+                       std::make_move_iterator(source->begin() + last),
+                       destination->begin() + first, compare);
+        });
+
+        // Keeps the bounds of the merged runs
+        std::vector<size_t> mergedBounds;
+        for (size_t i = 0; i < bounds.size(); i += 2) {
+            mergedBounds.push_back(bounds[i]);
+        }
+        if (mergedBounds.back() != bounds.back()) {
+            mergedBounds.push_back(bounds.back());
+        }
+
+        bounds.swap(mergedBounds);
+        std::swap(source, destination);
+    }
+
+    if (source != &elements) {
+        elements.swap(*source);
+    }
+}
+
+#endif /* PARALLELSORT_H */
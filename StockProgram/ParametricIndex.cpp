@@ -0,0 +1,128 @@
+/******************************************************************************
+ *
+ * File        : ParametricIndex.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define an ordered index of stock items by a
+ *               parametric value, such as resistance or capacitance.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <cmath>
+#include "ParametricIndex.h"
+
+using namespace std;
+
+/**
+ * Adds an item to the index
+ *
+ * @param value                     value of the item
+ * @param slot                      slot of the item
+ */
+void ParametricIndex::insert(double value, uint32_t slot) {
+    this->entries.emplace(value, slot);
+}
+
+/**
+ * Removes an item from the index
+ *
+ * @param value                     value the item was indexed with
+ * @param slot                      slot of the item
+ */
+void ParametricIndex::erase(double value, uint32_t slot) {
+    this->entries.erase({value, slot});
+}
+
+/**
+ * Replaces the index with items already sorted by value then slot, which
+ * takes linear time as each item is added at the end
+ *
+ * @param sortedItems               (value, slot) of each item, in order
+ */
+void ParametricIndex::assign(
+        const vector<pair<double, uint32_t>> &sortedItems) {
+    this->entries.clear();
+
+    for (const pair<double, uint32_t> &item : sortedItems) {
+        this->entries.emplace_hint(this->entries.end(), item);
+    }
+}
+
+/**
+ * Moves every slot in the index to its new slot, once the items in other
+ * slots have been removed from it and the slots compacted. The new slots
+ * keep items of equal value in order, so the entries stay sorted.
+ *
+ * @param newSlots                  new slot of each old slot, in the same
+ *                                  order as the old slots
+ */
+void ParametricIndex::renumber(const vector<uint32_t> &newSlots) {
+    set<pair<double, uint32_t>> renumbered;
+
+    for (const pair<double, uint32_t> &entry : this->entries) {
+        renumbered.emplace_hint(renumbered.end(), entry.first,
+                                newSlots[entry.second]);
+    }
+
+    this->entries.swap(renumbered);
+}
+
+/**
+ * Removes every item from the index
+ */
+void ParametricIndex::clear() {
+    this->entries.clear();
+}
+
+/**
+ * Retrieves the amount of items in the index
+ *
+ * @return                          amount of items
+ */
+size_t ParametricIndex::getSize() const {
+    return this->entries.size();
+}
+
+/**
+ * Counts the items with values between two values (inclusive), stopping at a
+ * limit so that estimating a large range stays cheap
+ *
+ * @param lowValue                  lowest value to count
+ * @param highValue                 highest value to count
+ * @param limit                     most items to count
+ * @return                          amount of items in the range, at most the
+ *                                  limit
+ */
+size_t ParametricIndex::countRange(double lowValue, double highValue,
+                                   size_t limit) const {
+    size_t count = 0;
+
+    if (limit == 0) {
+        return 0;
+    }
+
+    this->forEachInRange(lowValue, highValue, [&count, limit](uint32_t) {
+        return ++count < limit;
+    });
+
+    return count;
+}
+
+/**
+ * How far apart two values are, as the logarithm of the ratio of the larger
+ * to the smaller. Zero (such as a 0R link) is only near itself.
+ *
+ * @param value1                    first value
+ * @param value2                    second value
+ * @return                          distance between the values
+ */
+double ParametricIndex::distance(double value1, double value2) {
+    if (value1 > 0 && value2 > 0) {
+        return fabs(log(value1 / value2));
+    }
+
+    return value1 == value2 ? 0 : numeric_limits<double>::infinity();
+}
@@ -0,0 +1,131 @@
+/******************************************************************************
+ *
+ * File        : ParametricIndex.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define an ordered index of stock items by
+ *               a parametric value, such as resistance or capacitance.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef PARAMETRICINDEX_H
+#define PARAMETRICINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <set>
+#include <utility>
+#include <vector>
+
+/**
+ * Keeps the slots of stock items ordered by a parametric value (items of
+ * equal value are ordered by slot), answering range queries in logarithmic
+ * time plus the amount of matches, and finding the items nearest a value.
+ */
+class ParametricIndex {
+private:
+    // Value and slot of each item, in order
+    std::set<std::pair<double, uint32_t>> entries;
+
+    // How far apart two values are, as a ratio (for positive values)
+    static double distance(double value1, double value2);
+
+public:
+    // Adds an item to the index
+    void insert(double value, uint32_t slot);
+
+    // Removes an item from the index
+    void erase(double value, uint32_t slot);
+
+    // Replaces the index with items already sorted by (value, slot)
+    void assign(const std::vector<std::pair<double, uint32_t>> &sortedItems);
+
+    // Moves every slot to its new slot after others were removed, the new
+    // slots keeping the order of the old
+    void renumber(const std::vector<uint32_t> &newSlots);
+
+    // Removes every item from the index
+    void clear();
+
+    // Retrieves the amount of items in the index
+    size_t getSize() const;
+
+    // Counts the items with values in a range (inclusive), up to a limit
+    size_t countRange(double lowValue, double highValue,
+                      size_t limit = std::numeric_limits<size_t>::max())
+            const;
+
+    /**
+     * Visits the slot of each item with a value in a range (inclusive) in
+     * order of increasing value, until the visitor returns false
+     *
+     * @param lowValue              lowest value to visit
+     * @param highValue             highest value to visit
+     * @param visitor               function taking a slot, returning true to
+     *                              keep visiting
+     */
+    template <typename Visitor>
+    void forEachInRange(double lowValue, double highValue,
+                        Visitor visitor) const {
+        for (auto entry = this->entries.lower_bound({lowValue, 0});
+             entry != this->entries.end() && entry->first <= highValue;
+             ++entry) {
+            if (!visitor(entry->second)) {
+                return;
+            }
+        }
+    }
+
+    /**
+     * Finds the accepted item with the value nearest a value. Values are
+     * compared by ratio, the scale preferred value series (E12, E24, ...)
+     * are spaced on, so 9K1 is nearer 10K than 11K is. Searches outwards
+     * from the value in both directions, skipping items not accepted.
+     *
+     * @param value                 value to find the nearest item to
+     * @param accept                function taking a slot, returning true if
+     *                              the item can be chosen
+     * @param slot                  set to the slot of the nearest item
+     * @return                      false if no item is accepted
+     */
+    template <typename Acceptor>
+    bool findNearest(double value, Acceptor accept, uint32_t &slot) const {
+        auto above = this->entries.lower_bound({value, 0});
+        auto below = above;
+
+        while (above != this->entries.end() && !accept(above->second)) {
+            ++above;
+        }
+
+        bool foundBelow = false;
+        while (below != this->entries.begin()) {
+            --below;
+
+            if (accept(below->second)) {
+                foundBelow = true;
+                break;
+            }
+        }
+
+        bool foundAbove = above != this->entries.end();
+
+        // Prefers the lower value when both are as near
+        if (foundBelow && (!foundAbove ||
+                           distance(below->first, value) <=
+                           distance(above->first, value))) {
+            slot = below->second;
+            return true;
+        } else if (foundAbove) {
+            slot = above->second;
+            return true;
+        }
+
+        return false;
+    }
+};
+
+#endif /* PARAMETRICINDEX_H */
@@ -0,0 +1,322 @@
+/******************************************************************************
+ *
+ * File        : PriceIndex.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define an ordered index of stock items by their
+ *               unit price.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include "PriceIndex.h"
+
+using namespace std;
+
+/**
+ * Constructs an empty index
+ */
+PriceIndex::PriceIndex() : root(NONE), seed(2463534242u) {
+}
+
+/**
+ * Adds an item to the index
+ *
+ * @param price                     unit price of item
+ * @param slot                      slot of item
+ */
+void PriceIndex::insert(int price, uint32_t slot) {
+    int32_t before, after;
+    this->split(this->root, price, slot, before, after);
+
+    this->root = this->merge(this->merge(before, this->createNode(price, slot)),
+                             after);
+}
+
+/**
+ * Removes an item from the index
+ *
+ * @param price                     unit price of item when it was added
+ * @param slot                      slot of item
+ */
+void PriceIndex::erase(int price, uint32_t slot) {
+    int32_t before, rest, after;
+    this->split(this->root, price, slot, before, rest);
+
+    // Splits off the item itself, the only node ordered before the next slot
+    int32_t found;
+    this->split(rest, price, slot + 1, found, after);
+
+    if (found != NONE) {
+        this->freeNodes.push_back(found);
+    }
+
+    this->root = this->merge(before, after);
+}
+
+/**
+ * Replaces the index with items already sorted by (price, slot), building
+ * the treap in linear time
+ *
+ * @param sortedItems               (price, slot) of each item in order
+ */
+void PriceIndex::assign(const vector<pair<int, uint32_t>> &sortedItems) {
+    this->clear();
+    this->nodes.reserve(sortedItems.size());
+
+    // Builds the treap left to right, keeping the nodes along its right spine
+    vector<int32_t> rightSpine;
+
+    for (const pair<int, uint32_t> &item : sortedItems) {
+        int32_t node = this->createNode(item.first, item.second);
+        int32_t lastPopped = NONE;
+
+        while (!rightSpine.empty() &&
+               this->nodes[rightSpine.back()].priority <
+               this->nodes[node].priority) {
+            lastPopped = rightSpine.back();
+            rightSpine.pop_back();
+            this->resize(lastPopped);
+        }
+
+        this->nodes[node].left = lastPopped;
+
+        if (!rightSpine.empty()) {
+            this->nodes[rightSpine.back()].right = node;
+        }
+
+        rightSpine.push_back(node);
+    }
+
+    // Nodes left on the spine are resized from the bottom up
+    while (!rightSpine.empty()) {
+        this->resize(rightSpine.back());
+        this->root = rightSpine.back();
+        rightSpine.pop_back();
+    }
+}
+
+/**
+ * Moves every slot in the index to its new slot, once the items in other
+ * slots have been removed from it and the slots compacted. The new slots
+ * keep items of equal price in order, so the treap keeps its shape.
+ *
+ * @param newSlots                  new slot of each old slot, in the same
+ *                                  order as the old slots
+ */
+void PriceIndex::renumber(const vector<uint32_t> &newSlots) {
+    // Visits the nodes in the treap, as nodes reused later hold old slots
+    vector<int32_t> pending;
+
+    if (this->root != NONE) {
+        pending.push_back(this->root);
+    }
+
+    while (!pending.empty()) {
+        Node &node = this->nodes[pending.back()];
+        pending.pop_back();
+        node.slot = newSlots[node.slot];
+
+        if (node.left != NONE) {
+            pending.push_back(node.left);
+        }
+
+        if (node.right != NONE) {
+            pending.push_back(node.right);
+        }
+    }
+}
+
+/**
+ * Removes every item from the index
+ */
+void PriceIndex::clear() {
+    this->nodes.clear();
+    this->freeNodes.clear();
+    this->root = NONE;
+}
+
+/**
+ * Retrieves the amount of items in the index
+ *
+ * @return                          amount of items
+ */
+size_t PriceIndex::getSize() const {
+    return this->sizeOf(this->root);
+}
+
+/**
+ * Counts the items priced above a price
+ *
+ * @param price                     price to count items above
+ * @return                          amount of items priced above
+ */
+size_t PriceIndex::countAbove(int price) const {
+    if (price == INT32_MAX) {
+        return 0;
+    }
+
+    return this->getSize() - this->countBefore(price + 1, 0);
+}
+
+/**
+ * Counts the items priced between two prices (inclusive)
+ *
+ * @param lowPrice                  lowest price to count
+ * @param highPrice                 highest price to count
+ * @return                          amount of items in range
+ */
+size_t PriceIndex::countRange(int lowPrice, int highPrice) const {
+    if (lowPrice > highPrice) {
+        return 0;
+    }
+
+    size_t upToHigh = highPrice == INT32_MAX
+                      ? this->getSize() : this->countBefore(highPrice + 1, 0);
+
+    return upToHigh - this->countBefore(lowPrice, 0);
+}
+
+/**
+ * Creates a new node, reusing a removed node if there is one
+ *
+ * @param price                     unit price of item
+ * @param slot                      slot of item
+ * @return                          new node
+ */
+int32_t PriceIndex::createNode(int price, uint32_t slot) {
+    Node node = {price, slot, this->nextPriority(), 1, NONE, NONE};
+
+    if (!this->freeNodes.empty()) {
+        int32_t reused = this->freeNodes.back();
+        this->freeNodes.pop_back();
+        this->nodes[reused] = node;
+
+        return reused;
+    }
+
+    this->nodes.push_back(node);
+
+    return this->nodes.size() - 1;
+}
+
+/**
+ * Generates a random node priority (xorshift)
+ *
+ * @return                          random priority
+ */
+uint32_t PriceIndex::nextPriority() {
+    this->seed ^= this->seed << 13;
+    this->seed ^= this->seed >> 17;
+    this->seed ^= this->seed << 5;
+
+    return this->seed;
+}
+
+/**
+ * Retrieves the size of a subtree
+ *
+ * @param node                      root of subtree
+ * @return                          amount of nodes in subtree
+ */
+uint32_t PriceIndex::sizeOf(int32_t node) const {
+    return node == NONE ? 0 : this->nodes[node].size;
+}
+
+/**
+ * Recalculates the size of a node's subtree from its children
+ *
+ * @param node                      node to resize
+ */
+void PriceIndex::resize(int32_t node) {
+    Node &current = this->nodes[node];
+    current.size = 1 + this->sizeOf(current.left) + this->sizeOf(current.right);
+}
+
+/**
+ * Splits a treap into the nodes ordered before (price, slot) and the rest
+ *
+ * @param node                      root of treap to split
+ * @param price                     price of key to split at
+ * @param slot                      slot of key to split at
+ * @param before                    set to the treap of nodes before the key
+ * @param after                     set to the treap of the remaining nodes
+ */
+void PriceIndex::split(int32_t node, int price, uint32_t slot,
+                       int32_t &before, int32_t &after) {
+    if (node == NONE) {
+        before = after = NONE;
+        return;
+    }
+
+    Node &current = this->nodes[node];
+
+    if (current.price < price ||
+        (current.price == price && current.slot < slot)) {
+        this->split(current.right, price, slot, current.right, after);
+        before = node;
+    } else {
+        this->split(current.left, price, slot, before, current.left);
+        after = node;
+    }
+
+    this->resize(node);
+}
+
+/**
+ * Joins two treaps, where every node of the first is ordered before every
+ * node of the second
+ *
+ * @param before                    root of first treap
+ * @param after                     root of second treap
+ * @return                          root of joined treap
+ */
+int32_t PriceIndex::merge(int32_t before, int32_t after) {
+    if (before == NONE) {
+        return after;
+    } else if (after == NONE) {
+        return before;
+    }
+
+    if (this->nodes[before].priority > this->nodes[after].priority) {
+        this->nodes[before].right = this->merge(this->nodes[before].right,
+                                                after);
+        this->resize(before);
+
+        return before;
+    } else {
+        this->nodes[after].left = this->merge(before,
+                                              this->nodes[after].left);
+        this->resize(after);
+
+        return after;
+    }
+}
+
+/**
+ * Counts the nodes ordered before (price, slot)
+ *
+ * @param price                     price of key
+ * @param slot                      slot of key
+ * @return                          amount of nodes before key
+ */
+size_t PriceIndex::countBefore(int price, uint32_t slot) const {
+    size_t count = 0;
+    int32_t node = this->root;
+
+    while (node != NONE) {
+        const Node &current = this->nodes[node];
+
+        if (current.price < price ||
+            (current.price == price && current.slot < slot)) {
+            count += 1 + this->sizeOf(current.left);
+            node = current.right;
+        } else {
+            node = current.left;
+        }
+    }
+
+    return count;
+}
@@ -0,0 +1,252 @@
+/******************************************************************************
+ *
+ * File        : PriceIndex.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define an ordered index of stock items by
+ *               their unit price.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef PRICEINDEX_H
+#define PRICEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * Keeps the slots of stock items ordered by unit price (items of equal price
+ * are ordered by slot, the order they were added). Stored as a treap whose
+ * nodes count the size of their subtree, so that counting the items in any
+ * price range takes logarithmic time.
+ */
+class PriceIndex {
+private:
+    // Marks the absence of a node
+    static const int32_t NONE = -1;
+
+    // A node of the treap
+    struct Node {
+        int price;
+        uint32_t slot;
+
+        // Random priority, parents always have a higher priority
+        uint32_t priority;
+
+        // Amount of nodes in the subtree rooted at this node
+        uint32_t size;
+
+        int32_t left;
+        int32_t right;
+    };
+
+    // Nodes of the treap
+    std::vector<Node> nodes;
+
+    // Nodes no longer in the treap, to be reused
+    std::vector<int32_t> freeNodes;
+
+    // Root node of the treap
+    int32_t root;
+
+    // State of the generator of node priorities
+    uint32_t seed;
+
+    // Creates a new node
+    int32_t createNode(int price, uint32_t slot);
+
+    // Generates a random node priority
+    uint32_t nextPriority();
+
+    // Retrieves the size of a subtree
+    uint32_t sizeOf(int32_t node) const;
+
+    // Recalculates the size of a node from its children
+    void resize(int32_t node);
+
+    // Splits a treap into nodes ordered before a key and the rest
+    void split(int32_t node, int price, uint32_t slot, int32_t &before,
+               int32_t &after);
+
+    // Joins two treaps, where every node of the first is before the second
+    int32_t merge(int32_t before, int32_t after);
+
+    // Counts the nodes ordered before a key
+    size_t countBefore(int price, uint32_t slot) const;
+
+    // Visits nodes from a key onwards in ascending order
+    template <typename Visitor>
+    bool visitAscending(int32_t node, int fromPrice, Visitor &visitor) const;
+
+    // Visits nodes up to a key in descending order
+    template <typename Visitor>
+    bool visitDescending(int32_t node, int toPrice, Visitor &visitor) const;
+
+public:
+    // PriceIndex Constructor
+    PriceIndex();
+
+    // Adds an item to the index
+    void insert(int price, uint32_t slot);
+
+    // Removes an item from the index
+    void erase(int price, uint32_t slot);
+
+    // Replaces the index with items already in (price, slot) order
+    void assign(const std::vector<std::pair<int, uint32_t>> &sortedItems);
+
+    // Moves every slot to its new slot after others were removed, the new
+    // slots keeping the order of the old
+    void renumber(const std::vector<uint32_t> &newSlots);
+
+    // Removes every item from the index
+    void clear();
+
+    // Retrieves the amount of items in the index
+    size_t getSize() const;
+
+    // Counts the items priced above a price
+    size_t countAbove(int price) const;
+
+    // Counts the items priced between two prices (inclusive)
+    size_t countRange(int lowPrice, int highPrice) const;
+
+    /**
+     * Visits the slot of each item priced between two prices (inclusive)
+     * in order of increasing price, until the visitor returns false
+     *
+     * @param lowPrice              lowest price to visit
+     * @param highPrice             highest price to visit
+     * @param visitor               function taking a slot, returning true to
+     *                              keep visiting
+     */
+    template <typename Visitor>
+    void forEachInRange(int lowPrice, int highPrice, Visitor visitor) const {
+        auto rangeVisitor = [highPrice, &visitor](int price, uint32_t slot) {
+            return price <= highPrice && visitor(slot);
+        };
+
+        this->visitAscending(this->root, lowPrice, rangeVisitor);
+    }
+
+    /**
+     * Visits the slot of every item in order of increasing price, until the
+     * visitor returns false
+     *
+     * @param visitor               function taking a slot, returning true to
+     *                              keep visiting
+     */
+    template <typename Visitor>
+    void forEachAscending(Visitor visitor) const {
+        auto slotVisitor = [&visitor](int price, uint32_t slot) {
+            return visitor(slot);
+        };
+
+        this->visitAscending(this->root, INT32_MIN, slotVisitor);
+    }
+
+    /**
+     * Visits the slot of every item in order of decreasing price (items of
+     * equal price are still visited in the order they were added), until the
+     * visitor returns false
+     *
+     * @param visitor               function taking a slot, returning true to
+     *                              keep visiting
+     */
+    template <typename Visitor>
+    void forEachDescending(Visitor visitor) const {
+        // Collects a run of equal prices so it can be visited in slot order
+        std::vector<uint32_t> equalSlots;
+        int runPrice = 0;
+        bool visiting = true;
+
+        auto flush = [&equalSlots, &visitor, &visiting]() {
+            for (auto slot = equalSlots.rbegin();
+                 visiting && slot != equalSlots.rend(); slot++) {
+                visiting = visitor(*slot);
+            }
+            equalSlots.clear();
+        };
+
+        auto slotVisitor = [&](int price, uint32_t slot) {
+            if (!equalSlots.empty() && price != runPrice) {
+                flush();
+            }
+
+            runPrice = price;
+            equalSlots.push_back(slot);
+
+            return visiting;
+        };
+
+        this->visitDescending(this->root, INT32_MAX, slotVisitor);
+        flush();
+    }
+};
+
+/**
+ * Visits nodes of a subtree with a price of at least fromPrice, in ascending
+ * order
+ *
+ * @param node                  root of subtree
+ * @param fromPrice             lowest price to visit
+ * @param visitor               function taking a price and slot, returning
+ *                              true to keep visiting
+ * @return                      false once the visitor has stopped
+ */
+template <typename Visitor>
+bool PriceIndex::visitAscending(int32_t node, int fromPrice,
+                                Visitor &visitor) const {
+    while (node != NONE) {
+        const Node &current = this->nodes[node];
+
+        // Skips the left subtree when it is entirely below the range
+        if (current.price >= fromPrice) {
+            if (!this->visitAscending(current.left, fromPrice, visitor) ||
+                !visitor(current.price, current.slot)) {
+                return false;
+            }
+        }
+
+        node = current.right;
+    }
+
+    return true;
+}
+
+/**
+ * Visits nodes of a subtree with a price of at most toPrice, in descending
+ * order
+ *
+ * @param node                  root of subtree
+ * @param toPrice               highest price to visit
+ * @param visitor               function taking a price and slot, returning
+ *                              true to keep visiting
+ * @return                      false once the visitor has stopped
+ */
+template <typename Visitor>
+bool PriceIndex::visitDescending(int32_t node, int toPrice,
+                                 Visitor &visitor) const {
+    while (node != NONE) {
+        const Node &current = this->nodes[node];
+
+        // Skips the right subtree when it is entirely above the range
+        if (current.price <= toPrice) {
+            if (!this->visitDescending(current.right, toPrice, visitor) ||
+                !visitor(current.price, current.slot)) {
+                return false;
+            }
+        }
+
+        node = current.left;
+    }
+
+    return true;
+}
+
+#endif /* PRICEINDEX_H */
@@ -0,0 +1,786 @@
+/******************************************************************************
+ *
+ * File        : Query.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define queries over an inventory, and the planner
+ *               which pushes their predicates down to the inventory's indexes.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include "Query.h"
+
+using namespace std;
+
+// Names of the query fields, in the order of the enum
+static const string FIELD_NAMES[] = {"type", "code", "amount", "price",
+                                     "resistance", "capacitance", "device",
+                                     "description"};
+
+// Names of the aggregates, in the order of the enum
+static const string AGGREGATE_NAMES[] = {"none", "count", "sum", "min",
+                                         "max", "avg"};
+
+/**
+ * Retrieves the name of a query field
+ *
+ * @param field                     query field to name
+ * @return                          name of the query field
+ */
+const string &queryFieldName(QueryField field) {
+    return FIELD_NAMES[static_cast<int>(field)];
+}
+
+/**
+ * Finds the query field with a name
+ *
+ * @param name                      name of the query field
+ * @param field                     set to the matching query field
+ * @return                          true if a query field has the name
+ */
+bool queryFieldNamed(string_view name, QueryField &field) {
+    for (int i = 0; i <= static_cast<int>(QueryField::Description); i++) {
+        if (FIELD_NAMES[i] == name) {
+            field = static_cast<QueryField>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Checks whether a query field holds a number
+ *
+ * @param field                     query field to check
+ * @return                          true if the field is numeric
+ */
+static bool isNumeric(QueryField field) {
+    return field == QueryField::StockAmount ||
+           field == QueryField::UnitPrice ||
+           field == QueryField::Resistance ||
+           field == QueryField::Capacitance;
+}
+
+/**
+ * Finds the component type an attribute belongs to, if only one type has it
+ *
+ * @param field                     query field of the attribute
+ * @param componentType             set to the type having the attribute
+ * @return                          true if only one type has the attribute
+ */
+static bool impliedComponentType(QueryField field,
+                                 ComponentType &componentType) {
+    switch (field) {
+        case QueryField::Resistance:
+            componentType = ComponentType::Resistor;
+            return true;
+        case QueryField::Capacitance:
+            componentType = ComponentType::Capacitor;
+            return true;
+        case QueryField::DeviceType:
+            componentType = ComponentType::Transistor;
+            return true;
+        case QueryField::Description:
+            componentType = ComponentType::IntegratedCircuit;
+            return true;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Compares two values
+ *
+ * @param value                     value of the item's attribute
+ * @param comparison                comparison to make
+ * @param target                    value compared against
+ * @return                          true if the comparison holds
+ */
+template <typename T>
+static bool compare(const T &value, Comparison comparison, const T &target) {
+    switch (comparison) {
+        case Comparison::Equal:
+            return value == target;
+        case Comparison::NotEqual:
+            return value != target;
+        case Comparison::Less:
+            return value < target;
+        case Comparison::LessEqual:
+            return value <= target;
+        case Comparison::Greater:
+            return value > target;
+        case Comparison::GreaterEqual:
+            return value >= target;
+        default:
+            return false;
+    }
+}
+
+/**
+ * Formats a number, without a fractional part if it is a whole number and
+ * to two decimal places if not
+ *
+ * @param number                    number to format
+ * @return                          formatted number
+ */
+static string formatNumber(double number) {
+    ostringstream stream;
+
+    if (number == floor(number) && fabs(number) < 1.0E15) {
+        stream << static_cast<long long>(number);
+    } else {
+        stream << fixed << setprecision(2) << number;
+    }
+
+    return stream.str();
+}
+
+/**
+ * Describes the plan in a line of text
+ *
+ * @return                          description of the plan
+ */
+string QueryPlan::describe() const {
+    ostringstream description;
+
+    switch (this->accessPath) {
+        case AccessPath::FullScan:
+            description << "full scan";
+            break;
+        case AccessPath::TypePartition:
+            description << "type partition "
+                        << componentTypeName(this->componentType);
+            break;
+        case AccessPath::PriceRange:
+            description << "price index [" << this->minPrice << ", "
+                        << this->maxPrice << "]";
+            break;
+        case AccessPath::ValueRange:
+            description << (this->componentType == ComponentType::Resistor
+                            ? "resistance" : "capacitance")
+                        << " index [" << formatNumber(this->minValue) << ", "
+                        << formatNumber(this->maxValue) << "]";
+            break;
+        case AccessPath::CodeLookup:
+            description << "code index " << this->stockCode;
+            break;
+        case AccessPath::DescriptionText:
+            description << "description index \"" << this->descriptionText
+                        << "\"";
+            break;
+    }
+
+    description << " (" << this->estimatedRows << " rows)";
+
+    return description.str();
+}
+
+/**
+ * Constructs a query matching every item, with no aggregate
+ */
+Query::Query() : aggregateType(Aggregate::None),
+                 aggregateField(QueryField::UnitPrice) {
+}
+
+/**
+ * Adds a predicate comparing a numeric attribute against a value
+ *
+ * @param field                     numeric attribute to compare
+ * @param comparison                comparison to make
+ * @param value                     value to compare against
+ * @return                          this query
+ */
+Query &Query::where(QueryField field, Comparison comparison, double value) {
+    if (!isNumeric(field)) {
+        throw invalid_argument("Field " + queryFieldName(field) +
+                               " is not numeric.");
+    }
+
+    if (comparison == Comparison::Contains) {
+        throw invalid_argument("Field " + queryFieldName(field) +
+                               " cannot contain a value.");
+    }
+
+    this->predicates.push_back({field, comparison, value, ""});
+
+    return *this;
+}
+
+/**
+ * Adds a predicate comparing a text attribute against a value. Component and
+ * device types are given by name and can only be compared for equality, and
+ * numeric attributes are given as a number (or as a part code for
+ * resistances and capacitances).
+ *
+ * @param field                     attribute to compare
+ * @param comparison                comparison to make
+ * @param value                     value to compare against
+ * @return                          this query
+ */
+Query &Query::where(QueryField field, Comparison comparison,
+                    const string &value) {
+    if (isNumeric(field)) {
+        size_t length = 0;
+        double number = 0;
+
+        try {
+            number = stod(value, &length);
+        } catch (const logic_error &) {
+            length = 0;
+        }
+
+        // Resistances and capacitances can also be given as part codes
+        // (such as 4K7 or 100nF)
+        if (length != value.size() && (field == QueryField::Resistance ||
+                                       field == QueryField::Capacitance)) {
+            try {
+                number = field == QueryField::Resistance
+                         ? Resistor::calculateResistance(value)
+                         : Capacitor::convertToPicoFarads(value);
+                length = value.size();
+            } catch (const logic_error &) {
+                length = 0;
+            }
+        }
+
+        if (length == 0 || length != value.size()) {
+            throw invalid_argument("Invalid number " + value + " for field " +
+                                   queryFieldName(field) + ".");
+        }
+
+        return this->where(field, comparison, number);
+    }
+
+    Predicate predicate = {field, comparison, 0, value};
+
+    if (field == QueryField::ComponentType ||
+        field == QueryField::DeviceType) {
+        if (comparison != Comparison::Equal &&
+            comparison != Comparison::NotEqual) {
+            throw invalid_argument("Field " + queryFieldName(field) +
+                                   " can only be compared for equality.");
+        }
+
+        if (field == QueryField::ComponentType) {
+            ComponentType componentType;
+
+            if (!componentTypeNamed(value, componentType)) {
+                throw invalid_argument("Invalid component type " + value +
+                                       ".");
+            }
+
+            predicate.number = static_cast<int>(componentType);
+        } else {
+            predicate.number = static_cast<int>(
+                    Transistor::parseDeviceType(value));
+        }
+    }
+
+    this->predicates.push_back(predicate);
+
+    return *this;
+}
+
+/**
+ * Sets the attributes to print for each matching item
+ *
+ * @param fields                    attributes to print, in order
+ * @return                          this query
+ */
+Query &Query::select(const vector<QueryField> &fields) {
+    this->projection = fields;
+
+    return *this;
+}
+
+/**
+ * Sets the aggregate to compute over the matching items. Aggregates other
+ * than a count are of a numeric attribute, and skip items without it.
+ *
+ * @param type                      aggregate to compute
+ * @param field                     numeric attribute to aggregate
+ * @return                          this query
+ */
+Query &Query::aggregate(Aggregate type, QueryField field) {
+    if (type != Aggregate::None && type != Aggregate::Count &&
+        !isNumeric(field)) {
+        throw invalid_argument("Field " + queryFieldName(field) +
+                               " is not numeric.");
+    }
+
+    this->aggregateType = type;
+    this->aggregateField = field;
+
+    return *this;
+}
+
+/**
+ * Retrieves the predicates of the query
+ *
+ * @return                          predicates every matching item satisfies
+ */
+const vector<Predicate> &Query::getPredicates() const {
+    return this->predicates;
+}
+
+/**
+ * Plans how to find the items matching the query, by pushing predicates down
+ * to each index that can answer them and picking the index that reads the
+ * fewest candidate items. Counts come from the indexes themselves: the size
+ * of a type's partition and the count of a price, resistance or capacitance
+ * range.
+ *
+ * @param inv                       inventory the query will be run against
+ * @return                          plan for the query
+ */
+QueryPlan Query::plan(const Inventory &inv) const {
+    QueryPlan queryPlan;
+    queryPlan.accessPath = AccessPath::FullScan;
+    queryPlan.componentType = ComponentType::Resistor;
+    queryPlan.minPrice = numeric_limits<int>::min();
+    queryPlan.maxPrice = numeric_limits<int>::max();
+    queryPlan.minValue = -numeric_limits<double>::infinity();
+    queryPlan.maxValue = numeric_limits<double>::infinity();
+    queryPlan.estimatedRows = inv.getSize();
+
+    // Range of prices allowed by every price predicate
+    double minPrice = numeric_limits<int>::min();
+    double maxPrice = numeric_limits<int>::max();
+    bool pricePredicate = false;
+
+    // Ranges of resistance and capacitance allowed by their predicates
+    ComponentType valueTypes[] = {ComponentType::Resistor,
+                                  ComponentType::Capacitor};
+    double minValues[] = {queryPlan.minValue, queryPlan.minValue};
+    double maxValues[] = {queryPlan.maxValue, queryPlan.maxValue};
+    bool valuePredicates[] = {false, false};
+
+    // Longest text a description must contain, as the rarest to find
+    string descriptionText;
+
+    for (const Predicate &predicate : this->predicates) {
+        // Component type every result must have, if the predicate gives one
+        ComponentType componentType = ComponentType::Resistor;
+        bool typed = false;
+
+        if (predicate.field == QueryField::StockCode &&
+            predicate.comparison == Comparison::Equal &&
+            !inv.hasDuplicateCodes()) {
+            // Codes are unique, so the code index finds the only candidate
+            queryPlan.accessPath = AccessPath::CodeLookup;
+            queryPlan.stockCode = predicate.text;
+            queryPlan.estimatedRows = inv.find(predicate.text) ? 1 : 0;
+
+            return queryPlan;
+        } else if (predicate.field == QueryField::UnitPrice) {
+            double price = predicate.number;
+            pricePredicate |= predicate.comparison != Comparison::NotEqual;
+
+            switch (predicate.comparison) {
+                case Comparison::Equal:
+                    minPrice = max(minPrice, ceil(price));
+                    maxPrice = min(maxPrice, floor(price));
+                    break;
+                case Comparison::Less:
+                    maxPrice = min(maxPrice, ceil(price) - 1);
+                    break;
+                case Comparison::LessEqual:
+                    maxPrice = min(maxPrice, floor(price));
+                    break;
+                case Comparison::Greater:
+                    minPrice = max(minPrice, floor(price) + 1);
+                    break;
+                case Comparison::GreaterEqual:
+                    minPrice = max(minPrice, ceil(price));
+                    break;
+                default:
+                    break;
+            }
+        } else if (predicate.field == QueryField::ComponentType &&
+                   predicate.comparison == Comparison::Equal) {
+            componentType = static_cast<ComponentType>(
+                    static_cast<int>(predicate.number));
+            typed = true;
+        } else {
+            typed = impliedComponentType(predicate.field, componentType);
+        }
+
+        // Scans only the partition of that type, if it is the smallest
+        // access path yet
+        if (typed) {
+            size_t partitionSize = inv.search(componentType).size();
+
+            if (partitionSize < queryPlan.estimatedRows) {
+                queryPlan.accessPath = AccessPath::TypePartition;
+                queryPlan.componentType = componentType;
+                queryPlan.estimatedRows = partitionSize;
+            }
+        }
+
+        if (predicate.field == QueryField::Description &&
+            predicate.comparison == Comparison::Contains &&
+            predicate.text.size() > descriptionText.size()) {
+            descriptionText = predicate.text;
+        }
+
+        if ((predicate.field == QueryField::Resistance ||
+             predicate.field == QueryField::Capacitance) &&
+            predicate.comparison != Comparison::NotEqual) {
+            int i = predicate.field == QueryField::Resistance ? 0 : 1;
+            double value = predicate.number;
+            double infinity = numeric_limits<double>::infinity();
+            valuePredicates[i] = true;
+
+            switch (predicate.comparison) {
+                case Comparison::Equal:
+                    minValues[i] = max(minValues[i], value);
+                    maxValues[i] = min(maxValues[i], value);
+                    break;
+                case Comparison::Less:
+                    maxValues[i] = min(maxValues[i],
+                                       nextafter(value, -infinity));
+                    break;
+                case Comparison::LessEqual:
+                    maxValues[i] = min(maxValues[i], value);
+                    break;
+                case Comparison::Greater:
+                    minValues[i] = max(minValues[i],
+                                       nextafter(value, infinity));
+                    break;
+                case Comparison::GreaterEqual:
+                    minValues[i] = max(minValues[i], value);
+                    break;
+                default:
+                    break;
+            }
+        }
+    }
+
+    if (pricePredicate) {
+        bool emptyRange = minPrice > maxPrice;
+        size_t rangeSize = emptyRange
+                           ? 0
+                           : inv.getPriceIndex().countRange(minPrice,
+                                                            maxPrice);
+
+        if (rangeSize < queryPlan.estimatedRows) {
+            queryPlan.accessPath = AccessPath::PriceRange;
+            queryPlan.minPrice = emptyRange ? 1 : minPrice;
+            queryPlan.maxPrice = emptyRange ? 0 : maxPrice;
+            queryPlan.estimatedRows = rangeSize;
+        }
+    }
+
+    // Counting stops once a range is no better than the plan so far
+    for (int i = 0; i < 2; i++) {
+        if (!valuePredicates[i]) {
+            continue;
+        }
+
+        size_t rangeSize = inv.getValueIndex(valueTypes[i]).countRange(
+                minValues[i], maxValues[i], queryPlan.estimatedRows);
+
+        if (rangeSize < queryPlan.estimatedRows) {
+            queryPlan.accessPath = AccessPath::ValueRange;
+            queryPlan.componentType = valueTypes[i];
+            queryPlan.minValue = minValues[i];
+            queryPlan.maxValue = maxValues[i];
+            queryPlan.estimatedRows = rangeSize;
+        }
+    }
+
+    // Text shorter than a trigram would read every description
+    if (descriptionText.size() >= 3) {
+        size_t candidates =
+                inv.getDescriptionIndex().estimateText(descriptionText);
+
+        if (candidates < queryPlan.estimatedRows) {
+            queryPlan.accessPath = AccessPath::DescriptionText;
+            queryPlan.descriptionText = descriptionText;
+            queryPlan.estimatedRows = candidates;
+        }
+    }
+
+    return queryPlan;
+}
+
+/**
+ * Runs the query against an inventory, using the best plan for it
+ *
+ * @param inv                       inventory to query
+ * @return                          matching items and their aggregate
+ */
+QueryResult Query::run(const Inventory &inv) const {
+    return this->run(inv, this->plan(inv));
+}
+
+/**
+ * Runs the query against an inventory using a given plan, reading candidate
+ * items from the plan's index and checking every predicate against each.
+ * Every plan gives the same result.
+ *
+ * @param inv                       inventory to query
+ * @param queryPlan                 plan from planning this query
+ * @return                          matching items and their aggregate
+ */
+QueryResult Query::run(const Inventory &inv,
+                       const QueryPlan &queryPlan) const {
+    QueryResult result;
+    result.aggregate = 0;
+
+    // Lambda for keeping a candidate if it matches the query
+    auto check = [this, &inv, &result](uint32_t slot) {
+        if (this->matches(inv, slot)) {
+            result.slots.push_back(slot);
+        }
+        return true;
+    };
+
+    switch (queryPlan.accessPath) {
+        case AccessPath::FullScan:
+            for (uint32_t slot = 0; slot < inv.getColumns().getSize();
+                 slot++) {
+                check(slot);
+            }
+            break;
+        case AccessPath::TypePartition:
+            for (StockItem *item : inv.search(queryPlan.componentType)) {
+                check(item->getSlot());
+            }
+            break;
+        case AccessPath::PriceRange:
+            inv.getPriceIndex().forEachInRange(queryPlan.minPrice,
+                                               queryPlan.maxPrice, check);
+
+            // Puts the items back in the order they were added
+            sort(result.slots.begin(), result.slots.end());
+            break;
+        case AccessPath::ValueRange:
+            inv.getValueIndex(queryPlan.componentType).forEachInRange(
+                    queryPlan.minValue, queryPlan.maxValue, check);
+
+            // Puts the items back in the order they were added
+            sort(result.slots.begin(), result.slots.end());
+            break;
+        case AccessPath::CodeLookup:
+            if (StockItem *item = inv.find(queryPlan.stockCode)) {
+                check(item->getSlot());
+            }
+            break;
+        case AccessPath::DescriptionText:
+            // Found ignoring case, so each is checked against the predicate
+            for (uint32_t slot : inv.getDescriptionIndex().findText(
+                    queryPlan.descriptionText)) {
+                check(slot);
+            }
+            break;
+    }
+
+    if (this->aggregateType == Aggregate::Count) {
+        result.aggregate = result.slots.size();
+    } else if (this->aggregateType != Aggregate::None) {
+        size_t count = 0;
+
+        for (uint32_t slot : result.slots) {
+            ComponentType componentType;
+
+            // Skips items without the aggregated attribute
+            if (impliedComponentType(this->aggregateField, componentType) &&
+                inv.getColumns().getComponentTypes()[slot] != componentType) {
+                continue;
+            }
+
+            double value = numericValue(inv, slot, this->aggregateField);
+
+            if (count == 0) {
+                result.aggregate = value;
+            } else if (this->aggregateType == Aggregate::Min) {
+                result.aggregate = min(result.aggregate, value);
+            } else if (this->aggregateType == Aggregate::Max) {
+                result.aggregate = max(result.aggregate, value);
+            } else {
+                result.aggregate += value;
+            }
+
+            count++;
+        }
+
+        if (this->aggregateType == Aggregate::Average && count > 0) {
+            result.aggregate /= count;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Checks whether the item in a slot satisfies every predicate, reading its
+ * attributes from the inventory's columns
+ *
+ * @param inv                       inventory holding the item
+ * @param slot                      slot of the item
+ * @return                          true if the item matches the query
+ */
+bool Query::matches(const Inventory &inv, uint32_t slot) const {
+    const StockColumns &columns = inv.getColumns();
+    ComponentType componentType = columns.getComponentTypes()[slot];
+
+    for (const Predicate &predicate : this->predicates) {
+        ComponentType requiredType;
+
+        // Items without the attribute never satisfy the predicate
+        if (impliedComponentType(predicate.field, requiredType) &&
+            componentType != requiredType) {
+            return false;
+        }
+
+        bool satisfied;
+
+        switch (predicate.field) {
+            case QueryField::ComponentType:
+                satisfied = compare<int>(static_cast<int>(componentType),
+                                         predicate.comparison,
+                                         predicate.number);
+                break;
+            case QueryField::DeviceType:
+                satisfied = compare<int>(
+                        static_cast<int>(columns.getDeviceTypes()[slot]),
+                        predicate.comparison, predicate.number);
+                break;
+            case QueryField::StockCode:
+            case QueryField::Description: {
+                string_view text;
+
+                if (predicate.field == QueryField::StockCode) {
+                    text = columns.getCode(columns.getCodeIds()[slot]);
+                } else {
+                    text = static_cast<IntegratedCircuit *>(
+                            inv.getItemInSlot(slot))->getDescription();
+                }
+
+                satisfied = predicate.comparison == Comparison::Contains
+                            ? text.find(predicate.text) != string_view::npos
+                            : compare<string_view>(text,
+                                                   predicate.comparison,
+                                                   predicate.text);
+                break;
+            }
+            default:
+                satisfied = compare(numericValue(inv, slot, predicate.field),
+                                    predicate.comparison, predicate.number);
+                break;
+        }
+
+        if (!satisfied) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Retrieves a numeric attribute of the item in a slot from the columns
+ *
+ * @param inv                       inventory holding the item
+ * @param slot                      slot of the item
+ * @param field                     numeric attribute to retrieve
+ * @return                          value of the attribute
+ */
+double Query::numericValue(const Inventory &inv, uint32_t slot,
+                           QueryField field) {
+    const StockColumns &columns = inv.getColumns();
+
+    switch (field) {
+        case QueryField::StockAmount:
+            return columns.getStockAmounts()[slot];
+        case QueryField::UnitPrice:
+            return columns.getUnitPrices()[slot];
+        default:
+            return columns.getValues()[slot];
+    }
+}
+
+/**
+ * Prints the projected attributes of each matching item, one item a line
+ * and separated by commas, followed by the aggregate. Without a projection,
+ * a query with no aggregate prints each item in full and a query with an
+ * aggregate prints only the aggregate.
+ *
+ * @param os                        the output stream to print to
+ * @param inv                       inventory the query was run against
+ * @param result                    result of running the query
+ */
+void Query::print(ostream &os, const Inventory &inv,
+                  const QueryResult &result) const {
+    const StockColumns &columns = inv.getColumns();
+    bool printItems = !this->projection.empty() ||
+                      this->aggregateType == Aggregate::None;
+
+    for (size_t row = 0; printItems && row < result.slots.size(); row++) {
+        uint32_t slot = result.slots[row];
+        StockItem *item = inv.getItemInSlot(slot);
+
+        if (this->projection.empty()) {
+            os << *item << endl;
+            continue;
+        }
+
+        ComponentType componentType = columns.getComponentTypes()[slot];
+
+        for (size_t i = 0; i < this->projection.size(); i++) {
+            QueryField field = this->projection[i];
+            ComponentType requiredType;
+
+            os << (i > 0 ? ", " : "");
+
+            // Attributes the item does not have are shown as a dash
+            if (impliedComponentType(field, requiredType) &&
+                componentType != requiredType) {
+                os << "-";
+                continue;
+            }
+
+            switch (field) {
+                case QueryField::ComponentType:
+                    os << componentTypeName(componentType);
+                    break;
+                case QueryField::StockCode:
+                    os << columns.getCode(columns.getCodeIds()[slot]);
+                    break;
+                case QueryField::DeviceType:
+                    os << columns.getDeviceTypes()[slot];
+                    break;
+                case QueryField::Description:
+                    os << static_cast<IntegratedCircuit *>(item)
+                            ->getDescription();
+                    break;
+                default:
+                    os << formatNumber(numericValue(inv, slot, field));
+                    break;
+            }
+        }
+
+        os << endl;
+    }
+
+    if (this->aggregateType != Aggregate::None) {
+        os << AGGREGATE_NAMES[static_cast<int>(this->aggregateType)];
+
+        if (this->aggregateType != Aggregate::Count) {
+            os << "(" << queryFieldName(this->aggregateField) << ")";
+        }
+
+        os << ": " << formatNumber(result.aggregate) << endl;
+    }
+}
@@ -0,0 +1,175 @@
+/******************************************************************************
+ *
+ * File        : Query.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define queries over an inventory, which
+ *               filter items by predicates, project their attributes and
+ *               aggregate them, using the inventory's cheapest index.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef QUERY_H
+#define QUERY_H
+
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "Inventory.h"
+
+// Attributes of a stock item a query can filter, project or aggregate
+enum class QueryField {
+    ComponentType, StockCode, StockAmount, UnitPrice, Resistance,
+    Capacitance, DeviceType, Description
+};
+
+// Retrieves the name of a query field
+const std::string &queryFieldName(QueryField field);
+
+// Finds the query field with a name
+bool queryFieldNamed(std::string_view name, QueryField &field);
+
+// Comparisons a predicate can make between an attribute and a value
+enum class Comparison {
+    Equal, NotEqual, Less, LessEqual, Greater, GreaterEqual, Contains
+};
+
+// Aggregates a query can compute over the items it matches
+enum class Aggregate {
+    None, Count, Sum, Min, Max, Average
+};
+
+/**
+ * A comparison of an item's attribute against a value. Predicates on
+ * resistance, capacitance, device type or description only match items of
+ * the type that has the attribute.
+ */
+struct Predicate {
+    // Attribute compared
+    QueryField field;
+
+    // Comparison made
+    Comparison comparison;
+
+    // Value compared against for numeric and enum attributes
+    double number;
+
+    // Value compared against for text attributes
+    std::string text;
+};
+
+// Ways a query plan can find the items that might match a query
+enum class AccessPath {
+    FullScan, TypePartition, PriceRange, ValueRange, CodeLookup,
+    DescriptionText
+};
+
+/**
+ * How a query finds its items: the index it reads candidate items from and
+ * how many candidates it expects, all other predicates being checked
+ * against each candidate
+ */
+struct QueryPlan {
+    // Index candidate items are read from
+    AccessPath accessPath;
+
+    // Component type of the items read from the type partition or the
+    // parametric index
+    ComponentType componentType;
+
+    // Range of prices read from the price index
+    int minPrice;
+    int maxPrice;
+
+    // Range of resistances/capacitances read from the parametric index
+    double minValue;
+    double maxValue;
+
+    // Stock code looked up in the code index
+    std::string stockCode;
+
+    // Text searched for in the description index
+    std::string descriptionText;
+
+    // Amount of candidate items the plan reads
+    size_t estimatedRows;
+
+    // Describes the plan in a line of text
+    std::string describe() const;
+};
+
+/**
+ * Items matched by a query, in the order they were added to the inventory,
+ * and the query's aggregate over them
+ */
+struct QueryResult {
+    // Slots of the matching items in the inventory's columns
+    std::vector<uint32_t> slots;
+
+    // Aggregate of the matching items (0 if there were none)
+    double aggregate;
+};
+
+/**
+ * Models a query over an inventory: a conjunction of predicates, the
+ * attributes to project from each matching item and an aggregate
+ */
+class Query {
+private:
+    // Predicates every matching item must satisfy
+    std::vector<Predicate> predicates;
+
+    // Attributes printed for each matching item (if empty, every item is
+    // printed in full when there is no aggregate)
+    std::vector<QueryField> projection;
+
+    // Aggregate computed over the matching items and the attribute it uses
+    Aggregate aggregateType;
+    QueryField aggregateField;
+
+    // Checks whether the item in a slot satisfies every predicate
+    bool matches(const Inventory &inv, uint32_t slot) const;
+
+    // Retrieves a numeric attribute of the item in a slot
+    static double numericValue(const Inventory &inv, uint32_t slot,
+                               QueryField field);
+
+public:
+    // Query Constructor
+    Query();
+
+    // Adds a predicate against a numeric attribute
+    Query &where(QueryField field, Comparison comparison, double value);
+
+    // Adds a predicate against a text or enum attribute
+    Query &where(QueryField field, Comparison comparison,
+                 const std::string &value);
+
+    // Sets the attributes to print for each matching item
+    Query &select(const std::vector<QueryField> &fields);
+
+    // Sets the aggregate to compute over the matching items
+    Query &aggregate(Aggregate type, QueryField field = QueryField::UnitPrice);
+
+    // Retrieves the predicates of the query
+    const std::vector<Predicate> &getPredicates() const;
+
+    // Plans how to find the items matching the query in an inventory
+    QueryPlan plan(const Inventory &inv) const;
+
+    // Runs the query against an inventory, using the best plan for it
+    QueryResult run(const Inventory &inv) const;
+
+    // Runs the query against an inventory using a given plan
+    QueryResult run(const Inventory &inv, const QueryPlan &queryPlan) const;
+
+    // Prints the projected attributes of each item and the aggregate
+    void print(std::ostream &os, const Inventory &inv,
+               const QueryResult &result) const;
+};
+
+#endif /* QUERY_H */
@@ -0,0 +1,303 @@
+/******************************************************************************
+ *
+ * File        : QueryLanguage.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define the parser of the query language and the
+ *               cache of compiled queries.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <cctype>
+#include <stdexcept>
+#include <vector>
+#include "QueryLanguage.h"
+
+using namespace std;
+
+// Characters that make up comparison operators
+static const char OPERATOR_CHARACTERS[] = "=!<>~";
+
+// Splits the text of a query into words, values and operators
+static vector<string> tokenise(string_view text);
+
+// Finds the component type named by a word of a query
+static bool componentTypeWord(const string &word,
+                              ComponentType &componentType);
+
+/**
+ * Compiles the text of a query into a query
+ *
+ * @param text                      text of the query
+ * @return                          compiled query
+ */
+Query parseQuery(string_view text) {
+    vector<string> tokens = tokenise(text);
+    size_t position = 0;
+    Query query;
+
+    // Lambda for retrieving the next token, failing at the end of the query
+    auto next = [&tokens, &position](const string &expected) -> string {
+        if (position >= tokens.size()) {
+            throw invalid_argument("Expected " + expected +
+                                   " at end of query.");
+        }
+        return tokens[position++];
+    };
+
+    // Lambda for reading the name of a field
+    auto nextField = [&next]() -> QueryField {
+        string name = next("a field");
+        QueryField field;
+
+        if (!queryFieldNamed(name, field)) {
+            throw invalid_argument("Unknown field '" + name + "'.");
+        }
+        return field;
+    };
+
+    // Aggregate, listing the items if there is none
+    if (position < tokens.size()) {
+        const string &word = tokens[position];
+
+        if (word == "count") {
+            query.aggregate(Aggregate::Count);
+            position++;
+        } else if (word == "sum" || word == "min" || word == "max" ||
+                   word == "avg") {
+            Aggregate aggregate = word == "sum" ? Aggregate::Sum
+                                  : word == "min" ? Aggregate::Min
+                                  : word == "max" ? Aggregate::Max
+                                  : Aggregate::Average;
+            position++;
+            query.aggregate(aggregate, nextField());
+        } else if (word == "list") {
+            position++;
+        }
+    }
+
+    // Items of a component type, or every item
+    ComponentType componentType;
+
+    if (position < tokens.size() &&
+        componentTypeWord(tokens[position], componentType)) {
+        query.where(QueryField::ComponentType, Comparison::Equal,
+                    componentTypeName(componentType));
+        position++;
+    } else if (position < tokens.size() && tokens[position] == "all") {
+        position++;
+    }
+
+    // Conditions, joined by and
+    if (position < tokens.size() && tokens[position] == "where") {
+        do {
+            position++;
+            QueryField field = nextField();
+            string op = next("a comparison");
+            string value = next("a value");
+
+            Comparison comparison;
+
+            if (op == "=") {
+                comparison = Comparison::Equal;
+            } else if (op == "!=") {
+                comparison = Comparison::NotEqual;
+            } else if (op == "<") {
+                comparison = Comparison::Less;
+            } else if (op == "<=") {
+                comparison = Comparison::LessEqual;
+            } else if (op == ">") {
+                comparison = Comparison::Greater;
+            } else if (op == ">=") {
+                comparison = Comparison::GreaterEqual;
+            } else if (op == "~") {
+                comparison = Comparison::Contains;
+            } else {
+                throw invalid_argument("Unknown comparison '" + op + "'.");
+            }
+
+            // Component types can be given by the words used for items
+            if (field == QueryField::ComponentType &&
+                componentTypeWord(value, componentType)) {
+                value = componentTypeName(componentType);
+            }
+
+            query.where(field, comparison, value);
+        } while (position < tokens.size() && tokens[position] == "and");
+    }
+
+    // Fields to print for each item
+    if (position < tokens.size() && tokens[position] == "select") {
+        vector<QueryField> fields;
+
+        do {
+            position++;
+            fields.push_back(nextField());
+        } while (position < tokens.size() && tokens[position] == ",");
+
+        query.select(fields);
+    }
+
+    if (position < tokens.size()) {
+        throw invalid_argument("Unexpected '" + tokens[position] + "'.");
+    }
+
+    return query;
+}
+
+/**
+ * Splits the text of a query into tokens: words and values, runs of
+ * operator characters, commas, and double quoted values (which may contain
+ * spaces, without their quotes)
+ *
+ * @param text                      text of the query
+ * @return                          tokens of the query
+ */
+static vector<string> tokenise(string_view text) {
+    vector<string> tokens;
+    size_t i = 0;
+
+    // Lambda for checking whether a character is part of an operator
+    auto isOperator = [](char character) {
+        return string_view(OPERATOR_CHARACTERS).find(character) !=
+               string_view::npos;
+    };
+
+    while (i < text.size()) {
+        char character = text[i];
+        size_t start = i;
+
+        if (isspace(static_cast<unsigned char>(character))) {
+            i++;
+        } else if (character == ',') {
+            tokens.emplace_back(",");
+            i++;
+        } else if (character == '"') {
+            size_t end = text.find('"', i + 1);
+
+            if (end == string_view::npos) {
+                throw invalid_argument("Unterminated quoted value.");
+            }
+
+            tokens.emplace_back(text.substr(i + 1, end - i - 1));
+            i = end + 1;
+        } else if (isOperator(character)) {
+            while (i < text.size() && isOperator(text[i])) {
+                i++;
+            }
+            tokens.emplace_back(text.substr(start, i - start));
+        } else {
+            while (i < text.size() &&
+                   !isspace(static_cast<unsigned char>(text[i])) &&
+                   text[i] != ',' && text[i] != '"' && !isOperator(text[i])) {
+                i++;
+            }
+            tokens.emplace_back(text.substr(start, i - start));
+        }
+    }
+
+    return tokens;
+}
+
+/**
+ * Finds the component type named by a word of a query, which is its name
+ * in lower case, singular or plural, or ic for integrated circuits
+ *
+ * @param word                      word of the query
+ * @param componentType             set to the named component type
+ * @return                          true if the word names a component type
+ */
+static bool componentTypeWord(const string &word,
+                              ComponentType &componentType) {
+    string singular = word;
+
+    if (!singular.empty() && singular.back() == 's') {
+        singular.pop_back();
+    }
+
+    if (singular == "ic") {
+        componentType = ComponentType::IntegratedCircuit;
+        return true;
+    }
+
+    for (int i = 0; i < COMPONENT_TYPE_COUNT; i++) {
+        string name = componentTypeName(static_cast<ComponentType>(i));
+
+        for (char &character : name) {
+            character = tolower(static_cast<unsigned char>(character));
+        }
+
+        if (name == singular) {
+            componentType = static_cast<ComponentType>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Normalises the text of a query, trimming it and collapsing each run of
+ * whitespace outside quotes into a single space
+ *
+ * @param text                      text of the query
+ * @return                          normalised text
+ */
+string QueryCache::normalise(string_view text) {
+    string normalised;
+    bool quoted = false;
+
+    for (char character : text) {
+        quoted ^= character == '"';
+
+        if (quoted || !isspace(static_cast<unsigned char>(character))) {
+            normalised += character;
+        } else if (!normalised.empty() && normalised.back() != ' ') {
+            normalised += ' ';
+        }
+    }
+
+    if (!normalised.empty() && normalised.back() == ' ') {
+        normalised.pop_back();
+    }
+
+    return normalised;
+}
+
+/**
+ * Compiles a query and plans it against an inventory, or retrieves the
+ * compiled query if the same text was compiled before
+ *
+ * @param text                      text of the query
+ * @param inv                       inventory the query will be run against
+ * @param cached                    set to true if the query was cached
+ * @return                          compiled query
+ */
+const CompiledQuery &QueryCache::compile(string_view text,
+                                         const Inventory &inv,
+                                         bool &cached) {
+    string key = normalise(text);
+    auto found = this->compiledQueries.find(key);
+
+    cached = found != this->compiledQueries.end();
+
+    if (cached) {
+        return found->second;
+    }
+
+    Query query = parseQuery(key);
+    QueryPlan plan = query.plan(inv);
+
+    return this->compiledQueries.emplace(key, CompiledQuery{query, plan})
+            .first->second;
+}
+
+/**
+ * Forgets every compiled query
+ */
+void QueryCache::clear() {
+    this->compiledQueries.clear();
+}
@@ -0,0 +1,66 @@
+/******************************************************************************
+ *
+ * File        : QueryLanguage.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a compact text language for queries
+ *               over an inventory, and a cache of compiled queries.
+ *
+ *               query     := [aggregate] [items] [where conditions]
+ *                            [select fields]
+ *               aggregate := list | count | (sum|min|max|avg) field
+ *               items     := all | resistor | capacitor | diode
+ *                            | transistor | ic
+ *               conditions:= field op value {and field op value}
+ *               op        := = | != | < | <= | > | >= | ~ (contains)
+ *               fields    := field {, field}
+ *
+ *               e.g. count transistor where device=NPN
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef QUERYLANGUAGE_H
+#define QUERYLANGUAGE_H
+
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Query.h"
+
+// Compiles the text of a query into a query (invalid_argument if it is not
+// a valid query)
+Query parseQuery(std::string_view text);
+
+/**
+ * A query compiled from text and the plan made for it
+ */
+struct CompiledQuery {
+    Query query;
+    QueryPlan plan;
+};
+
+/**
+ * Caches the queries compiled for an inventory by their text, so that
+ * asking the same question again skips parsing and planning
+ */
+class QueryCache {
+private:
+    // Compiled queries by their normalised text
+    std::unordered_map<std::string, CompiledQuery> compiledQueries;
+
+    // Normalises the text of a query, collapsing runs of whitespace
+    static std::string normalise(std::string_view text);
+
+public:
+    // Compiles a query, or retrieves it if it was compiled before
+    const CompiledQuery &compile(std::string_view text, const Inventory &inv,
+                                 bool &cached);
+
+    // Forgets every compiled query (such as after the inventory changes)
+    void clear();
+};
+
+#endif /* QUERYLANGUAGE_H */
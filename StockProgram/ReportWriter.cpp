@@ -0,0 +1,192 @@
+/******************************************************************************
+ *
+ * File        : ReportWriter.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a report writer, which formats stock items
+ *               into a buffer and writes it to a stream in large blocks.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cfloat>
+#include <charconv>
+#include <cstring>
+#include "Inventory.h"
+#include "ReportWriter.h"
+
+using namespace std;
+
+// Most characters an integer is written with
+static const size_t MAX_INTEGER_LENGTH = 24;
+
+// Most characters the whole part of a number is written with (its sign and
+// every digit of the largest double)
+static const size_t MAX_WHOLE_LENGTH = DBL_MAX_10_EXP + 3;
+
+/**
+ * Constructs a new writer to a stream
+ *
+ * @param os                        stream to write the report to
+ * @param bufferSize                characters to format before writing them
+ *                                  to the stream
+ */
+ReportWriter::ReportWriter(ostream &os, size_t bufferSize)
+        : os(os), buffer(max(bufferSize, MAX_WHOLE_LENGTH * 2)), used(0) {
+}
+
+/**
+ * Destroys the writer, writing what is left in its buffer to the stream
+ */
+ReportWriter::~ReportWriter() {
+    this->flush();
+}
+
+/**
+ * Makes room in the buffer for an amount of characters, writing the buffer
+ * to the stream if they do not fit, and growing it if they never would
+ *
+ * @param length                    amount of characters to make room for
+ * @return                          where to put the characters
+ */
+char *ReportWriter::reserve(size_t length) {
+    if (length > this->buffer.size() - this->used) {
+        this->flush();
+
+        if (length > this->buffer.size()) {
+            this->buffer.resize(length);
+        }
+    }
+
+    return this->buffer.data() + this->used;
+}
+
+/**
+ * Writes text
+ *
+ * @param text                      text to write
+ * @return                          this writer
+ */
+ReportWriter &ReportWriter::write(string_view text) {
+    memcpy(this->reserve(text.size()), text.data(), text.size());
+    this->used += text.size();
+
+    return *this;
+}
+
+/**
+ * Writes a character
+ *
+ * @param character                 character to write
+ * @return                          this writer
+ */
+ReportWriter &ReportWriter::write(char character) {
+    *this->reserve(1) = character;
+    this->used++;
+
+    return *this;
+}
+
+/**
+ * Writes an integer, as a stream writes it by default
+ *
+ * @param value                     integer to write
+ * @return                          this writer
+ */
+ReportWriter &ReportWriter::writeInteger(long long value) {
+    char *start = this->reserve(MAX_INTEGER_LENGTH);
+    char *end = to_chars(start, start + MAX_INTEGER_LENGTH, value).ptr;
+    this->used += end - start;
+
+    return *this;
+}
+
+/**
+ * Writes a number with a fixed amount of decimal places, as a stream set to
+ * fixed with that precision writes it
+ *
+ * @param value                     number to write
+ * @param precision                 amount of decimal places
+ * @return                          this writer
+ */
+ReportWriter &ReportWriter::writeFixed(double value, int precision) {
+    size_t length = MAX_WHOLE_LENGTH + 1 + max(precision, 0);
+    char *start = this->reserve(length);
+    char *end = to_chars(start, start + length, value, chars_format::fixed,
+                         precision).ptr;
+    this->used += end - start;
+
+    return *this;
+}
+
+/**
+ * Writes the details of a stock item, in the same format as its print
+ * method
+ *
+ * @param item                      item to write
+ * @return                          this writer
+ */
+ReportWriter &ReportWriter::writeItem(const StockItem &item) {
+    this->write("Component Type: ").write(componentTypeName(item.getType()))
+            .write("\nStock Code: ").write(item.getStockCode())
+            .write("\nStock Amount: ").writeInteger(item.getStockAmount())
+            .write("\nUnit Price: ").writeInteger(item.getUnitPrice())
+            .write("p\n");
+
+    // Writes the attributes specific to each type of item
+    switch (item.getType()) {
+        case ComponentType::Resistor:
+            return this->write("Total Resistance: ")
+                    .writeFixed(static_cast<const Resistor &>(item)
+                                        .getResistance(), 2)
+                    .write("ohms\n");
+        case ComponentType::Capacitor:
+            return this->write("Total Capacitance: ")
+                    .writeFixed(static_cast<const Capacitor &>(item)
+                                        .getCapacitance(), 0)
+                    .write("pf\n");
+        case ComponentType::Transistor:
+            return this->write("Device Type: ")
+                    .write(deviceTypeName(static_cast<const Transistor &>(
+                            item).getDeviceType()))
+                    .write('\n');
+        case ComponentType::IntegratedCircuit:
+            return this->write("Description: ")
+                    .write(static_cast<const IntegratedCircuit &>(item)
+                                   .getDescription())
+                    .write('\n');
+        default:
+            return *this;
+    }
+}
+
+/**
+ * Writes the size of an inventory and each of its items, in the same format
+ * as its output operator
+ *
+ * @param inventory                 inventory to write
+ * @return                          this writer
+ */
+ReportWriter &ReportWriter::writeInventory(Inventory &inventory) {
+    this->write("Inventory Size: ").writeInteger(inventory.getSize())
+            .write("\n\n");
+
+    for (int i = 0; i < inventory.getSize(); i++) {
+        this->writeItem(*inventory[i]).write('\n');
+    }
+
+    return *this;
+}
+
+/**
+ * Writes the buffer to the stream in one block, leaving the buffer empty
+ */
+void ReportWriter::flush() {
+    if (this->used > 0) {
+        this->os.write(this->buffer.data(), this->used);
+        this->used = 0;
+    }
+}
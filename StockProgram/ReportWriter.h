@@ -0,0 +1,80 @@
+/******************************************************************************
+ *
+ * File        : ReportWriter.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a report writer, which formats
+ *               stock items into a buffer and writes it to a stream in large
+ *               blocks.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef REPORTWRITER_H
+#define REPORTWRITER_H
+
+#include <cstddef>
+#include <iostream>
+#include <string_view>
+#include <vector>
+#include "StockItem.h"
+
+class Inventory;
+
+/**
+ * Writes reports of stock items, byte for byte as their output operators
+ * do, without flushing the stream after every line. Text and numbers are
+ * formatted into a reusable buffer (numbers with to_chars rather than
+ * through the stream's locale), which is written to the stream whenever it
+ * fills and when the writer is flushed or destroyed.
+ */
+class ReportWriter {
+private:
+    // Stream the report is written to
+    std::ostream &os;
+
+    // Formatted text not yet written to the stream
+    std::vector<char> buffer;
+
+    // Amount of the buffer in use
+    size_t used;
+
+    // Makes room in the buffer for an amount of characters
+    char *reserve(size_t length);
+
+public:
+    // ReportWriter Constructor
+    explicit ReportWriter(std::ostream &os, size_t bufferSize = 1 << 16);
+
+    // ReportWriter Destructor (flushes the buffer)
+    ~ReportWriter();
+
+    // Writers hold a reference to their stream, so cannot be copied
+    ReportWriter(const ReportWriter &writer) = delete;
+    ReportWriter &operator=(const ReportWriter &writer) = delete;
+
+    // Writes text
+    ReportWriter &write(std::string_view text);
+
+    // Writes a character
+    ReportWriter &write(char character);
+
+    // Writes an integer
+    ReportWriter &writeInteger(long long value);
+
+    // Writes a number with a fixed amount of decimal places
+    ReportWriter &writeFixed(double value, int precision);
+
+    // Writes the details of a stock item, as its output operator does
+    ReportWriter &writeItem(const StockItem &item);
+
+    // Writes every item of an inventory, as its output operator does
+    ReportWriter &writeInventory(Inventory &inventory);
+
+    // Writes the buffer to the stream
+    void flush();
+};
+
+#endif /* REPORTWRITER_H */
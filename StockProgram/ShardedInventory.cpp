@@ -0,0 +1,500 @@
+/******************************************************************************
+ *
+ * File        : ShardedInventory.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define an inventory partitioned by stock code hash
+ *               into independent shards, each with its own items, indexes
+ *               and lock.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include "ParallelSort.h"
+#include "ShardedInventory.h"
+
+using namespace std;
+
+// An item selected by a shard, with its key read while the shard was
+// locked, the shard it is in and its place in the shard's selection
+struct ShardCandidate {
+    long long number;
+    string_view code;
+    size_t shard;
+    size_t rank;
+    StockItem *item;
+};
+
+/**
+ * Picks the shard of a stock code
+ *
+ * @param code                      stock code
+ * @param shardCount                amount of shards
+ * @return                          index of the code's shard
+ */
+static size_t shardIndex(string_view code, size_t shardCount) {
+    // Mixes the hash, so the shard does not depend on its low bits alone
+    uint64_t mixed = std::hash<string_view>()(code) * 0x9E3779B97F4A7C15ULL;
+
+    return (mixed >> 32) % shardCount;
+}
+
+/**
+ * Constructs an empty sharded inventory
+ *
+ * @param shardCount                amount of shards to split items into
+ * @param threadCount               amount of threads queries fan out
+ *                                  across, 0 uses one per hardware thread
+ */
+ShardedInventory::ShardedInventory(size_t shardCount,
+                                   unsigned int threadCount) {
+    if (shardCount == 0) {
+        throw invalid_argument("Sharded inventory needs at least 1 shard.");
+    }
+
+    if (threadCount == 0) {
+        threadCount = max(1u, thread::hardware_concurrency());
+    }
+
+    this->threadCount = threadCount;
+
+    for (size_t i = 0; i < shardCount; i++) {
+        this->shards.emplace_back(new Shard());
+    }
+}
+
+/**
+ * Constructs a sharded inventory holding a copy of every item of an
+ * inventory. Each shard copies its own items on its own thread, so its
+ * memory is first touched, and placed, by the thread that loaded it.
+ *
+ * @param inventory                 inventory to copy
+ * @param shardCount                amount of shards to split items into
+ * @param threadCount               amount of threads queries fan out
+ *                                  across, 0 uses one per hardware thread
+ */
+ShardedInventory::ShardedInventory(const Inventory &inventory,
+                                   size_t shardCount,
+                                   unsigned int threadCount)
+        : ShardedInventory(shardCount, threadCount) {
+    const vector<StockItem *> &items = inventory.getColumns().getItems();
+    vector<vector<const StockItem *>> shardItems(shardCount);
+
+    for (const StockItem *item : items) {
+        shardItems[shardIndex(item->getStockCode(), shardCount)]
+                .push_back(item);
+    }
+
+    this->forEachShard([this, &shardItems](size_t i) {
+        ItemArena arena;
+        vector<StockItem *> copies;
+        copies.reserve(shardItems[i].size());
+
+        for (const StockItem *item : shardItems[i]) {
+            copies.push_back(arena.copy(*item));
+        }
+
+        unique_lock<shared_mutex> lock(this->shards[i]->mutex);
+        this->shards[i]->inventory.splice(arena, copies);
+    });
+}
+
+/**
+ * Retrieves the amount of shards items are split into
+ *
+ * @return                          amount of shards
+ */
+size_t ShardedInventory::getShardCount() const {
+    return this->shards.size();
+}
+
+/**
+ * Retrieves the amount of items in every shard
+ *
+ * @return                          amount of items
+ */
+int ShardedInventory::getSize() const {
+    int size = 0;
+
+    for (const unique_ptr<Shard> &shard : this->shards) {
+        shared_lock<shared_mutex> lock(shard->mutex);
+        size += shard->inventory.getSize();
+    }
+
+    return size;
+}
+
+/**
+ * Adds an item to the shard of its stock code, taking ownership of it
+ *
+ * @param item                      item to add
+ */
+void ShardedInventory::add(StockItem *item) {
+    Shard &shard = this->shardOf(item->getStockCode());
+    unique_lock<shared_mutex> lock(shard.mutex);
+
+    shard.inventory.add(item);
+}
+
+/**
+ * Finds the item with a stock code, visiting only the shard of the code
+ *
+ * @param code                      stock code to find
+ * @return                          item with code, null if there is none
+ */
+StockItem *ShardedInventory::find(string_view code) const {
+    Shard &shard = this->shardOf(code);
+    shared_lock<shared_mutex> lock(shard.mutex);
+
+    return shard.inventory.find(code);
+}
+
+/**
+ * Changes the item with a stock code while holding its shard's lock, so no
+ * query of the shard sees the change half made. Changes to items in other
+ * shards carry on meanwhile. The change may not give the item a new stock
+ * code, as the item would then be left in the shard of its old code; a new
+ * code is changed back before throwing.
+ *
+ * @param code                      stock code of item to change
+ * @param change                    function making the change
+ * @return                          true if an item has the code
+ * @throws invalid_argument         if the change altered the stock code
+ */
+bool ShardedInventory::update(string_view code,
+                              const function<void(StockItem &)> &change) {
+    Shard &shard = this->shardOf(code);
+    unique_lock<shared_mutex> lock(shard.mutex);
+    StockItem *item = shard.inventory.find(code);
+
+    if (item == nullptr) {
+        return false;
+    }
+
+    string oldCode(item->getStockCode());
+    change(*item);
+
+    if (item->getStockCode() != oldCode) {
+        item->setStockCode(oldCode);
+        throw invalid_argument("Stock codes cannot be changed by an update "
+                               "of a sharded inventory.");
+    }
+
+    return true;
+}
+
+/**
+ * Takes an amount of stock of the item with a stock code for an order, if
+ * at least that much is left. Reservations only share their shard's lock,
+ * as they change nothing but the item's atomic stock amount (see
+ * Inventory::tryReserve).
+ *
+ * @param code                      stock code of item to reserve
+ * @param quantity                  amount of stock to reserve
+ * @return                          reservation of the stock, not pending if
+ *                                  too little is left
+ */
+StockReservation ShardedInventory::tryReserve(string_view code,
+                                              int quantity) {
+    Shard &shard = this->shardOf(code);
+    shared_lock<shared_mutex> lock(shard.mutex);
+
+    return shard.inventory.tryReserve(code, quantity);
+}
+
+/**
+ * Commits a reservation made through the sharded inventory, keeping its
+ * stock taken for good. Needs no shard's lock, as a commit changes nothing
+ * but the reservation (see Inventory::commit).
+ *
+ * @param reservation               pending reservation to commit
+ * @throws invalid_argument         if the reservation holds no stock
+ */
+void ShardedInventory::commit(StockReservation &reservation) {
+    Inventory::commit(reservation);
+}
+
+/**
+ * Releases a reservation made through the sharded inventory, putting its
+ * stock back. Needs no shard's lock, as a release changes nothing but the
+ * item's atomic stock amount (see Inventory::release).
+ *
+ * @param reservation               pending reservation to release
+ * @throws invalid_argument         if the reservation holds no stock
+ */
+void ShardedInventory::release(StockReservation &reservation) {
+    Inventory::release(reservation);
+}
+
+/**
+ * Refreshes the columns and indexes of every shard with the stock amounts
+ * reservations have changed
+ */
+void ShardedInventory::syncStockAmounts() {
+    this->forEachShard([this](size_t i) {
+        unique_lock<shared_mutex> lock(this->shards[i]->mutex);
+        this->shards[i]->inventory.syncStockAmounts();
+    });
+}
+
+/**
+ * Searches every shard for the items of a component type, in shard order
+ *
+ * @param componentType             component type to search for
+ * @return                          items of the component type
+ */
+vector<StockItem *> ShardedInventory::search(
+        ComponentType componentType) const {
+    vector<vector<StockItem *>> shardResults(this->shards.size());
+
+    this->forEachShard([this, componentType, &shardResults](size_t i) {
+        shared_lock<shared_mutex> lock(this->shards[i]->mutex);
+        shardResults[i] = this->shards[i]->inventory.search(componentType);
+    });
+
+    size_t resultCount = 0;
+
+    for (const vector<StockItem *> &results : shardResults) {
+        resultCount += results.size();
+    }
+
+    vector<StockItem *> results;
+    results.reserve(resultCount);
+
+    for (const vector<StockItem *> &shardResult : shardResults) {
+        results.insert(results.end(), shardResult.begin(),
+                       shardResult.end());
+    }
+
+    return results;
+}
+
+/**
+ * Counts the items of every shard that pass a filter
+ *
+ * @param filter                    filter items must pass
+ * @return                          amount of items
+ */
+size_t ShardedInventory::countItems(const ColumnFilter &filter) const {
+    vector<size_t> counts(this->shards.size());
+
+    this->forEachShard([this, &filter, &counts](size_t i) {
+        shared_lock<shared_mutex> lock(this->shards[i]->mutex);
+        counts[i] = ::countItems(this->shards[i]->inventory.getColumns(),
+                                 filter);
+    });
+
+    size_t count = 0;
+
+    for (size_t shardCount : counts) {
+        count += shardCount;
+    }
+
+    return count;
+}
+
+/**
+ * Totals the stock amounts of the items of every shard that pass a filter
+ *
+ * @param filter                    filter items must pass
+ * @return                          total stock amount
+ */
+long long ShardedInventory::sumStockAmounts(
+        const ColumnFilter &filter) const {
+    vector<long long> totals(this->shards.size());
+
+    this->forEachShard([this, &filter, &totals](size_t i) {
+        shared_lock<shared_mutex> lock(this->shards[i]->mutex);
+        totals[i] = ::sumStockAmounts(
+                this->shards[i]->inventory.getColumns(), filter);
+    });
+
+    long long total = 0;
+
+    for (long long shardTotal : totals) {
+        total += shardTotal;
+    }
+
+    return total;
+}
+
+/**
+ * Totals the stock value (stock amount x unit price) in pence of the items
+ * of every shard that pass a filter
+ *
+ * @param filter                    filter items must pass
+ * @return                          total stock value in pence
+ */
+long long ShardedInventory::sumStockValues(
+        const ColumnFilter &filter) const {
+    vector<long long> totals(this->shards.size());
+
+    this->forEachShard([this, &filter, &totals](size_t i) {
+        shared_lock<shared_mutex> lock(this->shards[i]->mutex);
+        totals[i] = ::sumStockValues(
+                this->shards[i]->inventory.getColumns(), filter);
+    });
+
+    long long total = 0;
+
+    for (long long shardTotal : totals) {
+        total += shardTotal;
+    }
+
+    return total;
+}
+
+/**
+ * Finds the k items with the largest keys that pass a filter, best first
+ *
+ * @param key                       attribute to order items by
+ * @param k                         amount of items to find
+ * @param filter                    filter items must pass
+ * @return                          up to k items, best first
+ */
+vector<StockItem *> ShardedInventory::topK(SortField key, size_t k,
+                                           const ColumnFilter &filter) const {
+    return this->selectK(key, k, filter, true);
+}
+
+/**
+ * Finds the k items with the smallest keys that pass a filter, best first
+ *
+ * @param key                       attribute to order items by
+ * @param k                         amount of items to find
+ * @param filter                    filter items must pass
+ * @return                          up to k items, best first
+ */
+vector<StockItem *> ShardedInventory::bottomK(
+        SortField key, size_t k, const ColumnFilter &filter) const {
+    return this->selectK(key, k, filter, false);
+}
+
+/**
+ * Retrieves the shard a stock code belongs to
+ *
+ * @param code                      stock code
+ * @return                          shard of the code
+ */
+ShardedInventory::Shard &ShardedInventory::shardOf(string_view code) const {
+    return *this->shards[shardIndex(code, this->shards.size())];
+}
+
+/**
+ * Runs a task for each shard, spreading the shards across the inventory's
+ * threads (each thread taking every so many shards)
+ *
+ * @param task                      task taking the index of a shard
+ */
+void ShardedInventory::forEachShard(
+        const function<void(size_t)> &task) const {
+    size_t shardCount = this->shards.size();
+    size_t workerCount = min<size_t>(this->threadCount, shardCount);
+
+    runInParallel(workerCount, [&task, shardCount, workerCount](size_t w) {
+        for (size_t i = w; i < shardCount; i += workerCount) {
+            task(i);
+        }
+    });
+}
+
+/**
+ * Finds the k items with the largest or smallest keys that pass a filter.
+ * Each shard selects its own best k, reading their keys while locked, and
+ * the shards' selections are then merged and cut down to k. Items with
+ * equal keys are ordered by shard, then by their order in the shard.
+ *
+ * @param key                       attribute to order items by
+ * @param k                         amount of items to find
+ * @param filter                    filter items must pass
+ * @param largest                   true for the largest keys, false for the
+ *                                  smallest
+ * @return                          up to k items, best first
+ */
+vector<StockItem *> ShardedInventory::selectK(SortField key, size_t k,
+                                              const ColumnFilter &filter,
+                                              bool largest) const {
+    vector<vector<ShardCandidate>> shardCandidates(this->shards.size());
+
+    this->forEachShard([&](size_t i) {
+        shared_lock<shared_mutex> lock(this->shards[i]->mutex);
+        const Inventory &inventory = this->shards[i]->inventory;
+        const StockColumns &columns = inventory.getColumns();
+
+        // The shards already run on separate threads
+        vector<StockItem *> selected =
+                largest ? inventory.topK(key, k, filter, 1)
+                        : inventory.bottomK(key, k, filter, 1);
+
+        for (size_t rank = 0; rank < selected.size(); rank++) {
+            uint32_t slot = selected[rank]->getSlot();
+            ShardCandidate candidate = {0, string_view(), i, rank,
+                                        selected[rank]};
+
+            switch (key) {
+                case SortField::ComponentType:
+                    candidate.number = static_cast<int>(
+                            columns.getComponentTypes()[slot]);
+                    break;
+                case SortField::UnitPrice:
+                    candidate.number = columns.getUnitPrices()[slot];
+                    break;
+                case SortField::StockAmount:
+                    candidate.number = columns.getStockAmounts()[slot];
+                    break;
+                default:
+                    candidate.code = columns.getCode(
+                            columns.getCodeIds()[slot]);
+                    break;
+            }
+
+            shardCandidates[i].push_back(candidate);
+        }
+    });
+
+    vector<ShardCandidate> candidates;
+
+    for (const vector<ShardCandidate> &selected : shardCandidates) {
+        candidates.insert(candidates.end(), selected.begin(),
+                          selected.end());
+    }
+
+    // Lambda for whether a candidate comes before another
+    auto before = [largest](const ShardCandidate &candidate1,
+                            const ShardCandidate &candidate2) -> bool {
+        if (candidate1.number != candidate2.number) {
+            return largest ? candidate1.number > candidate2.number
+                           : candidate1.number < candidate2.number;
+        }
+
+        if (candidate1.code != candidate2.code) {
+            return largest ? candidate1.code > candidate2.code
+                           : candidate1.code < candidate2.code;
+        }
+
+        if (candidate1.shard != candidate2.shard) {
+            return candidate1.shard < candidate2.shard;
+        }
+
+        return candidate1.rank < candidate2.rank;
+    };
+
+    size_t selectedCount = min(k, candidates.size());
+    partial_sort(candidates.begin(), candidates.begin() + selectedCount,
+                 candidates.end(), before);
+
+    vector<StockItem *> selected;
+    selected.reserve(selectedCount);
+
+    for (size_t i = 0; i < selectedCount; i++) {
+        selected.push_back(candidates[i].item);
+    }
+
+    return selected;
+}
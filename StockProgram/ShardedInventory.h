@@ -0,0 +1,150 @@
+/******************************************************************************
+ *
+ * File        : ShardedInventory.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define an inventory partitioned by stock
+ *               code hash into independent shards, each with its own items,
+ *               indexes and lock.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef SHARDEDINVENTORY_H
+#define SHARDEDINVENTORY_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "Inventory.h"
+
+/**
+ * An inventory split into shards by the hash of each item's stock code.
+ * Every shard is an inventory of its own, with its own arena, columns and
+ * indexes, allocated and loaded on its own thread, behind its own lock.
+ * Writers to different shards never contend, and readers share each lock.
+ * Finding an item by its code visits one shard; searches, totals and top k
+ * queries fan out across the shards on several threads and merge their
+ * results.
+ */
+class ShardedInventory {
+private:
+    // An inventory of the items whose codes hash to it, and its lock
+    struct Shard {
+        mutable std::shared_mutex mutex;
+        Inventory inventory;
+    };
+
+    // Shards of the inventory
+    std::vector<std::unique_ptr<Shard>> shards;
+
+    // Amount of threads queries fan out across
+    unsigned int threadCount;
+
+    // Retrieves the shard a stock code belongs to
+    Shard &shardOf(std::string_view code) const;
+
+    // Runs a task for each shard, spread across the threads
+    void forEachShard(const std::function<void(size_t)> &task) const;
+
+    // Finds the items with the largest/smallest keys, best first
+    std::vector<StockItem *> selectK(SortField key, size_t k,
+                                     const ColumnFilter &filter,
+                                     bool largest) const;
+
+public:
+    // Amount of shards used when none is given
+    static const size_t DEFAULT_SHARD_COUNT = 16;
+
+    // ShardedInventory Constructor
+    explicit ShardedInventory(size_t shardCount = DEFAULT_SHARD_COUNT,
+                              unsigned int threadCount = 0);
+
+    // ShardedInventory Constructor (copies every item of an inventory)
+    explicit ShardedInventory(const Inventory &inventory,
+                              size_t shardCount = DEFAULT_SHARD_COUNT,
+                              unsigned int threadCount = 0);
+
+    // Sharded inventories cannot be copied
+    ShardedInventory(const ShardedInventory &inventory) = delete;
+    ShardedInventory &operator=(const ShardedInventory &inventory) = delete;
+
+    // Retrieves the amount of shards
+    size_t getShardCount() const;
+
+    // Retrieves the amount of items in every shard
+    int getSize() const;
+
+    // Adds an item to the shard of its stock code, taking ownership of it
+    void add(StockItem *item);
+
+    /**
+     * Creates a new item in the arena of the shard of its stock code and
+     * adds it to the shard
+     *
+     * @param code                      stock code of the item
+     * @param args                      remaining arguments for the item's
+     *                                  constructor
+     * @return                          pointer to the new item
+     */
+    template <typename T, typename... Args>
+    T *create(std::string_view code, Args &&... args) {
+        Shard &shard = this->shardOf(code);
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+
+        return shard.inventory.create<T>(code, std::forward<Args>(args)...);
+    }
+
+    // Finds the item with a stock code (null if there is none)
+    StockItem *find(std::string_view code) const;
+
+    // Changes the item with a stock code under its shard's lock (the change
+    // must keep the item's stock code, which decides its shard)
+    bool update(std::string_view code,
+                const std::function<void(StockItem &)> &change);
+
+    // Takes stock of the item with a code for an order, if enough is left
+    StockReservation tryReserve(std::string_view code, int quantity);
+
+    // Keeps the stock of a reservation taken for good
+    void commit(StockReservation &reservation);
+
+    // Puts the stock of a reservation back
+    void release(StockReservation &reservation);
+
+    // Refreshes every shard with stock amounts changed by reservations
+    void syncStockAmounts();
+
+    // Searches every shard for the items of a component type
+    std::vector<StockItem *> search(ComponentType componentType) const;
+
+    // Counts the items that pass a filter
+    size_t countItems(const ColumnFilter &filter = ColumnFilter()) const;
+
+    // Totals the stock amounts of the items that pass a filter
+    long long sumStockAmounts(
+            const ColumnFilter &filter = ColumnFilter()) const;
+
+    // Totals the stock value in pence of the items that pass a filter
+    long long sumStockValues(
+            const ColumnFilter &filter = ColumnFilter()) const;
+
+    // Finds the items with the largest keys, best first
+    std::vector<StockItem *> topK(
+            SortField key, size_t k,
+            const ColumnFilter &filter = ColumnFilter()) const;
+
+    // Finds the items with the smallest keys, best first
+    std::vector<StockItem *> bottomK(
+            SortField key, size_t k,
+            const ColumnFilter &filter = ColumnFilter()) const;
+};
+
+#endif /* SHARDEDINVENTORY_H */
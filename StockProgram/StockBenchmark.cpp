@@ -0,0 +1,3223 @@
+/******************************************************************************
+ *
+ * File        : StockBenchmark.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : Benchmarks for the stock program, timing the inventory
+ *               operations against synthetic inventories and checking the
+ *               faster paths agree with the original ones.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <malloc.h>
+#include <map>
+#include <mutex>
+#include <new>
+#include <random>
+#include <sstream>
+#include <thread>
+
+#include "StockItem.h"
+#include "Aggregation.h"
+#include "ConcurrentInventory.h"
+#include "Inventory.h"
+#include "InventoryReader.h"
+#include "InventoryReloader.h"
+#include "InventorySnapshot.h"
+#include "Query.h"
+#include "ReportWriter.h"
+#include "ShardedInventory.h"
+#include "StockRecord.h"
+#include "WriteAheadLog.h"
+
+using namespace std;
+
+// Clock used to time each benchmark
+typedef chrono::steady_clock Clock;
+
+// Amount of allocations made through operator new
+static atomic<size_t> allocationCount(0);
+
+// Bytes requested through operator new
+static atomic<size_t> allocatedBytes(0);
+
+// Whether any check of the benchmarks run has failed
+static bool checkFailed = false;
+
+// Writes a synthetic inventory file with the given amount of items
+void writeSyntheticInventory(const string &file, size_t itemCount);
+
+// Loads a synthetic inventory with the given amount of items
+Inventory loadSyntheticInventory(size_t itemCount);
+
+// Seconds elapsed since a point in time
+double secondsSince(Clock::time_point start);
+
+// Checks that two inventories hold the same items in the same order
+bool sameInventories(Inventory &inv1, Inventory &inv2);
+
+// Checks that two inventories have the same slots, stock order and indexes
+bool sameIndexes(Inventory &inv1, Inventory &inv2);
+
+// Prints the result of a check, noting whether it failed
+const char *checkResult(bool passed);
+
+// Benchmarks loading an inventory file
+void benchmarkLoad(size_t itemCount);
+
+// Benchmarks loading an inventory snapshot
+void benchmarkSnapshot(size_t itemCount);
+
+// Benchmarks aggregation scans over the inventory
+void benchmarkScan(size_t itemCount);
+
+// Benchmarks finding items by stock code
+void benchmarkFind(size_t itemCount);
+
+// Benchmarks sorting by price by comparison sort against radix sort
+void benchmarkSort(size_t itemCount);
+
+// Benchmarks sorting by several keys on increasing amounts of threads
+void benchmarkSortBy(size_t itemCount);
+
+// Benchmarks the aggregation kernels against loops through the items
+void benchmarkAggregate(size_t itemCount);
+
+// Benchmarks planned queries against scanning every item
+void benchmarkQuery(size_t itemCount);
+
+// Benchmarks top k selection against sorting every item
+void benchmarkTopK(size_t itemCount);
+
+// Benchmarks resistance range and nearest value searches
+void benchmarkParametric(size_t itemCount);
+
+// Benchmarks searching integrated circuit descriptions
+void benchmarkDescription(size_t itemCount);
+
+// Benchmarks completing partial stock codes and correcting mistyped ones
+void benchmarkCodes(size_t itemCount);
+
+// Benchmarks scans over stock records held by value against stock items
+// reached through pointers
+void benchmarkRecords(size_t itemCount);
+
+// Benchmarks the memory and allocations of loading an inventory
+void benchmarkMemory(size_t itemCount);
+
+// Benchmarks writing a report of every item
+void benchmarkReport(size_t itemCount);
+
+// Benchmarks queries on increasing amounts of threads while stock moves
+// between items, through snapshots against a single lock
+void benchmarkConcurrent(size_t itemCount);
+
+// Benchmarks many threads reserving stock of a few popular items, by
+// compare and swap against a single lock
+void benchmarkReserve(size_t itemCount);
+
+// Benchmarks queries and concurrent updates on increasing amounts of shards
+void benchmarkShards(size_t itemCount);
+
+// Benchmarks logging changes with group commit and replaying the log
+void benchmarkLog(size_t itemCount);
+
+// Benchmarks reloading a changed inventory file incrementally against
+// loading it again in full
+void benchmarkReload(size_t itemCount);
+
+// Checks readers taking snapshots while a writer publishes versions of a
+// concurrent inventory, meant for builds with a sanitizer
+void stressConcurrent(size_t itemCount);
+
+// Checks threads reserving, committing and releasing stock of a few items
+// at once, meant for builds with a sanitizer
+void stressReservations(size_t itemCount);
+
+// Checks updates, reservations and fanned out queries running on a sharded
+// inventory at once, meant for builds with a sanitizer
+void stressShards(size_t itemCount);
+
+// Checks threads logging the changes of their inventories into one log,
+// then recovery from it, meant for builds with a sanitizer
+void stressLog(size_t itemCount);
+
+
+int main(int argc, char **argv) {
+    // Benchmark to run and size of the synthetic inventory to run it with,
+    // the stress checks being run on a small one as sanitizers slow them
+    string benchmark = argc > 1 ? argv[1] : "all";
+    size_t itemCount = argc > 2 ? stoul(argv[2])
+                                : benchmark == "stress" ? 10000 : 1000000;
+
+    bool runAll = benchmark == "all";
+
+    if (runAll || benchmark == "load") {
+        benchmarkLoad(itemCount);
+    }
+
+    if (runAll || benchmark == "snapshot") {
+        benchmarkSnapshot(itemCount);
+    }
+
+    if (runAll || benchmark == "scan") {
+        benchmarkScan(itemCount);
+    }
+
+    if (runAll || benchmark == "find") {
+        benchmarkFind(itemCount);
+    }
+
+    if (runAll || benchmark == "sort") {
+        benchmarkSort(itemCount);
+    }
+
+    if (runAll || benchmark == "sortby") {
+        benchmarkSortBy(itemCount);
+    }
+
+    if (runAll || benchmark == "aggregate") {
+        benchmarkAggregate(itemCount);
+    }
+
+    if (runAll || benchmark == "query") {
+        benchmarkQuery(itemCount);
+    }
+
+    if (runAll || benchmark == "topk") {
+        benchmarkTopK(itemCount);
+    }
+
+    if (runAll || benchmark == "parametric") {
+        benchmarkParametric(itemCount);
+    }
+
+    if (runAll || benchmark == "description") {
+        benchmarkDescription(itemCount);
+    }
+
+    if (runAll || benchmark == "codes") {
+        benchmarkCodes(itemCount);
+    }
+
+    if (runAll || benchmark == "records") {
+        benchmarkRecords(itemCount);
+    }
+
+    if (runAll || benchmark == "memory") {
+        benchmarkMemory(itemCount);
+    }
+
+    if (runAll || benchmark == "report") {
+        benchmarkReport(itemCount);
+    }
+
+    if (runAll || benchmark == "concurrent") {
+        benchmarkConcurrent(itemCount);
+    }
+
+    if (runAll || benchmark == "reserve") {
+        benchmarkReserve(itemCount);
+    }
+
+    if (runAll || benchmark == "shards") {
+        benchmarkShards(itemCount);
+    }
+
+    if (runAll || benchmark == "log") {
+        benchmarkLog(itemCount);
+    }
+
+    if (runAll || benchmark == "reload") {
+        benchmarkReload(itemCount);
+    }
+
+    // Stress checks are only run on their own, in a build with a sanitizer
+    if (benchmark == "stress") {
+        stressConcurrent(itemCount);
+        stressReservations(itemCount);
+        stressShards(itemCount);
+        stressLog(itemCount);
+    }
+
+    return checkFailed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+/**
+ * Times the stream based reader against the memory mapped reader, reporting
+ * lines/sec and bytes/sec for each.
+ *
+ * @param itemCount         amount of items in the inventory file
+ */
+void benchmarkLoad(size_t itemCount) {
+    string file = (filesystem::temp_directory_path() /
+                   "stock_benchmark_inventory.txt").string();
+    writeSyntheticInventory(file, itemCount);
+    double bytes = filesystem::file_size(file);
+
+    cout << "Load (" << itemCount << " lines, " << fixed << setprecision(1)
+         << bytes / 1.0E6 << " MB)" << endl;
+
+    // Lambda to report the throughput of a reader
+    auto report = [itemCount, bytes](const string &name, double seconds) {
+        cout << "  " << left << setw(12) << name << right << fixed
+             << setprecision(3) << seconds << "s  " << setprecision(0)
+             << itemCount / seconds << " lines/s  " << setprecision(1)
+             << bytes / seconds / 1.0E6 << " MB/s" << endl;
+    };
+
+    Clock::time_point start = Clock::now();
+    Inventory streamInventory = readInventoryFile(file);
+    report("stream", secondsSince(start));
+
+    start = Clock::now();
+    Inventory mappedInventory = readMappedInventoryFile(file);
+    report("mapped", secondsSince(start));
+
+    cout << "  identical: "
+         << checkResult(sameInventories(streamInventory, mappedInventory))
+         << endl;
+
+    // Parallel reader at doubling thread counts up to the hardware's
+    unsigned int maxThreads = max(1u, thread::hardware_concurrency());
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        start = Clock::now();
+        Inventory parallelInventory = readParallelInventoryFile(file, threads);
+        report("parallel/" + to_string(threads), secondsSince(start));
+
+        cout << "  identical: "
+             << checkResult(sameInventories(streamInventory,
+                                            parallelInventory))
+             << endl;
+    }
+
+    // Teardown of individually allocated items against arena allocated ones
+    start = Clock::now();
+    streamInventory = Inventory();
+    cout << "  teardown    heap " << fixed << setprecision(3)
+         << secondsSince(start) << "s";
+
+    start = Clock::now();
+    mappedInventory = Inventory();
+    cout << ", arena " << secondsSince(start) << "s" << endl;
+
+    filesystem::remove(file);
+}
+
+/**
+ * Times starting up from a snapshot against parsing the text inventory, and
+ * checks that a snapshot round trip gives back the text inventory.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkSnapshot(size_t itemCount) {
+    filesystem::path directory = filesystem::temp_directory_path();
+    string textFile = (directory / "stock_benchmark_inventory.txt").string();
+    string snapshotFile = (directory / "stock_benchmark.snap").string();
+    writeSyntheticInventory(textFile, itemCount);
+
+    cout << "Snapshot (" << itemCount << " items)" << endl;
+
+    Clock::time_point start = Clock::now();
+    Inventory textInventory = readParallelInventoryFile(textFile);
+    cout << "  text load        " << fixed << setprecision(3)
+         << secondsSince(start) << "s" << endl;
+
+    start = Clock::now();
+    writeInventorySnapshot(textInventory, snapshotFile);
+    cout << "  snapshot write   " << secondsSince(start) << "s" << endl;
+
+    // Mapping the snapshot and scanning it needs no parsing at all
+    start = Clock::now();
+    long long totalStock = 0;
+    {
+        InventorySnapshot snapshot(snapshotFile);
+
+        for (size_t i = 0; i < snapshot.getSize(); i++) {
+            totalStock += snapshot[i].stockAmount;
+        }
+    }
+    cout << "  mapped scan      " << secondsSince(start) << "s (total stock "
+         << totalStock << ")" << endl;
+
+    start = Clock::now();
+    Inventory snapshotInventory = readInventorySnapshot(snapshotFile);
+    cout << "  snapshot load    " << secondsSince(start) << "s" << endl;
+
+    cout << "  round trip identical: "
+         << checkResult(sameInventories(textInventory, snapshotInventory))
+         << endl;
+    cout << "  indexes restored identical: "
+         << checkResult(sameIndexes(textInventory, snapshotInventory))
+         << endl;
+
+    // Damages the stored price order and the trie's root, which should be
+    // found and rebuilt on loading
+    {
+        SnapshotHeader header;
+        fstream snapshotStream(snapshotFile,
+                               ios::in | ios::out | ios::binary);
+        snapshotStream.read(reinterpret_cast<char *>(&header),
+                            sizeof(header));
+
+        const char damage[4] = {'\xff', '\xff', '\xff', '\xff'};
+        size_t price = static_cast<size_t>(SnapshotSection::PriceOrder);
+        size_t trie = static_cast<size_t>(SnapshotSection::TrieNodes);
+
+        if (header.sectionSizes[price] >= sizeof(damage)) {
+            snapshotStream.seekp(header.sectionOffsets[price]);
+            snapshotStream.write(damage, sizeof(damage));
+        }
+
+        snapshotStream.seekp(header.sectionOffsets[trie] +
+                             offsetof(StockCodeTrie::Node, firstChild));
+        snapshotStream.write(damage, sizeof(damage));
+    }
+
+    Inventory damagedInventory = readInventorySnapshot(snapshotFile);
+
+    cout << "  damaged indexes rebuilt: "
+         << checkResult(sameIndexes(textInventory, damagedInventory))
+         << endl;
+
+    filesystem::remove(textFile);
+    filesystem::remove(snapshotFile);
+}
+
+/**
+ * Times totalling the in stock resistance by searching and casting each item
+ * against scanning the inventory's columns.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkScan(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    const int REPEATS = 10;
+
+    cout << "Scan (" << itemCount << " items, " << REPEATS << " repeats)"
+         << endl;
+
+    // Totals through the item pointers, as the questions originally did
+    Clock::time_point start = Clock::now();
+    double pointerTotal = 0;
+
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+        for (StockItem *item : inv.search("Resistor")) {
+            Resistor *resistor = dynamic_cast<Resistor *>(item);
+
+            if (resistor->getStockAmount() > 0) {
+                pointerTotal += resistor->getResistance();
+            }
+        }
+    }
+
+    double pointerSeconds = secondsSince(start);
+
+    // Totals through the columns
+    const StockColumns &columns = inv.getColumns();
+    const vector<ComponentType> &componentTypes = columns.getComponentTypes();
+    const vector<int> &stockAmounts = columns.getStockAmounts();
+    const vector<double> &values = columns.getValues();
+
+    start = Clock::now();
+    double columnTotal = 0;
+
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+        for (size_t slot = 0; slot < componentTypes.size(); slot++) {
+            if (componentTypes[slot] == ComponentType::Resistor &&
+                stockAmounts[slot] > 0) {
+                columnTotal += values[slot];
+            }
+        }
+    }
+
+    double columnSeconds = secondsSince(start);
+
+    // Bytes of the three columns read by each column scan
+    double columnBytes = REPEATS * componentTypes.size() *
+                         (sizeof(ComponentType) + sizeof(int) +
+                          sizeof(double));
+
+    cout << "  pointers    " << fixed << setprecision(3) << pointerSeconds
+         << "s" << endl
+         << "  columns     " << columnSeconds << "s  " << setprecision(2)
+         << columnBytes / columnSeconds / 1.0E9 << " GB/s" << endl
+         << "  identical: " << checkResult(pointerTotal == columnTotal)
+         << endl;
+}
+
+/**
+ * Times finding items by stock code through the hash index against a linear
+ * scan of the inventory, at 1K, 1M and 10M items (up to the item count).
+ *
+ * @param itemCount         largest amount of items in the inventory
+ */
+void benchmarkFind(size_t itemCount) {
+    mt19937 random(2018);
+
+    for (size_t size = 1000; size <= itemCount; size *= 1000) {
+        Inventory inv = loadSyntheticInventory(size);
+
+        // Codes to look up, of items spread through the inventory
+        vector<string> codes;
+        for (int i = 0; i < 1000; i++) {
+            codes.emplace_back(inv[random() % size]->getStockCode());
+        }
+
+        // Few linear scans are needed to time them on large inventories
+        int scanLookups = max<size_t>(10, 10000000 / size);
+        Clock::time_point start = Clock::now();
+        int scanFound = 0;
+
+        for (int i = 0; i < scanLookups; i++) {
+            const string &code = codes[i % codes.size()];
+
+            for (int j = 0; j < inv.getSize(); j++) {
+                if (inv[j]->getStockCode() == code) {
+                    scanFound++;
+                    break;
+                }
+            }
+        }
+
+        double scanSeconds = secondsSince(start);
+
+        int indexLookups = 1000000;
+        start = Clock::now();
+        int indexFound = 0;
+
+        for (int i = 0; i < indexLookups; i++) {
+            if (inv.find(codes[i % codes.size()]) != nullptr) {
+                indexFound++;
+            }
+        }
+
+        double indexSeconds = secondsSince(start);
+
+        cout << "Find (" << size << " items)" << endl << fixed
+             << setprecision(1) << "  linear scan " << setw(12)
+             << scanSeconds / scanLookups * 1.0E9 << " ns/lookup" << endl
+             << "  hash index  " << setw(12)
+             << indexSeconds / indexLookups * 1.0E9 << " ns/lookup" << endl
+             << "  all found: "
+             << checkResult(scanFound == scanLookups &&
+                            indexFound == indexLookups) << endl;
+    }
+}
+
+/**
+ * Times sorting by price with a comparison sort against a radix sort at
+ * doubling inventory sizes (up to the item count), to find where the radix
+ * sort overtakes, and checks that both give the same order.
+ *
+ * @param itemCount         largest amount of items in the inventory
+ */
+void benchmarkSort(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    cout << "Sort by price (radix threshold "
+         << Inventory::RADIX_SORT_THRESHOLD << ")" << endl;
+
+    for (size_t size = 16; size <= itemCount; size *= 4) {
+        // Inventory of the first items, copied so that each sort starts
+        // from the same order
+        Inventory part;
+        for (size_t i = 0; i < size; i++) {
+            StockItem *item = inv[i];
+            part.create<Diode>(item->getStockCode(), item->getStockAmount(),
+                               item->getUnitPrice());
+        }
+
+        // Enough repeats to time the small sizes
+        int repeats = max<size_t>(4, 1000000 / size);
+        double seconds[2];
+        PriceSortMethod methods[] = {PriceSortMethod::Comparison,
+                                     PriceSortMethod::Radix};
+        vector<StockItem *> orders[2][2];
+
+        for (int m = 0; m < 2; m++) {
+            seconds[m] = 0;
+
+            // Only the sort is timed, not copying the unsorted inventory
+            for (int repeat = 0; repeat < repeats; repeat++) {
+                Inventory sorted = part;
+                bool ascending = repeat % 2 == 0;
+
+                Clock::time_point start = Clock::now();
+                sorted.sortByPrice(ascending, methods[m]);
+                seconds[m] += secondsSince(start);
+
+                if (repeat < 2) {
+                    for (int i = 0; i < sorted.getSize(); i++) {
+                        orders[m][repeat].push_back(
+                                part.find(sorted[i]->getStockCode()));
+                    }
+                }
+            }
+        }
+
+        bool identical = orders[0][0] == orders[1][0] &&
+                    orders[0][1] == orders[1][1];
+
+        cout << "  " << setw(8) << size << " items  comparison " << fixed
+             << setprecision(1) << setw(8)
+             << seconds[0] / repeats / size * 1.0E9 << " ns/item  radix "
+             << setw(8) << seconds[1] / repeats / size * 1.0E9
+             << " ns/item  identical: " << checkResult(identical) << endl;
+    }
+}
+
+/**
+ * Times sorting by (component type, price, stock amount, code) with a
+ * comparison sort through the items against the packed key sort at
+ * doubling thread counts, checking every sort gives the same order.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkSortBy(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    cout << "Sort by type, price, amount and code (" << itemCount
+         << " items)" << endl;
+
+    // Lambda for comparing two stock items by each key in turn
+    auto comparisionMethod = [](StockItem *item1, StockItem *item2) -> bool {
+        if (item1->getType() != item2->getType()) {
+            return item1->getType() < item2->getType();
+        }
+        if (item1->getUnitPrice() != item2->getUnitPrice()) {
+            return item1->getUnitPrice() < item2->getUnitPrice();
+        }
+        if (item1->getStockAmount() != item2->getStockAmount()) {
+            return item1->getStockAmount() < item2->getStockAmount();
+        }
+        return item1->getStockCode() < item2->getStockCode();
+    };
+
+    vector<StockItem *> expected;
+    for (int i = 0; i < inv.getSize(); i++) {
+        expected.push_back(inv[i]);
+    }
+
+    Clock::time_point start = Clock::now();
+    stable_sort(expected.begin(), expected.end(), comparisionMethod);
+    cout << "  comparison  " << fixed << setprecision(3)
+         << secondsSince(start) << "s" << endl;
+
+    vector<SortKey> keys = {SortField::ComponentType, SortField::UnitPrice,
+                            SortField::StockAmount, SortField::StockCode};
+    unsigned int maxThreads = max(1u, thread::hardware_concurrency());
+
+    for (unsigned int threads = 1; threads <= maxThreads; threads *= 2) {
+        Inventory sorted = inv;
+
+        start = Clock::now();
+        sorted.sortBy(keys, threads);
+        cout << "  packed/" << left << setw(4) << threads << right
+             << secondsSince(start) << "s";
+
+        bool identical = true;
+        for (int i = 0; i < sorted.getSize() && identical; i++) {
+            identical = sorted[i]->getStockCode() ==
+                        expected[i]->getStockCode();
+        }
+
+        cout << "  identical: " << checkResult(identical) << endl;
+    }
+}
+
+/**
+ * Times the aggregation kernels, scalar and vectorised, against loops that
+ * search and cast each item, and checks that every way gives exactly the
+ * same results. A small inventory whose size is not a multiple of the
+ * vector width is checked too.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkAggregate(size_t itemCount) {
+    // Results of each aggregate
+    struct Aggregates {
+        long long npnStock;
+        double resistance;
+        size_t aboveTen;
+        long long stockValue;
+        int maxStockAmount;
+
+        bool operator==(const Aggregates &aggregates) const {
+            return npnStock == aggregates.npnStock &&
+                   resistance == aggregates.resistance &&
+                   aboveTen == aggregates.aboveTen &&
+                   stockValue == aggregates.stockValue &&
+                   maxStockAmount == aggregates.maxStockAmount;
+        }
+    };
+
+    // Filters on the device type alone, which must still only include
+    // transistors
+    ColumnFilter npnTransistors;
+    npnTransistors.matchDeviceType = true;
+    npnTransistors.deviceType = DeviceType::NPN;
+
+    ColumnFilter resistorsInStock;
+    resistorsInStock.matchComponentType = true;
+    resistorsInStock.componentType = ComponentType::Resistor;
+    resistorsInStock.inStockOnly = true;
+
+    const int REPEATS = 10;
+    SimdLevel supportedLevel = getSupportedSimdLevel();
+
+    for (size_t size : {min<size_t>(1003, itemCount), itemCount}) {
+        Inventory inv = loadSyntheticInventory(size);
+        const StockColumns &columns = inv.getColumns();
+
+        cout << "Aggregate (" << size << " items, " << REPEATS
+             << " repeats)" << endl;
+
+        // Aggregates through the item pointers, as the questions originally
+        // did
+        Clock::time_point start = Clock::now();
+        Aggregates expected;
+
+        for (int repeat = 0; repeat < REPEATS; repeat++) {
+            expected = {0, 0, 0, 0, 0};
+
+            for (StockItem *item : inv.search("Transistor")) {
+                Transistor *transistor = dynamic_cast<Transistor *>(item);
+
+                if (transistor->getDeviceType() == DeviceType::NPN) {
+                    expected.npnStock += transistor->getStockAmount();
+                }
+            }
+
+            for (StockItem *item : inv.search("Resistor")) {
+                Resistor *resistor = dynamic_cast<Resistor *>(item);
+
+                if (resistor->getStockAmount() > 0) {
+                    expected.resistance += resistor->getResistance();
+                }
+            }
+
+            // Column order, so the resistances are added in the same order
+            for (uint32_t slot = 0; slot < columns.getSize(); slot++) {
+                StockItem *item = inv.getItemInSlot(slot);
+
+                expected.aboveTen += item->getUnitPrice() > 10;
+                expected.stockValue +=
+                        static_cast<long long>(item->getStockAmount()) *
+                        item->getUnitPrice();
+                expected.maxStockAmount = max(expected.maxStockAmount,
+                                              item->getStockAmount());
+            }
+        }
+
+        cout << "  items       " << fixed << setprecision(4)
+             << secondsSince(start) << "s" << endl;
+
+        for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::AVX2}) {
+            if (level == SimdLevel::AVX2 && supportedLevel != level) {
+                cout << "  avx2        unsupported" << endl;
+                continue;
+            }
+
+            setSimdLevel(level);
+
+            start = Clock::now();
+            Aggregates result;
+
+            for (int repeat = 0; repeat < REPEATS; repeat++) {
+                int minStockAmount;
+                result.npnStock = sumStockAmounts(columns, npnTransistors);
+                result.resistance = sumValues(columns, resistorsInStock);
+                result.aboveTen = countPricesAbove(columns, 10);
+                result.stockValue = sumStockValues(columns, ColumnFilter());
+                findStockAmountRange(columns, minStockAmount,
+                                     result.maxStockAmount);
+            }
+
+            cout << "  " << left << setw(12)
+                 << (level == SimdLevel::AVX2 ? "avx2" : "scalar") << right
+                 << secondsSince(start) << "s  identical: "
+                 << checkResult(result == expected) << endl;
+        }
+
+        setSimdLevel(supportedLevel);
+    }
+}
+
+/**
+ * Times queries run with the plan the planner picks against the same
+ * queries run as full scans, checking both give the same items and
+ * aggregate, and still do once items have been removed.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkQuery(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    cout << "Query (" << itemCount << " items)" << endl;
+
+    vector<Query> queries(6);
+    queries[0].where(QueryField::StockCode, Comparison::Equal,
+                     string(inv[inv.getSize() / 2]->getStockCode()));
+    queries[1].where(QueryField::UnitPrice, Comparison::GreaterEqual, 100)
+              .where(QueryField::UnitPrice, Comparison::LessEqual, 101)
+              .where(QueryField::StockAmount, Comparison::Greater, 500)
+              .aggregate(Aggregate::Sum, QueryField::StockAmount);
+    queries[2].where(QueryField::Resistance, Comparison::GreaterEqual, 1.0E4)
+              .where(QueryField::StockAmount, Comparison::Greater, 0)
+              .aggregate(Aggregate::Sum, QueryField::Resistance);
+    queries[3].where(QueryField::DeviceType, Comparison::Equal, "NPN")
+              .aggregate(Aggregate::Sum, QueryField::StockAmount);
+    queries[4].where(QueryField::Description, Comparison::Contains, "op-amp")
+              .aggregate(Aggregate::Count);
+    queries[5].where(QueryField::StockAmount, Comparison::Greater, 990)
+              .aggregate(Aggregate::Max, QueryField::UnitPrice);
+
+    for (const Query &query : queries) {
+        QueryPlan plan = query.plan(inv);
+        QueryPlan scanPlan = plan;
+        scanPlan.accessPath = AccessPath::FullScan;
+
+        Clock::time_point start = Clock::now();
+        QueryResult planned = query.run(inv, plan);
+        double plannedSeconds = secondsSince(start);
+
+        start = Clock::now();
+        QueryResult scanned = query.run(inv, scanPlan);
+        double scanSeconds = secondsSince(start);
+
+        bool identical = planned.slots == scanned.slots &&
+                         planned.aggregate == scanned.aggregate;
+
+        cout << "  " << left << setw(48) << plan.describe() << right
+             << fixed << setprecision(3) << setw(9)
+             << plannedSeconds * 1.0E3 << " ms  scan " << setw(9)
+             << scanSeconds * 1.0E3 << " ms  identical: "
+             << checkResult(identical) << endl;
+    }
+
+    // Removes every 97th item, so the items after each move down a slot.
+    // Every plan must then still find the same items in the same order as
+    // a full scan, including one reading only the resistors.
+    vector<StockItem *> removedItems;
+
+    for (int slot = 0; slot < inv.getSize(); slot += 97) {
+        removedItems.push_back(inv.getItemInSlot(slot));
+    }
+
+    inv.remove(removedItems);
+
+    queries.emplace_back();
+    queries.back().where(QueryField::ComponentType, Comparison::Equal,
+                         "Resistor");
+    bool removedIdentical = true;
+
+    for (const Query &query : queries) {
+        QueryPlan plan = query.plan(inv);
+        QueryPlan scanPlan = plan;
+        scanPlan.accessPath = AccessPath::FullScan;
+
+        QueryResult planned = query.run(inv, plan);
+        QueryResult scanned = query.run(inv, scanPlan);
+        removedIdentical = removedIdentical &&
+                           planned.slots == scanned.slots &&
+                           planned.aggregate == scanned.aggregate;
+    }
+
+    cout << "  every plan after removal identical: "
+         << checkResult(removedIdentical) << endl;
+
+    // The NPN stock total must agree with the aggregation kernel
+    ColumnFilter npnTransistors;
+    npnTransistors.matchComponentType = true;
+    npnTransistors.componentType = ComponentType::Transistor;
+    npnTransistors.matchDeviceType = true;
+    npnTransistors.deviceType = DeviceType::NPN;
+
+    cout << "  NPN total matches kernel: "
+         << checkResult(queries[3].run(inv).aggregate ==
+                        sumStockAmounts(inv.getColumns(), npnTransistors))
+         << endl;
+}
+
+/**
+ * Times finding the top and bottom k items with bounded heaps against
+ * sorting every item and keeping the first k, checking both find the same
+ * items in the same order.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkTopK(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    cout << "Top k (" << itemCount << " items)" << endl;
+
+    ColumnFilter resistorsInStock;
+    resistorsInStock.matchComponentType = true;
+    resistorsInStock.componentType = ComponentType::Resistor;
+    resistorsInStock.inStockOnly = true;
+
+    // Lambda for reading a key of an item
+    auto keyOf = [](StockItem *item, SortField key) -> string {
+        ostringstream stream;
+        if (key == SortField::UnitPrice) {
+            stream << setw(12) << item->getUnitPrice();
+        } else if (key == SortField::StockAmount) {
+            stream << setw(12) << item->getStockAmount();
+        } else {
+            stream << item->getStockCode();
+        }
+        return stream.str();
+    };
+
+    struct Case {
+        SortField key;
+        bool largest;
+        size_t k;
+        bool filtered;
+    };
+
+    vector<Case> cases = {{SortField::UnitPrice, true, 1, false},
+                          {SortField::UnitPrice, true, 20, false},
+                          {SortField::UnitPrice, false, 1000, false},
+                          {SortField::StockAmount, true, 20, true},
+                          {SortField::StockCode, false, 20, false}};
+
+    for (const Case &test : cases) {
+        ColumnFilter filter = test.filtered ? resistorsInStock
+                                            : ColumnFilter();
+
+        Clock::time_point start = Clock::now();
+        vector<StockItem *> selected =
+                test.largest ? inv.topK(test.key, test.k, filter)
+                             : inv.bottomK(test.key, test.k, filter);
+        double selectSeconds = secondsSince(start);
+
+        // Sorts the items' keys once before timing the sort itself
+        vector<pair<string, StockItem *>> keyed;
+        for (int i = 0; i < inv.getSize(); i++) {
+            StockItem *item = inv[i];
+
+            if (passesFilter(inv.getColumns(), filter, item->getSlot())) {
+                keyed.emplace_back(keyOf(item, test.key), item);
+            }
+        }
+
+        start = Clock::now();
+        stable_sort(keyed.begin(), keyed.end(),
+                    [&test](const pair<string, StockItem *> &item1,
+                            const pair<string, StockItem *> &item2) {
+                        return test.largest ? item1.first > item2.first
+                                            : item1.first < item2.first;
+                    });
+        double sortSeconds = secondsSince(start);
+
+        bool identical = selected.size() == min(test.k, keyed.size());
+        for (size_t i = 0; identical && i < selected.size(); i++) {
+            identical = selected[i] == keyed[i].second;
+        }
+
+        cout << "  " << (test.largest ? "top " : "bottom ") << setw(4)
+             << test.k << " by " << setw(6)
+             << (test.key == SortField::UnitPrice ? "price"
+                 : test.key == SortField::StockAmount ? "amount" : "code")
+             << (test.filtered ? " (in stock resistors)" : "") << fixed
+             << setprecision(3) << "  select " << selectSeconds * 1.0E3
+             << " ms  sort " << sortSeconds * 1.0E3 << " ms  identical: "
+             << checkResult(identical) << endl;
+    }
+}
+
+/**
+ * Times finding in stock resistors in a resistance range and the nearest in
+ * stock resistor to a value through the resistance index, against searching
+ * and casting every resistor, checking both find the same items.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkParametric(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    const int REPEATS = 100;
+
+    cout << "Parametric (" << itemCount << " items, " << REPEATS
+         << " repeats)" << endl;
+
+    // Resistors between 9K5 and 10K5 in stock, by scanning and by index
+    Clock::time_point start = Clock::now();
+    vector<StockItem *> scanned;
+
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+        scanned.clear();
+
+        for (StockItem *item : inv.search("Resistor")) {
+            Resistor *resistor = dynamic_cast<Resistor *>(item);
+
+            if (resistor->getStockAmount() > 0 &&
+                resistor->getResistance() >= 9500 &&
+                resistor->getResistance() <= 10500) {
+                scanned.push_back(resistor);
+            }
+        }
+    }
+
+    double scanSeconds = secondsSince(start);
+
+    start = Clock::now();
+    vector<StockItem *> indexed;
+
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+        indexed = inv.searchValueRange(ComponentType::Resistor, 9500, 10500,
+                                       true);
+    }
+
+    double indexSeconds = secondsSince(start);
+
+    // Items of equal resistance are in slot order, so sorting by slot
+    // gives the order of the scan
+    sort(indexed.begin(), indexed.end(), [](StockItem *item1,
+                                            StockItem *item2) {
+        return item1->getSlot() < item2->getSlot();
+    });
+
+    cout << "  range       scan " << fixed << setprecision(3)
+         << scanSeconds / REPEATS * 1.0E3 << " ms  index "
+         << indexSeconds / REPEATS * 1.0E3 << " ms  identical: "
+         << checkResult(scanned == indexed) << endl;
+
+    // Nearest in stock resistor to a few values, by scanning and by index
+    bool identical = true;
+    scanSeconds = 0;
+    indexSeconds = 0;
+
+    for (double value : {0.5, 1.0, 2000.0, 9500.0, 5.0E6}) {
+        start = Clock::now();
+        StockItem *nearest = nullptr;
+        double nearestDistance = 0;
+
+        for (StockItem *item : inv.search("Resistor")) {
+            Resistor *resistor = dynamic_cast<Resistor *>(item);
+            double distance = fabs(log(resistor->getResistance() / value));
+
+            if (resistor->getStockAmount() > 0 &&
+                (nearest == nullptr || distance < nearestDistance)) {
+                nearest = resistor;
+                nearestDistance = distance;
+            }
+        }
+
+        scanSeconds += secondsSince(start);
+
+        start = Clock::now();
+        StockItem *found = inv.findNearestValue(ComponentType::Resistor,
+                                                value);
+        indexSeconds += secondsSince(start);
+
+        // Equally near resistors may differ, but not their resistance
+        identical &= found != nullptr &&
+                     dynamic_cast<Resistor *>(found)->getResistance() ==
+                     dynamic_cast<Resistor *>(nearest)->getResistance();
+    }
+
+    cout << "  nearest     scan " << scanSeconds / 5 * 1.0E3
+         << " ms  index " << indexSeconds / 5 * 1.0E3
+         << " ms  identical: " << checkResult(identical) << endl;
+}
+
+/**
+ * Times searching the descriptions of a catalogue of integrated circuits
+ * for terms, prefixes and text through the description index, against
+ * reading every description, checking both find the same items. Some
+ * descriptions are then changed, checking the index keeps up.
+ *
+ * @param itemCount         amount of integrated circuits in the inventory
+ */
+void benchmarkDescription(size_t itemCount) {
+    const char *widths[] = {"4-bit", "8-bit", "16-bit", "Dual", "Quad",
+                            "Low power", "JFET", "CMOS"};
+    const char *functions[] = {"counter", "op-amp", "timer", "comparator",
+                               "shift register", "decoder", "multiplexer",
+                               "voltage regulator", "flip-flop", "latch"};
+    const char *makers[] = {"LM", "NE", "TL", "CD", "SN", "MC", "XR", "UA"};
+
+    // Fixed seed so every run benchmarks the same inventory
+    mt19937 random(2018);
+
+    // Lambda for making a random description, such as "Quad op-amp LM3240"
+    auto describe = [&]() {
+        return string(widths[random() % 8]) + " " +
+               functions[random() % 10] + " " + makers[random() % 8] +
+               to_string(random() % 10000);
+    };
+
+    Inventory inv;
+    inv.reserve(itemCount);
+
+    Clock::time_point start = Clock::now();
+    for (size_t i = 0; i < itemCount; i++) {
+        inv.create<IntegratedCircuit>("IC_" + to_string(i), 1, 10,
+                                      describe());
+    }
+    double loadSeconds = secondsSince(start);
+
+    cout << "Description (" << itemCount << " integrated circuits, indexed "
+         << "in " << fixed << setprecision(3) << loadSeconds << " s)"
+         << endl;
+
+    // Lambda for splitting text into lower case words, keeping a * which
+    // ends a word
+    auto wordsOf = [](const string &text) {
+        vector<string> words;
+        string word;
+
+        for (char character : text + " ") {
+            if (isalnum(static_cast<unsigned char>(character))) {
+                word += tolower(static_cast<unsigned char>(character));
+            } else if (!word.empty()) {
+                words.push_back(character == '*' ? word + "*" : word);
+                word.clear();
+            }
+        }
+
+        return words;
+    };
+
+    // Lambda for checking whether a description has every term of a search
+    // (or any), terms ending in * being prefixes
+    auto hasTerms = [&wordsOf](const string &description,
+                               const string &terms, bool any) {
+        vector<string> words = wordsOf(description);
+
+        for (string term : wordsOf(terms)) {
+            bool prefix = term.back() == '*';
+            if (prefix) {
+                term.pop_back();
+            }
+
+            bool found = false;
+            for (const string &word : words) {
+                found |= prefix ? word.compare(0, term.size(), term) == 0
+                                : word == term;
+            }
+
+            if (found == any) {
+                return any;
+            }
+        }
+
+        return !any;
+    };
+
+    // Lambda for searching by reading every description
+    auto scan = [&inv, &hasTerms](const string &search, int mode) {
+        vector<StockItem *> results;
+        string lower = DescriptionIndex::toLower(search);
+
+        for (StockItem *item : inv.search(ComponentType::IntegratedCircuit)) {
+            string description(static_cast<IntegratedCircuit *>(item)
+                                       ->getDescription());
+
+            if (mode == 2 ? DescriptionIndex::toLower(description)
+                                    .find(lower) != string::npos
+                          : hasTerms(description, search, mode == 1)) {
+                results.push_back(item);
+            }
+        }
+
+        return results;
+    };
+
+    // Lambda for searching through the index
+    auto indexed = [&inv](const string &search, int mode) {
+        return mode == 2 ? inv.searchDescriptionText(search)
+                         : inv.searchDescriptions(search, mode == 1
+                                                          ? TermMatch::Any
+                                                          : TermMatch::All);
+    };
+
+    // Searches, by terms (mode 0), any term (mode 1) or text (mode 2)
+    vector<pair<string, int>> searches = {
+            {"quad op-amp", 0}, {"lm3240", 0}, {"cmos count*", 0},
+            {"tl*", 0}, {"xr1234 ua4321", 1}, {"amp LM32", 2},
+            {"register sn99", 2}};
+
+    bool identical = true;
+
+    for (const pair<string, int> &search : searches) {
+        start = Clock::now();
+        vector<StockItem *> scanned = scan(search.first, search.second);
+        double scanSeconds = secondsSince(start);
+
+        start = Clock::now();
+        vector<StockItem *> found = indexed(search.first, search.second);
+        double indexSeconds = secondsSince(start);
+
+        identical &= scanned == found;
+
+        cout << "  " << left << setw(20)
+             << (search.second == 2 ? "\"" + search.first + "\""
+                                    : search.second == 1
+                                      ? "any " + search.first
+                                      : search.first)
+             << right << setw(8) << found.size() << " items  scan "
+             << setprecision(3) << scanSeconds * 1.0E3 << " ms  index "
+             << indexSeconds * 1.0E6 << " us  identical: "
+             << checkResult(scanned == found) << endl;
+    }
+
+    // Changes a tenth of the descriptions, which the index follows
+    const vector<StockItem *> &items =
+            inv.search(ComponentType::IntegratedCircuit);
+    for (size_t i = 0; i < items.size(); i += 10) {
+        static_cast<IntegratedCircuit *>(items[i])->setDescription(
+                describe());
+    }
+
+    for (const pair<string, int> &search : searches) {
+        identical &= scan(search.first, search.second) ==
+                     indexed(search.first, search.second);
+    }
+
+    cout << "  after changing descriptions, identical: "
+         << checkResult(identical) << endl;
+}
+
+/**
+ * Allocator counting the bytes allocated through it, to measure the memory
+ * of a standard container
+ */
+template <typename T>
+struct CountingAllocator {
+    typedef T value_type;
+
+    // Bytes allocated and not yet freed, shared by every copy
+    size_t *allocated;
+
+    explicit CountingAllocator(size_t *allocated) : allocated(allocated) {}
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U> &allocator)
+            : allocated(allocator.allocated) {}
+
+    T *allocate(size_t count) {
+        *this->allocated += count * sizeof(T);
+        return allocator<T>().allocate(count);
+    }
+
+    void deallocate(T *pointer, size_t count) {
+        *this->allocated -= count * sizeof(T);
+        allocator<T>().deallocate(pointer, count);
+    }
+
+    template <typename U>
+    bool operator==(const CountingAllocator<U> &allocator) const {
+        return this->allocated == allocator.allocated;
+    }
+
+    template <typename U>
+    bool operator!=(const CountingAllocator<U> &allocator) const {
+        return this->allocated != allocator.allocated;
+    }
+};
+
+/**
+ * Times completing partial stock codes and finding the codes near mistyped
+ * ones through the code trie, against computing the edit distance to every
+ * code, checking both find the same items in the same order. The memory of
+ * the trie is compared with a map of the codes, and some codes and amounts
+ * are then changed, checking the trie keeps up.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkCodes(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    const size_t LIMIT = 10;
+
+    cout << "Codes (" << itemCount << " items, top " << LIMIT << ")"
+         << endl;
+
+    // Lambda for the least edits (inserting, removing or replacing a
+    // character, or swapping two neighbouring ones) turning a code into
+    // another, or into any start of another when matching prefixes
+    auto editDistance = [](const string &code, const string &other,
+                           bool matchPrefix) {
+        size_t width = code.size() + 1;
+        vector<unsigned int> rows(width * (other.size() + 1));
+
+        for (size_t j = 0; j < width; j++) {
+            rows[j] = j;
+        }
+
+        unsigned int best = rows[width - 1];
+
+        for (size_t i = 1; i <= other.size(); i++) {
+            unsigned int *row = &rows[i * width];
+            unsigned int *previous = row - width;
+            row[0] = i;
+
+            for (size_t j = 1; j < width; j++) {
+                row[j] = min({previous[j] + 1, row[j - 1] + 1,
+                              previous[j - 1] +
+                              (code[j - 1] != other[i - 1])});
+
+                if (i > 1 && j > 1 && code[j - 1] == other[i - 2] &&
+                    code[j - 2] == other[i - 1]) {
+                    row[j] = min(row[j], (previous - width)[j - 2] + 1);
+                }
+            }
+
+            best = matchPrefix ? min(best, row[width - 1]) : row[width - 1];
+        }
+
+        return best;
+    };
+
+    // Lambda for searching by reading every code, ranking the matches by
+    // stock amount and then code
+    auto scan = [&inv, &editDistance, LIMIT](const string &code,
+                                            int maxDistance,
+                                            bool matchPrefix) {
+        vector<StockItem *> results;
+
+        for (int i = 0; i < inv.getSize(); i++) {
+            string stockCode(inv[i]->getStockCode());
+
+            if (maxDistance < 0
+                ? stockCode.compare(0, code.size(), code) == 0
+                : editDistance(code, stockCode, matchPrefix) <=
+                  static_cast<unsigned int>(maxDistance)) {
+                results.push_back(inv[i]);
+            }
+        }
+
+        sort(results.begin(), results.end(), [](StockItem *item1,
+                                                 StockItem *item2) {
+            return item1->getStockAmount() != item2->getStockAmount()
+                   ? item1->getStockAmount() > item2->getStockAmount()
+                   : item1->getStockCode() < item2->getStockCode();
+        });
+        results.resize(min(results.size(), LIMIT));
+
+        return results;
+    };
+
+    // Lambda for searching through the trie
+    auto indexed = [&inv, LIMIT](const string &code, int maxDistance,
+                                 bool matchPrefix) {
+        return maxDistance < 0
+               ? inv.searchCodePrefix(code, LIMIT)
+               : inv.searchCodeFuzzy(code, maxDistance, matchPrefix, LIMIT);
+    };
+
+    // Searches, each a code, edit distance (-1 for a prefix) and whether
+    // a start of each code is matched
+    struct Search {
+        string code;
+        int maxDistance;
+        bool matchPrefix;
+    };
+
+    vector<Search> searches = {
+            {"RES_1", -1, false}, {"CAP_99", -1, false},
+            {"IC_12345", -1, false}, {"D", -1, false},
+            {"RES_1235", 1, false}, {"CPA_12346", 1, false},
+            {"TRN_1238", 2, false}, {"RSE_123", 1, true},
+            {"CAP_1234", 1, true}};
+
+    bool identical = true;
+
+    for (const Search &search : searches) {
+        Clock::time_point start = Clock::now();
+        vector<StockItem *> scanned = scan(search.code, search.maxDistance,
+                                           search.matchPrefix);
+        double scanSeconds = secondsSince(start);
+
+        start = Clock::now();
+        vector<StockItem *> found = indexed(search.code, search.maxDistance,
+                                            search.matchPrefix);
+        double indexSeconds = secondsSince(start);
+
+        identical &= scanned == found;
+
+        cout << "  " << left << setw(20)
+             << (search.maxDistance < 0
+                 ? search.code + "*"
+                 : search.code + (search.matchPrefix ? "* ~" : " ~") +
+                   to_string(search.maxDistance))
+             << right << " scan " << fixed << setprecision(3)
+             << scanSeconds * 1.0E3 << " ms  trie " << setprecision(1)
+             << indexSeconds * 1.0E6 << " us  identical: "
+             << checkResult(scanned == found) << endl;
+    }
+
+    // Memory of the trie against a map of the same codes
+    size_t mapBytes = 0;
+    {
+        typedef pair<const string, uint32_t> Entry;
+        map<string, uint32_t, less<string>, CountingAllocator<Entry>> codes(
+                (CountingAllocator<Entry>(&mapBytes)));
+
+        for (int i = 0; i < inv.getSize(); i++) {
+            codes.emplace(inv[i]->getStockCode(), inv[i]->getSlot());
+        }
+
+        mapBytes += sizeof(codes);
+        cout << "  memory      trie " << setprecision(1)
+             << static_cast<double>(inv.getCodeTrie().getMemoryUsage()) /
+                inv.getSize()
+             << " B/code  map " << static_cast<double>(mapBytes) /
+                                   inv.getSize() << " B/code" << endl;
+    }
+
+    // Changes some amounts and codes, which the trie follows
+    for (int i = 0; i < inv.getSize(); i += 7) {
+        inv[i]->setStockAmount((inv[i]->getStockAmount() * 31) % 1000);
+
+        if (i % 3 == 0) {
+            inv[i]->setStockCode(string(inv[i]->getStockCode()) + "X");
+        }
+    }
+
+    for (const Search &search : searches) {
+        identical &= scan(search.code, search.maxDistance,
+                          search.matchPrefix) ==
+                     indexed(search.code, search.maxDistance,
+                             search.matchPrefix);
+    }
+
+    cout << "  after changing codes and amounts, identical: "
+         << checkResult(identical) << endl;
+}
+
+/**
+ * Times questions 3 and 4 and printing every item over a table of stock
+ * records, against the stock items of the inventory reached through
+ * pointers, both with a dynamic_cast to each component type (as the
+ * questions were first answered) and with a switch on the component type
+ * and a static_cast. Each answer is checked against the inventory's columns.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkRecords(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+    const vector<StockItem *> &items = inv.getColumns().getItems();
+
+    const int REPEATS = 10;
+
+    Clock::time_point start = Clock::now();
+    StockRecordTable records(items);
+    double copySeconds = secondsSince(start);
+
+    cout << "Records (" << itemCount << " items, " << REPEATS
+         << " repeats, " << sizeof(StockRecord) << " B/record, copied in "
+         << fixed << setprecision(3) << copySeconds << " s)" << endl;
+
+    ColumnFilter npnTransistors;
+    npnTransistors.matchComponentType = true;
+    npnTransistors.componentType = ComponentType::Transistor;
+    npnTransistors.matchDeviceType = true;
+    npnTransistors.deviceType = DeviceType::NPN;
+
+    ColumnFilter resistorsInStock;
+    resistorsInStock.matchComponentType = true;
+    resistorsInStock.componentType = ComponentType::Resistor;
+    resistorsInStock.inStockOnly = true;
+
+    long long expectedStock = sumStockAmounts(inv.getColumns(),
+                                              npnTransistors);
+    double expectedResistance = sumValues(inv.getColumns(),
+                                          resistorsInStock);
+
+    // Lambda for timing a way of answering a question, checking it gives
+    // the expected answer
+    auto time = [REPEATS](const char *name, double expected,
+                          auto answer) {
+        double answered = 0;
+        Clock::time_point start = Clock::now();
+
+        for (int repeat = 0; repeat < REPEATS; repeat++) {
+            answered = answer();
+        }
+
+        double seconds = secondsSince(start);
+
+        cout << "  " << left << setw(24) << name << right << setprecision(3)
+             << seconds / REPEATS * 1.0E3 << " ms  identical: "
+             << checkResult(answered == expected) << endl;
+
+        return seconds;
+    };
+
+    // Question 3, NPN transistors in stock
+    double castSeconds = time("npn dynamic_cast", expectedStock, [&items]() {
+        long long totalStock = 0;
+
+        for (StockItem *item : items) {
+            Transistor *transistor = dynamic_cast<Transistor *>(item);
+
+            if (transistor != nullptr &&
+                transistor->getDeviceType() == DeviceType::NPN) {
+                totalStock += transistor->getStockAmount();
+            }
+        }
+
+        return static_cast<double>(totalStock);
+    });
+
+    double switchSeconds = time("npn switch", expectedStock, [&items]() {
+        long long totalStock = 0;
+
+        for (StockItem *item : items) {
+            if (item->getType() == ComponentType::Transistor &&
+                static_cast<Transistor *>(item)->getDeviceType() ==
+                DeviceType::NPN) {
+                totalStock += item->getStockAmount();
+            }
+        }
+
+        return static_cast<double>(totalStock);
+    });
+
+    double recordSeconds = time("npn records", expectedStock, [&]() {
+        return static_cast<double>(records.sumStockAmounts(npnTransistors));
+    });
+
+    cout << "  records speedup " << setprecision(1)
+         << castSeconds / recordSeconds << "x over dynamic_cast, "
+         << switchSeconds / recordSeconds << "x over switch" << endl;
+
+    // Question 4, total resistance of resistors in stock
+    castSeconds = time("resistance dynamic_cast", expectedResistance,
+                       [&items]() {
+        double totalResistance = 0;
+
+        for (StockItem *item : items) {
+            Resistor *resistor = dynamic_cast<Resistor *>(item);
+
+            if (resistor != nullptr && resistor->getStockAmount() > 0) {
+                totalResistance += resistor->getResistance();
+            }
+        }
+
+        return totalResistance;
+    });
+
+    switchSeconds = time("resistance switch", expectedResistance,
+                         [&items]() {
+        double totalResistance = 0;
+
+        for (StockItem *item : items) {
+            if (item->getType() == ComponentType::Resistor &&
+                item->getStockAmount() > 0) {
+                totalResistance +=
+                        static_cast<Resistor *>(item)->getResistance();
+            }
+        }
+
+        return totalResistance;
+    });
+
+    recordSeconds = time("resistance records", expectedResistance, [&]() {
+        return records.sumValues(resistorsInStock);
+    });
+
+    cout << "  records speedup " << setprecision(1)
+         << castSeconds / recordSeconds << "x over dynamic_cast, "
+         << switchSeconds / recordSeconds << "x over switch" << endl;
+
+    // Printing every item, through the virtual print or the switch
+    ostringstream printedItems;
+    start = Clock::now();
+    for (StockItem *item : items) {
+        printedItems << *item << '\n';
+    }
+    double virtualSeconds = secondsSince(start);
+
+    ostringstream printedRecords;
+    start = Clock::now();
+    for (const StockRecord &record : records) {
+        records.print(printedRecords, record) << '\n';
+    }
+    recordSeconds = secondsSince(start);
+
+    cout << "  print       virtual " << setprecision(3) << virtualSeconds
+         << " s  switch " << recordSeconds << " s  identical: "
+         << checkResult(printedItems.str() == printedRecords.str())
+         << endl;
+}
+
+/**
+ * Measures the memory of loading an inventory: the size of each stock item
+ * class, the allocations made while loading, and the heap in use per item
+ * once loaded (the items, their columns and every index)
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkMemory(size_t itemCount) {
+    string file = (filesystem::temp_directory_path() /
+                   "stock_benchmark_inventory.txt").string();
+    writeSyntheticInventory(file, itemCount);
+
+    cout << "Memory (" << itemCount << " items)" << endl
+         << "  item sizes  resistor " << sizeof(Resistor) << " B  capacitor "
+         << sizeof(Capacitor) << " B  diode " << sizeof(Diode)
+         << " B  transistor " << sizeof(Transistor) << " B  IC "
+         << sizeof(IntegratedCircuit) << " B" << endl;
+
+    size_t heapBefore = mallinfo2().uordblks;
+    size_t allocationsBefore = allocationCount;
+    size_t bytesBefore = allocatedBytes;
+
+    Clock::time_point start = Clock::now();
+    Inventory inv = readParallelInventoryFile(file, 1);
+    double loadSeconds = secondsSince(start);
+
+    size_t heapAfter = mallinfo2().uordblks;
+
+    cout << "  load        " << fixed << setprecision(3) << loadSeconds
+         << " s  " << allocationCount - allocationsBefore
+         << " allocations  " << setprecision(1)
+         << static_cast<double>(allocatedBytes - bytesBefore) / itemCount
+         << " B/item allocated" << endl
+         << "  in use      "
+         << static_cast<double>(heapAfter - heapBefore) / itemCount
+         << " B/item" << endl;
+
+    filesystem::remove(file);
+}
+
+/**
+ * Times writing a report of every item to a file through the report
+ * writer, against streaming each item with its output operator and endl (as
+ * the inventory's output operator did), checking both files are the same
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkReport(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    filesystem::path directory = filesystem::temp_directory_path();
+    string streamedFile = (directory / "stock_benchmark_streamed.txt")
+            .string();
+    string writtenFile = (directory / "stock_benchmark_written.txt")
+            .string();
+
+    // Streams each line and flushes it
+    Clock::time_point start = Clock::now();
+    {
+        ofstream os(streamedFile);
+        os << "Inventory Size: " << inv.getSize() << endl << endl;
+
+        for (int i = 0; i < inv.getSize(); i++) {
+            os << *inv[i] << endl;
+        }
+    }
+    double streamSeconds = secondsSince(start);
+
+    // Formats into the writer's buffer
+    start = Clock::now();
+    {
+        ofstream os(writtenFile);
+        os << inv;
+    }
+    double writerSeconds = secondsSince(start);
+
+    // Lambda for reading a whole file
+    auto readFile = [](const string &file) {
+        ifstream is(file, ios::binary);
+        return string(istreambuf_iterator<char>(is),
+                      istreambuf_iterator<char>());
+    };
+
+    string streamed = readFile(streamedFile);
+    bool identical = streamed == readFile(writtenFile);
+    double megabytes = streamed.size() / 1.0E6;
+
+    filesystem::remove(streamedFile);
+    filesystem::remove(writtenFile);
+
+    cout << "Report (" << itemCount << " items, " << fixed
+         << setprecision(1) << megabytes << " MB)" << endl
+         << "  stream      " << setprecision(3) << streamSeconds << " s  "
+         << setprecision(1) << megabytes / streamSeconds << " MB/s" << endl
+         << "  writer      " << setprecision(3) << writerSeconds << " s  "
+         << setprecision(1) << megabytes / writerSeconds << " MB/s  "
+         << setprecision(1) << streamSeconds / writerSeconds << "x"
+         << endl
+         << "  identical: " << checkResult(identical) << endl;
+}
+
+/**
+ * Runs threads totalling the stock of the whole inventory for a fixed time,
+ * while a writer moves stock between items in batches, so the total never
+ * changes. Readers query through snapshots of a shared inventory, then
+ * through an inventory behind a single lock that the writer changes in
+ * place. Reports queries/sec for each, the versions the writer published
+ * and whether every query saw the unchanged total.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkConcurrent(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+    long long totalStock = sumStockAmounts(inv.getColumns(), ColumnFilter());
+
+    // Seconds each amount of readers runs for, and moves made per batch
+    const double runSeconds = 1.0;
+    const int movesPerBatch = 1000;
+
+    // Lambda for moving one of stock between random items
+    auto moveStock = [movesPerBatch](Inventory &target, mt19937 &random) {
+        int size = target.getSize();
+
+        for (int i = 0; i < movesPerBatch; i++) {
+            StockItem *from = target[random() % size];
+            StockItem *to = target[random() % size];
+
+            if (from->getStockAmount() > 0) {
+                from->setStockAmount(from->getStockAmount() - 1);
+                to->setStockAmount(to->getStockAmount() + 1);
+            }
+        }
+    };
+
+    // Lambda for running readers and a writer until the time is up,
+    // returning the queries run
+    auto run = [runSeconds](unsigned int readerCount,
+                            const function<bool()> &query,
+                            const function<void(mt19937 &)> &write,
+                            bool &consistent) {
+        atomic<bool> stop(false);
+        atomic<size_t> queries(0);
+        atomic<bool> allConsistent(true);
+        vector<thread> readers;
+
+        for (unsigned int t = 0; t < readerCount; t++) {
+            readers.emplace_back([&]() {
+                size_t count = 0;
+
+                while (!stop.load(memory_order_relaxed)) {
+                    if (!query()) {
+                        allConsistent.store(false);
+                    }
+
+                    count++;
+                }
+
+                queries += count;
+            });
+        }
+
+        // Writes a batch every few milliseconds, as a feed of stock moves
+        thread writer([&]() {
+            mt19937 random(2018);
+
+            while (!stop.load(memory_order_relaxed)) {
+                write(random);
+                this_thread::sleep_for(chrono::milliseconds(10));
+            }
+        });
+
+        this_thread::sleep_for(chrono::duration<double>(runSeconds));
+        stop.store(true);
+
+        for (thread &reader : readers) {
+            reader.join();
+        }
+
+        writer.join();
+        consistent = consistent && allConsistent.load();
+
+        return queries.load();
+    };
+
+    Inventory lockedInv = inv;
+    ConcurrentInventory sharedInv(move(inv));
+    mutex lockedMutex;
+    bool consistent = true;
+
+    cout << "Concurrent (" << itemCount << " items, " << movesPerBatch
+         << " moves per batch)" << endl;
+
+    for (unsigned int readerCount : {1u, 2u, 4u}) {
+        uint64_t startVersion = sharedInv.getVersion();
+
+        size_t snapshotQueries = run(
+                readerCount,
+                [&]() {
+                    ConcurrentInventory::Snapshot snapshot = sharedInv.read();
+
+                    return sumStockAmounts(snapshot->getColumns(),
+                                           ColumnFilter()) == totalStock;
+                },
+                [&](mt19937 &random) {
+                    sharedInv.update([&](Inventory &next) {
+                        moveStock(next, random);
+                    });
+                },
+                consistent);
+
+        uint64_t versions = sharedInv.getVersion() - startVersion;
+
+        size_t lockedQueries = run(
+                readerCount,
+                [&]() {
+                    lock_guard<mutex> lock(lockedMutex);
+
+                    return sumStockAmounts(lockedInv.getColumns(),
+                                           ColumnFilter()) == totalStock;
+                },
+                [&](mt19937 &random) {
+                    lock_guard<mutex> lock(lockedMutex);
+                    moveStock(lockedInv, random);
+                },
+                consistent);
+
+        cout << "  " << readerCount << " reader(s)  snapshot "
+             << fixed << setprecision(0) << snapshotQueries / runSeconds
+             << " queries/s (" << versions << " versions)  lock "
+             << lockedQueries / runSeconds << " queries/s" << endl;
+    }
+
+    cout << "  retired versions left: " << sharedInv.getRetiredCount()
+         << endl
+         << "  consistent: " << checkResult(consistent) << endl;
+}
+
+/**
+ * Runs increasing amounts of threads that each place orders for one of a
+ * few popular items, reserving a unit of stock then committing it, or
+ * releasing it for every tenth order. The popular items hold too little
+ * stock for every order, so the last orders fail. Orders reserve stock by
+ * compare and swap on each item, then by checking and setting the stock
+ * amount under a single lock. Reports orders/sec for each, and whether
+ * exactly the stock there was got committed, none going below zero.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkReserve(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    // Orders placed by each thread, popular items they are placed for and
+    // stock each popular item holds
+    const int ordersPerThread = 200000;
+    const int hotItemCount = 4;
+
+    vector<string> hotCodes;
+
+    for (int i = 0; i < hotItemCount; i++) {
+        hotCodes.emplace_back(inv[(i * 7919) % inv.getSize()]->getStockCode());
+    }
+
+    // Lambda for running threads that each place their orders, returning
+    // the seconds taken and the units committed
+    auto run = [&](unsigned int threadCount,
+                   const function<bool(const string &, bool)> &order,
+                   long long &committed) {
+        atomic<long long> units(0);
+        vector<thread> threads;
+        Clock::time_point start = Clock::now();
+
+        for (unsigned int t = 0; t < threadCount; t++) {
+            threads.emplace_back([&, t]() {
+                long long count = 0;
+
+                for (int i = 0; i < ordersPerThread; i++) {
+                    const string &code = hotCodes[(i + t) % hotItemCount];
+                    bool keep = i % 10 != 0;
+
+                    if (order(code, keep) && keep) {
+                        count++;
+                    }
+                }
+
+                units += count;
+            });
+        }
+
+        for (thread &thread : threads) {
+            thread.join();
+        }
+
+        committed = units.load();
+
+        return secondsSince(start);
+    };
+
+    mutex inventoryMutex;
+    bool exact = true;
+
+    cout << "Reserve (" << itemCount << " items, " << hotItemCount
+         << " popular items, " << ordersPerThread << " orders per thread)"
+         << endl;
+
+    for (unsigned int threadCount : {1u, 2u, 4u, 8u}) {
+        // Holds stock for about four in five of the orders kept
+        int hotStock = static_cast<int>(threadCount) * ordersPerThread *
+                       9 / 10 * 4 / 5 / hotItemCount;
+        long long orders = static_cast<long long>(threadCount) *
+                           ordersPerThread;
+
+        for (const string &code : hotCodes) {
+            inv.find(code)->setStockAmount(hotStock);
+        }
+
+        long long casCommitted;
+        double casSeconds = run(
+                threadCount,
+                [&inv](const string &code, bool keep) {
+                    StockReservation reservation = inv.tryReserve(code, 1);
+
+                    if (!reservation.isPending()) {
+                        return false;
+                    }
+
+                    if (keep) {
+                        inv.commit(reservation);
+                    } else {
+                        inv.release(reservation);
+                    }
+
+                    return true;
+                },
+                casCommitted);
+
+        // Times refreshing the columns too, which the lock's orders do as
+        // they go
+        Clock::time_point syncStart = Clock::now();
+        inv.syncStockAmounts();
+        casSeconds += secondsSince(syncStart);
+
+        long long casLeft = 0;
+
+        for (const string &code : hotCodes) {
+            casLeft += inv.find(code)->getStockAmount();
+        }
+
+        exact = exact && casCommitted + casLeft ==
+                         static_cast<long long>(hotStock) * hotItemCount &&
+                casLeft == 0;
+
+        for (const string &code : hotCodes) {
+            inv.find(code)->setStockAmount(hotStock);
+        }
+
+        long long lockedCommitted;
+        double lockedSeconds = run(
+                threadCount,
+                [&inv, &inventoryMutex](const string &code, bool keep) {
+                    lock_guard<mutex> lock(inventoryMutex);
+                    StockItem *item = inv.find(code);
+
+                    if (item->getStockAmount() < 1) {
+                        return false;
+                    }
+
+                    if (keep) {
+                        item->setStockAmount(item->getStockAmount() - 1);
+                    }
+
+                    return true;
+                },
+                lockedCommitted);
+
+        exact = exact && lockedCommitted == casCommitted;
+
+        cout << "  " << threadCount << " thread(s)  cas " << fixed
+             << setprecision(0) << orders / casSeconds << " orders/s  lock "
+             << orders / lockedSeconds << " orders/s  " << setprecision(1)
+             << lockedSeconds / casSeconds << "x" << endl;
+    }
+
+    cout << "  exact: " << checkResult(exact) << endl;
+}
+
+/**
+ * Splits the inventory into 1 to 64 shards, timing loading the shards,
+ * totals, top k and component type searches fanned out across them, and
+ * threads changing unit prices of random items under the shard locks, each
+ * against the unsharded inventory. Reports the time of each and whether
+ * every sharded result matches the unsharded one.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkShards(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    // Times each query is run, and price changes made by each of the
+    // updating threads
+    const int queryRuns = 10;
+    const int updatesPerThread = 100000;
+    const unsigned int updateThreads = 4;
+
+    vector<string> codes;
+    mt19937 random(2018);
+
+    for (int i = 0; i < updatesPerThread; i++) {
+        codes.emplace_back(inv[random() % inv.getSize()]->getStockCode());
+    }
+
+    ColumnFilter resistors;
+    resistors.matchComponentType = true;
+    resistors.componentType = ComponentType::Resistor;
+
+    // Lambda for timing a query, returning milliseconds per run
+    auto time = [queryRuns](const function<void()> &query) {
+        Clock::time_point start = Clock::now();
+
+        for (int run = 0; run < queryRuns; run++) {
+            query();
+        }
+
+        return secondsSince(start) * 1000 / queryRuns;
+    };
+
+    // Lambda for timing threads making price changes, each through a
+    // function taking a stock code and a new price, returning changes/sec
+    auto timeUpdates = [&](const function<void(const string &, int)> &set) {
+        vector<thread> threads;
+        Clock::time_point start = Clock::now();
+
+        for (unsigned int t = 0; t < updateThreads; t++) {
+            threads.emplace_back([&, t]() {
+                for (int i = 0; i < updatesPerThread; i++) {
+                    set(codes[(i + t * 7919) % codes.size()], i % 1000 + 1);
+                }
+            });
+        }
+
+        for (thread &thread : threads) {
+            thread.join();
+        }
+
+        return updateThreads * updatesPerThread / secondsSince(start);
+    };
+
+    bool identical = true;
+
+    cout << "Shards (" << itemCount << " items)" << endl
+         << "  shards   load ms  value ms  count ms  top100 ms  search ms"
+            "  updates/s" << endl;
+
+    // Lambda for printing a row of timings
+    auto printRow = [](const string &shards, double loadMs, double valueMs,
+                       double countMs, double topMs, double searchMs,
+                       double updates) {
+        cout << "  " << setw(6) << shards << fixed << setprecision(1)
+             << setw(10) << loadMs << setw(10) << valueMs << setw(10)
+             << countMs << setw(11) << topMs << setw(11) << searchMs
+             << setprecision(0) << setw(11) << updates << endl;
+    };
+
+    mutex inventoryMutex;
+    double updates = timeUpdates([&](const string &code, int price) {
+        lock_guard<mutex> lock(inventoryMutex);
+        inv.find(code)->setUnitPrice(price);
+    });
+
+    // Unsharded results to check the sharded ones against, once the
+    // unsharded updates are done
+    long long totalValue = sumStockValues(inv.getColumns(), ColumnFilter());
+    size_t resistorCount = countItems(inv.getColumns(), resistors);
+    vector<StockItem *> topPrices = inv.topK(SortField::UnitPrice, 100);
+    size_t capacitorCount = inv.search(ComponentType::Capacitor).size();
+
+    printRow("none", 0,
+             time([&]() { sumStockValues(inv.getColumns(), ColumnFilter()); }),
+             time([&]() { countItems(inv.getColumns(), resistors); }),
+             time([&]() { inv.topK(SortField::UnitPrice, 100); }),
+             time([&]() { inv.search(ComponentType::Capacitor); }),
+             updates);
+
+    for (size_t shardCount : {1, 2, 4, 8, 16, 32, 64}) {
+        Clock::time_point start = Clock::now();
+        ShardedInventory sharded(inv, shardCount);
+        double loadMs = secondsSince(start) * 1000;
+
+        // Checks the shards before the updates change prices
+        vector<StockItem *> shardedTop = sharded.topK(SortField::UnitPrice,
+                                                      100);
+
+        for (size_t i = 0; i < topPrices.size(); i++) {
+            identical = identical && i < shardedTop.size() &&
+                        shardedTop[i]->getUnitPrice() ==
+                        topPrices[i]->getUnitPrice();
+        }
+
+        identical = identical &&
+                    sharded.getSize() == inv.getSize() &&
+                    sharded.sumStockValues() == totalValue &&
+                    sharded.countItems(resistors) == resistorCount &&
+                    sharded.search(ComponentType::Capacitor).size() ==
+                    capacitorCount;
+
+        double valueMs = time([&]() { sharded.sumStockValues(); });
+        double countMs = time([&]() { sharded.countItems(resistors); });
+        double topMs = time([&]() {
+            sharded.topK(SortField::UnitPrice, 100);
+        });
+        double searchMs = time([&]() {
+            sharded.search(ComponentType::Capacitor);
+        });
+
+        updates = timeUpdates([&](const string &code, int price) {
+            sharded.update(code, [price](StockItem &item) {
+                item.setUnitPrice(price);
+            });
+        });
+
+        printRow(to_string(shardCount), loadMs, valueMs, countMs, topMs,
+                 searchMs, updates);
+    }
+
+    cout << "  identical: " << checkResult(identical) << endl;
+}
+
+/**
+ * Checkpoints an inventory, then changes stock amounts and unit prices of
+ * random items with and without a write-ahead log watching it, and appends
+ * records to the log alone, reporting changes/sec and changes per sync of
+ * each. Times syncing after every change for comparison, then recovers the
+ * inventory from the snapshot and the log, with a torn record at the end,
+ * reporting records/sec and whether the recovered inventory matches.
+ * Checks too that items sharing a stock code are refused while logging and
+ * replaying.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void benchmarkLog(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    filesystem::path directory = filesystem::temp_directory_path();
+    string snapshotFile = (directory / "stock_benchmark_log.snapshot")
+            .string();
+    string logFile = (directory / "stock_benchmark.log").string();
+    filesystem::remove(logFile);
+
+    // Changes made by each run, and made syncing after every one
+    const int changeCount = 2000000;
+    const int syncedChangeCount = 2000;
+
+    vector<StockItem *> items;
+    mt19937 random(2018);
+
+    for (int i = 0; i < changeCount; i++) {
+        items.push_back(inv[random() % inv.getSize()]);
+    }
+
+    // Lambda for changing the stock amount of most items and the unit price
+    // of every tenth
+    auto change = [&items](int i) {
+        if (i % 10 == 0) {
+            items[i]->setUnitPrice(items[i]->getUnitPrice() % 1000 + 1);
+        } else {
+            items[i]->setStockAmount(items[i]->getStockAmount() + 1);
+        }
+    };
+
+    Clock::time_point start = Clock::now();
+
+    for (int i = 0; i < changeCount; i++) {
+        change(i);
+    }
+
+    double unloggedSeconds = secondsSince(start);
+
+    double loggedSeconds, appendSeconds, syncedSeconds;
+    uint64_t loggedSyncs, appendSyncs;
+
+    {
+        WriteAheadLog log(logFile);
+        log.checkpoint(inv, snapshotFile);
+        inv.watch(&log);
+
+        // Counts until every change is durable
+        start = Clock::now();
+
+        for (int i = 0; i < changeCount; i++) {
+            change(i);
+        }
+
+        log.sync();
+        loggedSeconds = secondsSince(start);
+        loggedSyncs = log.getSyncCount();
+
+        // Appends the records without changing the inventory
+        start = Clock::now();
+
+        for (int i = 0; i < changeCount; i++) {
+            log.stockAmountChanged(*items[i], 0);
+        }
+
+        log.sync();
+        appendSeconds = secondsSince(start);
+        appendSyncs = log.getSyncCount() - loggedSyncs;
+
+        start = Clock::now();
+
+        for (int i = 0; i < syncedChangeCount; i++) {
+            change(i);
+            log.sync();
+        }
+
+        syncedSeconds = secondsSince(start);
+        inv.watch(nullptr);
+    }
+
+    // Tears the last record, as a crash part way through a write would
+    {
+        ofstream tornLog(logFile, ios::binary | ios::app);
+        tornLog.write("\x20\0\0\0torn", 8);
+    }
+
+    start = Clock::now();
+    Inventory recovered = readInventorySnapshot(snapshotFile);
+    double snapshotSeconds = secondsSince(start);
+
+    size_t recordCount;
+    double replaySeconds;
+
+    {
+        WriteAheadLog log(logFile);
+        start = Clock::now();
+        recordCount = log.replay(recovered);
+        replaySeconds = secondsSince(start);
+    }
+
+    bool identical = sameInventories(inv, recovered);
+    double logMegabytes = filesystem::file_size(logFile) / 1.0E6;
+
+    // A watched inventory must refuse an item or code change sharing a
+    // stock code, and a log must refuse to replay into or watch an
+    // inventory whose codes are shared
+    int refusals = 0;
+    Inventory watched;
+    watched.addCopy(*inv[0]);
+    watched.addCopy(*inv[1]);
+
+    {
+        WriteAheadLog log(logFile);
+        watched.watch(&log);
+
+        try {
+            watched.addCopy(*inv[0]);
+        } catch (const invalid_argument &) {
+            refusals++;
+        }
+
+        try {
+            watched[1]->setStockCode(inv[0]->getStockCode());
+        } catch (const invalid_argument &) {
+            refusals++;
+        }
+
+        watched.watch(nullptr);
+        watched.addCopy(*inv[0]);
+
+        try {
+            log.replay(watched);
+        } catch (const invalid_argument &) {
+            refusals++;
+        }
+
+        try {
+            watched.watch(&log);
+        } catch (const invalid_argument &) {
+            refusals++;
+        }
+    }
+
+    bool refused = refusals == 4 && watched.getSize() == 3 &&
+                   watched[1]->getStockCode() == inv[1]->getStockCode();
+
+    filesystem::remove(snapshotFile);
+    filesystem::remove(logFile);
+
+    cout << "Log (" << itemCount << " items, " << changeCount
+         << " changes)" << endl
+         << "  unlogged    " << fixed << setprecision(0)
+         << changeCount / unloggedSeconds << " changes/s" << endl
+         << "  logged      " << changeCount / loggedSeconds
+         << " changes/s  " << changeCount / max<uint64_t>(loggedSyncs, 1)
+         << " per sync" << endl
+         << "  appends     " << changeCount / appendSeconds
+         << " records/s  " << changeCount / max<uint64_t>(appendSyncs, 1)
+         << " per sync" << endl
+         << "  each synced " << syncedChangeCount / syncedSeconds
+         << " changes/s" << endl
+         << "  recovery    snapshot " << setprecision(3) << snapshotSeconds
+         << " s  replay " << replaySeconds << " s  " << setprecision(0)
+         << recordCount / replaySeconds << " records/s  ("
+         << recordCount << " records, " << setprecision(1) << logMegabytes
+         << " MB)" << endl
+         << "  identical: " << checkResult(identical) << endl
+         << "  shared codes refused: " << checkResult(refused) << endl;
+}
+
+/**
+ * Times reloading an inventory file after changing increasing shares of its
+ * lines, incrementally against loading the whole file again, and checks
+ * that each reloaded inventory holds the same items, and finds the same
+ * items through its indexes, as the file loaded in full.
+ *
+ * @param itemCount         amount of items in the inventory file
+ */
+void benchmarkReload(size_t itemCount) {
+    string file = (filesystem::temp_directory_path() /
+                   "stock_benchmark_reload.txt").string();
+    writeSyntheticInventory(file, itemCount);
+
+    // Lines of the file, where an empty line has been removed and a line
+    // may be followed by lines inserted after it
+    vector<string> lines;
+
+    {
+        ifstream fileStream(file);
+        string line;
+
+        while (getline(fileStream, line)) {
+            lines.push_back(line);
+        }
+    }
+
+    // Lambda writing the lines back to the file
+    auto writeLines = [&lines, &file]() {
+        ofstream fileStream(file);
+
+        for (const string &line : lines) {
+            if (!line.empty()) {
+                fileStream << line << '\n';
+            }
+        }
+    };
+
+    // Lambda checking that two inventories hold the same items, in any
+    // order, and that their indexes find the same items
+    auto sameContents = [](Inventory &inv1, Inventory &inv2) {
+        if (inv1.getPriceIndex().countRange(100, 200) !=
+                    inv2.getPriceIndex().countRange(100, 200) ||
+            inv1.searchValueRange(ComponentType::Resistor, 1000, 1.0E5)
+                    .size() !=
+                    inv2.searchValueRange(ComponentType::Resistor, 1000,
+                                          1.0E5).size() ||
+            inv1.searchDescriptions("op-amp").size() !=
+                    inv2.searchDescriptions("op-amp").size() ||
+            inv1.searchCodePrefix("RES_1").size() !=
+                    inv2.searchCodePrefix("RES_1").size()) {
+            return false;
+        }
+
+        inv1.sortBy({SortField::StockCode});
+        inv2.sortBy({SortField::StockCode});
+
+        return sameInventories(inv1, inv2);
+    };
+
+    cout << "Reload (" << itemCount << " items)" << endl;
+
+    Clock::time_point start = Clock::now();
+    Inventory fullInventory = readMappedInventoryFile(file);
+    double fullSeconds = secondsSince(start);
+
+    InventoryReloader reloader(file);
+    Inventory inv;
+    start = Clock::now();
+    reloader.reload(inv);
+    double reloadSeconds = secondsSince(start);
+
+    cout << "  initial     full " << fixed << setprecision(3) << fullSeconds
+         << "s  reloader " << reloadSeconds << "s  ("
+         << reloader.getBlockCount() << " blocks)  identical: "
+         << checkResult(sameInventories(fullInventory, inv)) << endl;
+
+    mt19937 random(2018);
+    size_t newItemCount = 0;
+
+    for (double share : {0.0, 0.001, 0.01, 0.1}) {
+        size_t changeCount = lines.size() * share;
+
+        // Changes the stock amount of two in five lines, removes one,
+        // inserts a new item after one and changes the type of one
+        for (size_t i = 0; i < changeCount; i++) {
+            string &line = lines[random() % lines.size()];
+            size_t codeStart = line.find(',');
+            size_t amountStart = line.find(',', codeStart + 1);
+            size_t amountEnd = line.find(',', amountStart + 1);
+
+            if (line.empty() || line.find('\n') != string::npos) {
+                continue;
+            }
+
+            switch (i % 5) {
+                case 0:
+                case 1:
+                    line.replace(amountStart + 1, amountEnd - amountStart - 1,
+                                 " " + to_string(random() % 1000));
+                    break;
+                case 2:
+                    line.clear();
+                    break;
+                case 3:
+                    line += "\nresistor, NEW_" + to_string(newItemCount++) +
+                            ", " + to_string(random() % 1000) + ", " +
+                            to_string(1 + random() % 500) + ", 4K7";
+                    break;
+                case 4:
+                    line = "diode" + line.substr(codeStart, amountEnd -
+                                                            codeStart) +
+                           ", 1";
+                    break;
+            }
+        }
+
+        writeLines();
+
+        start = Clock::now();
+        fullInventory = readMappedInventoryFile(file);
+        fullSeconds = secondsSince(start);
+
+        start = Clock::now();
+        ReloadSummary summary = reloader.reload(inv);
+        reloadSeconds = secondsSince(start);
+
+        cout << "  churn " << setw(4) << setprecision(1) << share * 100
+             << "%  full " << setprecision(3) << fullSeconds
+             << "s  incremental " << reloadSeconds << "s  ("
+             << summary.unchangedBlockCount << "/" << summary.blockCount
+             << " blocks skipped, " << summary.parsedLineCount
+             << " lines parsed, +" << summary.addedCount << " ~"
+             << summary.modifiedCount << " -" << summary.removedCount
+             << ")  identical: "
+             << checkResult(sameContents(fullInventory, inv)) << endl;
+    }
+
+    filesystem::remove(file);
+}
+
+/**
+ * Runs six readers taking snapshots of a concurrent inventory while a writer
+ * publishes 300 versions, mostly moving stock between random items and at
+ * times replacing the inventory whole. Each snapshot must hold every item
+ * and the same total stock. Meant for a build with a sanitizer (see the
+ * STOCK_SANITIZER option), which reports any race or use of a version
+ * deleted while still held.
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void stressConcurrent(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+    long long totalStock = sumStockAmounts(inv.getColumns(), ColumnFilter());
+    int size = inv.getSize();
+    string firstCode(inv[0]->getStockCode());
+
+    // Readers taking snapshots, versions published and moves per version
+    const unsigned int readerCount = 6;
+    const int versionCount = 300;
+    const int movesPerVersion = 100;
+
+    ConcurrentInventory sharedInv(move(inv));
+    atomic<bool> writing(true);
+    atomic<bool> consistent(true);
+    atomic<size_t> snapshots(0);
+    vector<thread> readers;
+
+    for (unsigned int t = 0; t < readerCount; t++) {
+        readers.emplace_back([&]() {
+            size_t count = 0;
+
+            while (writing.load(memory_order_relaxed)) {
+                ConcurrentInventory::Snapshot snapshot = sharedInv.read();
+
+                if (snapshot->getSize() != size ||
+                    snapshot->find(firstCode) == nullptr ||
+                    sumStockAmounts(snapshot->getColumns(),
+                                    ColumnFilter()) != totalStock) {
+                    consistent.store(false);
+                }
+
+                count++;
+            }
+
+            snapshots += count;
+        });
+    }
+
+    mt19937 random(2018);
+
+    for (int version = 0; version < versionCount; version++) {
+        if (version % 50 == 49) {
+            Inventory next = *sharedInv.read();
+            sharedInv.replace(move(next));
+            continue;
+        }
+
+        sharedInv.update([&](Inventory &next) {
+            for (int i = 0; i < movesPerVersion; i++) {
+                StockItem *from = next[random() % size];
+                StockItem *to = next[random() % size];
+
+                if (from->getStockAmount() > 0) {
+                    from->setStockAmount(from->getStockAmount() - 1);
+                    to->setStockAmount(to->getStockAmount() + 1);
+                }
+            }
+        });
+    }
+
+    writing.store(false);
+
+    for (thread &reader : readers) {
+        reader.join();
+    }
+
+    // Publishing once no reader holds a snapshot deletes every version
+    // replaced
+    sharedInv.update([](Inventory &) {});
+
+    cout << "Stress concurrent (" << itemCount << " items, " << readerCount
+         << " readers, " << sharedInv.getVersion() << " versions, "
+         << snapshots.load() << " snapshots)" << endl
+         << "  retired versions left: " << sharedInv.getRetiredCount()
+         << endl
+         << "  consistent: "
+         << checkResult(consistent.load() &&
+                        sharedInv.getRetiredCount() == 0) << endl;
+}
+
+/**
+ * Runs eight threads placing orders for three items at once, each order
+ * reserving one to three units then committing them, releasing them,
+ * dropping the reservation (which releases it) or moving it to another
+ * reservation first. The items hold too little stock for every order. The
+ * stock committed and the stock left must add up to the stock there was,
+ * with none left below zero, and the columns must agree once synced. No
+ * reservation may be left pending, and an item must not be removed while
+ * one is. Meant for a build with a sanitizer (see the STOCK_SANITIZER option).
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void stressReservations(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    // Threads placing orders, orders each places, items they are placed for
+    // and stock each item holds
+    const unsigned int threadCount = 8;
+    const int ordersPerThread = 20000;
+    const int hotItemCount = 3;
+    const int hotStock = 50000;
+
+    vector<string> hotCodes;
+
+    for (int i = 0; i < hotItemCount; i++) {
+        hotCodes.emplace_back(inv[(i * 7919) % inv.getSize()]->getStockCode());
+        inv.find(hotCodes.back())->setStockAmount(hotStock);
+    }
+
+    long long stockBefore = sumStockAmounts(inv.getColumns(), ColumnFilter());
+    atomic<long long> committed(0);
+    vector<thread> threads;
+
+    for (unsigned int t = 0; t < threadCount; t++) {
+        threads.emplace_back([&, t]() {
+            mt19937 random(2018 + t);
+            long long count = 0;
+
+            for (int i = 0; i < ordersPerThread; i++) {
+                int quantity = 1 + random() % 3;
+                StockReservation reservation = inv.tryReserve(
+                        hotCodes[random() % hotItemCount], quantity);
+
+                if (!reservation.isPending()) {
+                    continue;
+                }
+
+                // Commits most orders, releases or drops some, and moves
+                // some to another reservation before committing them
+                switch (random() % 8) {
+                    case 0:
+                        inv.release(reservation);
+                        break;
+                    case 1:
+                        break;
+                    case 2: {
+                        StockReservation moved(move(reservation));
+                        inv.commit(moved);
+                        count += quantity;
+                        break;
+                    }
+                    default:
+                        inv.commit(reservation);
+                        count += quantity;
+                        break;
+                }
+            }
+
+            committed += count;
+        });
+    }
+
+    for (thread &thread : threads) {
+        thread.join();
+    }
+
+    long long hotLeft = 0;
+    bool exact = true;
+
+    for (const string &code : hotCodes) {
+        int left = inv.find(code)->getStockAmount();
+        exact = exact && left >= 0;
+        hotLeft += left;
+    }
+
+    inv.syncStockAmounts();
+
+    exact = exact && committed.load() + hotLeft ==
+                     static_cast<long long>(hotStock) * hotItemCount &&
+            sumStockAmounts(inv.getColumns(), ColumnFilter()) ==
+            stockBefore - committed.load();
+
+    // No reservation is left pending, and an item is only removed once its
+    // reservation is settled
+    for (const string &code : hotCodes) {
+        exact = exact && !inv.find(code)->hasPendingReservations();
+    }
+
+    StockItem *hotItem = inv.find(hotCodes[0]);
+    hotItem->setStockAmount(1);
+    StockReservation pending = inv.tryReserve(hotCodes[0], 1);
+    bool refused = false;
+
+    try {
+        inv.remove({hotItem});
+    } catch (const invalid_argument &) {
+        refused = true;
+    }
+
+    inv.release(pending);
+    inv.remove({hotItem});
+    exact = exact && refused && inv.find(hotCodes[0]) == nullptr;
+
+    cout << "Stress reservations (" << itemCount << " items, "
+         << threadCount << " threads, " << hotItemCount << " items ordered, "
+         << committed.load() << " units committed)" << endl
+         << "  exact: " << checkResult(exact) << endl;
+}
+
+/**
+ * Runs threads changing unit prices, threads reserving then committing or
+ * releasing stock, a thread syncing the stock amounts and threads running
+ * fanned out queries on a sharded inventory all at once. Updates that would
+ * change a stock code must be refused. Every query must see every item and
+ * no more stock than there was, and once synced the stock must have fallen
+ * by exactly the stock committed. Meant for a build with a sanitizer (see
+ * the STOCK_SANITIZER option).
+ *
+ * @param itemCount         amount of items in the inventory
+ */
+void stressShards(size_t itemCount) {
+    Inventory inv = loadSyntheticInventory(itemCount);
+
+    // Threads of each kind, and the changes each changing thread makes
+    const unsigned int updateThreads = 2;
+    const unsigned int reserveThreads = 2;
+    const unsigned int queryThreads = 2;
+    const int changesPerThread = 20000;
+
+    ColumnFilter resistors;
+    resistors.matchComponentType = true;
+    resistors.componentType = ComponentType::Resistor;
+
+    int size = inv.getSize();
+    size_t resistorCount = countItems(inv.getColumns(), resistors);
+    long long stockBefore = sumStockAmounts(inv.getColumns(), ColumnFilter());
+    vector<string> codes;
+
+    for (int i = 0; i < size; i++) {
+        codes.emplace_back(inv[i]->getStockCode());
+    }
+
+    ShardedInventory shardedInv(inv, 8, 2);
+    atomic<int> changersLeft(updateThreads + reserveThreads);
+    atomic<long long> committed(0);
+    atomic<bool> consistent(true);
+    vector<thread> threads;
+
+    for (unsigned int t = 0; t < updateThreads; t++) {
+        threads.emplace_back([&, t]() {
+            mt19937 random(2018 + t);
+
+            for (int i = 0; i < changesPerThread; i++) {
+                const string &code = codes[random() % size];
+                int price = 1 + random() % 1000;
+
+                // Tries a change of stock code now and then, which must be
+                // refused with the item left as it was
+                if (i % 100 == 0) {
+                    try {
+                        shardedInv.update(code, [](StockItem &item) {
+                            item.setStockCode("STRESS_RENAMED");
+                        });
+                        consistent.store(false);
+                    } catch (const invalid_argument &) {
+                    }
+                } else {
+                    shardedInv.update(code, [price](StockItem &item) {
+                        item.setUnitPrice(price);
+                    });
+                }
+            }
+
+            changersLeft--;
+        });
+    }
+
+    for (unsigned int t = 0; t < reserveThreads; t++) {
+        threads.emplace_back([&, t]() {
+            mt19937 random(2118 + t);
+            long long count = 0;
+
+            for (int i = 0; i < changesPerThread; i++) {
+                StockReservation reservation = shardedInv.tryReserve(
+                        codes[random() % 64], 1);
+
+                // Commits most orders and releases the rest
+                if (!reservation.isPending()) {
+                    continue;
+                } else if (i % 4 == 0) {
+                    shardedInv.release(reservation);
+                } else {
+                    shardedInv.commit(reservation);
+                    count++;
+                }
+            }
+
+            committed += count;
+            changersLeft--;
+        });
+    }
+
+    threads.emplace_back([&]() {
+        while (changersLeft.load() > 0) {
+            shardedInv.syncStockAmounts();
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+    });
+
+    for (unsigned int t = 0; t < queryThreads; t++) {
+        threads.emplace_back([&]() {
+            while (changersLeft.load() > 0) {
+                if (shardedInv.getSize() != size ||
+                    shardedInv.countItems(resistors) != resistorCount ||
+                    shardedInv.search(ComponentType::Resistor).size() !=
+                    resistorCount ||
+                    shardedInv.sumStockAmounts() > stockBefore ||
+                    shardedInv.topK(SortField::UnitPrice, 10).size() != 10 ||
+                    shardedInv.find("STRESS_RENAMED") != nullptr) {
+                    consistent.store(false);
+                }
+            }
+        });
+    }
+
+    for (thread &thread : threads) {
+        thread.join();
+    }
+
+    shardedInv.syncStockAmounts();
+
+    bool exact = consistent.load() &&
+                 shardedInv.sumStockAmounts() ==
+                 stockBefore - committed.load();
+
+    cout << "Stress shards (" << itemCount << " items, "
+         << shardedInv.getShardCount() << " shards, " << committed.load()
+         << " units committed)" << endl
+         << "  consistent: " << checkResult(exact) << endl;
+}
+
+/**
+ * Runs four threads that each add, change and remove the items of an
+ * inventory of their own, all watched by one write-ahead log, syncing now
+ * and then. Replaying the log must recover every inventory, as must
+ * replaying it once a torn record is left at its end. A checkpoint must
+ * leave a snapshot holding every inventory and an empty log, and a file
+ * with a bad header must be refused. Meant for a build with a sanitizer
+ * (see the STOCK_SANITIZER option).
+ *
+ * @param itemCount         amount of items in the inventories
+ */
+void stressLog(size_t itemCount) {
+    string logFile = (filesystem::temp_directory_path() /
+                      "stock_benchmark_stress.log").string();
+    string snapshotFile = (filesystem::temp_directory_path() /
+                           "stock_benchmark_stress.snapshot").string();
+    filesystem::remove(logFile);
+
+    // Threads logging, and the changes each makes
+    const unsigned int threadCount = 4;
+    const int changesPerThread = 20000;
+
+    Inventory inv = loadSyntheticInventory(itemCount);
+    vector<Inventory> threadInvs(threadCount);
+
+    {
+        WriteAheadLog log(logFile);
+        vector<thread> threads;
+
+        for (unsigned int t = 0; t < threadCount; t++) {
+            threads.emplace_back([&, t]() {
+                Inventory &threadInv = threadInvs[t];
+                mt19937 random(2018 + t);
+                threadInv.watch(&log);
+
+                for (int i = t; i < inv.getSize(); i += threadCount) {
+                    threadInv.addCopy(*inv[i]);
+                }
+
+                // Changes amounts and prices, and removes an item now and
+                // then, adding a copy of it back with a new amount
+                for (int i = 0; i < changesPerThread; i++) {
+                    StockItem *item = threadInv[random() % threadInv.getSize()];
+
+                    switch (random() % 8) {
+                        case 0: {
+                            Diode copy(item->getStockCode(),
+                                       static_cast<int>(random() % 100), 1);
+                            threadInv.remove({item});
+                            threadInv.addCopy(copy);
+                            break;
+                        }
+                        case 1:
+                            item->setUnitPrice(1 + random() % 1000);
+                            break;
+                        default:
+                            item->setStockAmount(random() % 100);
+                            break;
+                    }
+
+                    if (i % 1000 == 0) {
+                        log.sync();
+                    }
+                }
+            });
+        }
+
+        for (thread &thread : threads) {
+            thread.join();
+        }
+    }
+
+    Inventory expected;
+
+    for (Inventory &threadInv : threadInvs) {
+        for (int i = 0; i < threadInv.getSize(); i++) {
+            expected.addCopy(*threadInv[i]);
+        }
+    }
+
+    expected.sortBy({SortField::StockCode});
+
+    // Lambda for replaying the log into an inventory, checking it then
+    // matches the one expected
+    auto replayMatches = [&](Inventory &&replayed) {
+        WriteAheadLog log(logFile);
+        log.replay(replayed);
+        replayed.sortBy({SortField::StockCode});
+
+        return sameInventories(expected, replayed);
+    };
+
+    bool recovered = replayMatches(Inventory());
+
+    // Leaves half a record at the end, as a crash while writing would
+    {
+        ofstream logStream(logFile, ios::binary | ios::app);
+        const char tornRecord[] = {24, 0, 0, 0, 1, 2, 3, 4, 0, 1};
+        logStream.write(tornRecord, sizeof(tornRecord));
+    }
+
+    recovered = recovered && replayMatches(Inventory());
+
+    bool checkpointed;
+
+    {
+        WriteAheadLog log(logFile);
+        checkpointed = log.checkpoint(expected, snapshotFile);
+    }
+
+    // The emptied log holds only its 16 byte header
+    Inventory fromSnapshot = readInventorySnapshot(snapshotFile);
+    checkpointed = checkpointed &&
+                   filesystem::file_size(logFile) == 16 &&
+                   replayMatches(move(fromSnapshot));
+
+    // Overwrites the magic at the start of the log
+    bool refused = false;
+
+    {
+        fstream logStream(logFile, ios::binary | ios::in | ios::out);
+        logStream.write("NOTALOG!", 8);
+    }
+
+    try {
+        WriteAheadLog log(logFile);
+    } catch (const invalid_argument &) {
+        refused = true;
+    }
+
+    filesystem::remove(logFile);
+    filesystem::remove(snapshotFile);
+
+    cout << "Stress log (" << itemCount << " items, " << threadCount
+         << " threads, " << changesPerThread << " changes per thread)"
+         << endl
+         << "  recovered: "
+         << checkResult(recovered && checkpointed && refused) << endl;
+}
+
+/**
+ * Writes a synthetic inventory file, cycling through every component type
+ * with unique stock codes and random amounts and prices.
+ *
+ * @param file              name of file to write
+ * @param itemCount         amount of items to write
+ */
+void writeSyntheticInventory(const string &file, size_t itemCount) {
+    const char *resistances[] = {"1R0", "4K7", "10K", "2M2", "100R", "1K5"};
+    const char *capacitances[] = {"10pF", "100nF", "1uF", "47nF", "1000pf"};
+    const char *deviceTypes[] = {"NPN", "PNP", "FET"};
+    const char *descriptions[] = {"\"Timer\"", "\"op-amp\"", "\"CPU\"",
+                                  "\"4-bit counter\"", "\"JFET op-amp\""};
+
+    // Fixed seed so every run benchmarks the same inventory
+    mt19937 random(2018);
+
+    ofstream fileStream(file);
+
+    for (size_t i = 0; i < itemCount; i++) {
+        int amount = random() % 1000;
+        int price = 1 + random() % 500;
+
+        switch (i % 5) {
+            case 0:
+                fileStream << "resistor, RES_" << i << ", " << amount << ", "
+                           << price << ", " << resistances[random() % 6];
+                break;
+            case 1:
+                fileStream << "capacitor, CAP_" << i << ", " << amount << ", "
+                           << price << ", " << capacitances[random() % 5];
+                break;
+            case 2:
+                fileStream << "diode, DIO_" << i << ", " << amount << ", "
+                           << price;
+                break;
+            case 3:
+                fileStream << "transistor, TRN_" << i << ", " << amount
+                           << ", " << price << ", "
+                           << deviceTypes[random() % 3];
+                break;
+            case 4:
+                fileStream << "IC, IC_" << i << ",  " << amount << ", "
+                           << price << ",  " << descriptions[random() % 5];
+                break;
+        }
+
+        fileStream << '\n';
+    }
+}
+
+/**
+ * Loads a synthetic inventory by writing and reading back a temporary
+ * inventory file
+ *
+ * @param itemCount         amount of items in the inventory
+ * @return                  synthetic inventory
+ */
+Inventory loadSyntheticInventory(size_t itemCount) {
+    string file = (filesystem::temp_directory_path() /
+                   "stock_benchmark_inventory.txt").string();
+    writeSyntheticInventory(file, itemCount);
+
+    Inventory inv = readParallelInventoryFile(file);
+    filesystem::remove(file);
+
+    return inv;
+}
+
+/**
+ * Seconds elapsed since a point in time
+ *
+ * @param start             point in time to measure from
+ * @return                  seconds elapsed
+ */
+double secondsSince(Clock::time_point start) {
+    return chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * Checks that two inventories hold the same items in the same order, by
+ * comparing how each item prints
+ *
+ * @param inv1              first inventory
+ * @param inv2              second inventory
+ * @return                  true if the inventories match
+ */
+bool sameInventories(Inventory &inv1, Inventory &inv2) {
+    if (inv1.getSize() != inv2.getSize()) {
+        return false;
+    }
+
+    for (int i = 0; i < inv1.getSize(); i++) {
+        ostringstream item1, item2;
+        item1 << *inv1[i];
+        item2 << *inv2[i];
+
+        if (item1.str() != item2.str()) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Checks that two inventories hold their items in the same slots, in the
+ * same stock order, and that their sorted indexes list the same slots in
+ * the same order and their tries find the same codes
+ *
+ * @param inv1              first inventory to compare
+ * @param inv2              second inventory to compare
+ * @return                  true if the slots and indexes are the same
+ */
+bool sameIndexes(Inventory &inv1, Inventory &inv2) {
+    if (inv1.getSize() != inv2.getSize()) {
+        return false;
+    }
+
+    for (int i = 0; i < inv1.getSize(); i++) {
+        if (inv1[i]->getSlot() != inv2[i]->getSlot()) {
+            return false;
+        }
+    }
+
+    // Lambda to list the slots of an inventory's price and parametric
+    // indexes in order
+    auto sortedSlots = [](const Inventory &inv) {
+        vector<uint32_t> slots;
+        auto collect = [&slots](uint32_t slot) {
+            slots.push_back(slot);
+            return true;
+        };
+        double infinity = numeric_limits<double>::infinity();
+
+        inv.getPriceIndex().forEachAscending(collect);
+        inv.getValueIndex(ComponentType::Resistor)
+                .forEachInRange(-infinity, infinity, collect);
+        inv.getValueIndex(ComponentType::Capacitor)
+                .forEachInRange(-infinity, infinity, collect);
+
+        return slots;
+    };
+
+    if (sortedSlots(inv1) != sortedSlots(inv2)) {
+        return false;
+    }
+
+    const StockCodeTrie &trie1 = inv1.getCodeTrie();
+    const StockCodeTrie &trie2 = inv2.getCodeTrie();
+
+    if (trie1.getSize() != trie2.getSize()) {
+        return false;
+    }
+
+    for (int i = 0; i < inv1.getSize(); i++) {
+        string_view code = inv1[i]->getStockCode();
+        uint32_t slot1, slot2;
+
+        if (trie1.find(code, slot1) != trie2.find(code, slot2) ||
+            slot1 != slot2) {
+            return false;
+        }
+
+        // Ranked searches also depend on the stock amounts below each node
+        if (i % 1000 == 0 &&
+            (trie1.findPrefix(code.substr(0, 3), 20) !=
+             trie2.findPrefix(code.substr(0, 3), 20) ||
+             trie1.findFuzzy(code, 1, false, 20) !=
+             trie2.findFuzzy(code, 1, false, 20))) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Gives the result of a check to print, noting a failed check so that the
+ * benchmarks exit with a failure once they have all run
+ *
+ * @param passed            whether the check passed
+ * @return                  yes if the check passed, NO if not
+ */
+const char *checkResult(bool passed) {
+    if (!passed) {
+        checkFailed = true;
+    }
+
+    return passed ? "yes" : "NO";
+}
+
+/**
+ * Allocates memory, counting the allocation for the memory benchmark. Every
+ * replaced operator new allocates through here, and every replaced operator
+ * delete frees through freeCounted, so memory is always allocated with
+ * malloc or aligned_alloc and freed with free. Neither is inlined, so the
+ * compiler never sees free called on memory from operator new.
+ *
+ * @param size              bytes to allocate
+ * @param alignment         alignment the memory needs
+ * @return                  allocated memory, null if there is none
+ */
+[[gnu::noinline]]
+static void *allocateCounted(size_t size, size_t alignment) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    allocatedBytes.fetch_add(size, memory_order_relaxed);
+
+    if (size == 0) {
+        size = 1;
+    }
+
+    if (alignment <= alignof(max_align_t)) {
+        return malloc(size);
+    }
+
+    // aligned_alloc needs a size that is a multiple of the alignment
+    return aligned_alloc(alignment, (size + alignment - 1) / alignment *
+                                    alignment);
+}
+
+/**
+ * Frees memory allocated by allocateCounted
+ *
+ * @param memory            memory to free
+ */
+[[gnu::noinline]]
+static void freeCounted(void *memory) noexcept {
+    free(memory);
+}
+
+/**
+ * Allocates counted memory, throwing if there is none
+ *
+ * @param size              bytes to allocate
+ * @param alignment         alignment the memory needs
+ * @return                  allocated memory
+ */
+static void *allocateCountedOrThrow(size_t size, size_t alignment) {
+    if (void *memory = allocateCounted(size, alignment)) {
+        return memory;
+    }
+
+    throw bad_alloc();
+}
+
+// Replaced allocation functions, plain and array, throwing and not
+void *operator new(size_t size) {
+    return allocateCountedOrThrow(size, alignof(max_align_t));
+}
+
+void *operator new[](size_t size) {
+    return allocateCountedOrThrow(size, alignof(max_align_t));
+}
+
+void *operator new(size_t size, const nothrow_t &) noexcept {
+    return allocateCounted(size, alignof(max_align_t));
+}
+
+void *operator new[](size_t size, const nothrow_t &) noexcept {
+    return allocateCounted(size, alignof(max_align_t));
+}
+
+// Replaced allocation functions for over-aligned types
+void *operator new(size_t size, align_val_t alignment) {
+    return allocateCountedOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, align_val_t alignment) {
+    return allocateCountedOrThrow(size, static_cast<size_t>(alignment));
+}
+
+void *operator new(size_t size, align_val_t alignment,
+                   const nothrow_t &) noexcept {
+    return allocateCounted(size, static_cast<size_t>(alignment));
+}
+
+void *operator new[](size_t size, align_val_t alignment,
+                     const nothrow_t &) noexcept {
+    return allocateCounted(size, static_cast<size_t>(alignment));
+}
+
+// Replaced deallocation functions, matching each allocation function
+void operator delete(void *memory) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete[](void *memory) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete(void *memory, size_t) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete[](void *memory, size_t) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete(void *memory, const nothrow_t &) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete[](void *memory, const nothrow_t &) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete(void *memory, align_val_t) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete[](void *memory, align_val_t) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete(void *memory, size_t, align_val_t) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete[](void *memory, size_t, align_val_t) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete(void *memory, align_val_t, const nothrow_t &) noexcept {
+    freeCounted(memory);
+}
+
+void operator delete[](void *memory, align_val_t,
+                       const nothrow_t &) noexcept {
+    freeCounted(memory);
+}
@@ -0,0 +1,232 @@
+/******************************************************************************
+ *
+ * File        : StockCodeIndex.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a hash index of stock items by their stock
+ *               code.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <functional>
+#include "StockCodeIndex.h"
+
+using namespace std;
+
+// Capacity of the table when the first code is added
+static const size_t INITIAL_CAPACITY = 16;
+
+/**
+ * Constructs an empty index
+ */
+StockCodeIndex::StockCodeIndex() : size(0) {
+}
+
+/**
+ * Adds a code to the index, unless it is already indexed (the first item
+ * added with a code keeps it)
+ *
+ * @param code                      stock code to index
+ * @param slot                      slot of the item with the code
+ * @return                          true if the code was added
+ */
+bool StockCodeIndex::insert(string_view code, uint32_t slot) {
+    // Keeps the table at most 3/4 full so probe sequences stay short
+    if ((this->size + 1) * 4 > this->entries.size() * 3) {
+        this->rehash(max(INITIAL_CAPACITY, this->entries.size() * 2));
+    }
+
+    uint32_t hash = StockCodeIndex::hashCode(code);
+    size_t position = this->probe(code, hash);
+    Entry &entry = this->entries[position];
+
+    if (entry.code.data() != nullptr) {
+        return false;
+    }
+
+    entry = {code, hash, slot};
+    this->size++;
+
+    return true;
+}
+
+/**
+ * Removes a code from the index, if it is indexed to the given slot.
+ * Entries after it are shifted back so that no tombstones are left behind.
+ *
+ * @param code                      stock code to remove
+ * @param slot                      slot of the item with the code
+ * @return                          true if the code was removed
+ */
+bool StockCodeIndex::erase(string_view code, uint32_t slot) {
+    if (this->size == 0) {
+        return false;
+    }
+
+    size_t position = this->probe(code, StockCodeIndex::hashCode(code));
+
+    if (this->entries[position].code.data() == nullptr ||
+        this->entries[position].slot != slot) {
+        return false;
+    }
+
+    size_t mask = this->entries.size() - 1;
+    size_t next = (position + 1) & mask;
+
+    // Moves back each following entry that would no longer be reachable
+    while (this->entries[next].code.data() != nullptr) {
+        size_t home = this->entries[next].hash & mask;
+
+        // Checks if the gap lies between the entry's home and its position
+        if (((next - home) & mask) >= ((next - position) & mask)) {
+            this->entries[position] = this->entries[next];
+            position = next;
+        }
+
+        next = (next + 1) & mask;
+    }
+
+    this->entries[position] = Entry();
+    this->size--;
+
+    return true;
+}
+
+/**
+ * Finds the slot of the item with a code, without allocating
+ *
+ * @param code                      stock code to find
+ * @param slot                      set to the slot of the item if found
+ * @return                          true if the code is indexed
+ */
+bool StockCodeIndex::find(string_view code, uint32_t &slot) const {
+    if (this->size == 0) {
+        return false;
+    }
+
+    const Entry &entry = this->entries[this->probe(
+            code, StockCodeIndex::hashCode(code))];
+
+    if (entry.code.data() == nullptr) {
+        return false;
+    }
+
+    slot = entry.slot;
+
+    return true;
+}
+
+/**
+ * Moves every slot in the index to its new slot, once the items in other
+ * slots have been removed from it and the slots compacted. Codes keep
+ * their place in the table.
+ *
+ * @param newSlots                  new slot of each old slot, in the same
+ *                                  order as the old slots
+ */
+void StockCodeIndex::renumber(const vector<uint32_t> &newSlots) {
+    for (Entry &entry : this->entries) {
+        if (entry.code.data() != nullptr) {
+            entry.slot = newSlots[entry.slot];
+        }
+    }
+}
+
+/**
+ * Removes every code from the index
+ */
+void StockCodeIndex::clear() {
+    this->entries.clear();
+    this->size = 0;
+}
+
+/**
+ * Allocates space for an amount of codes ahead of adding them
+ *
+ * @param size                      amount of codes to make space for
+ */
+void StockCodeIndex::reserve(size_t size) {
+    size_t capacity = INITIAL_CAPACITY;
+
+    while (size * 4 > capacity * 3) {
+        capacity *= 2;
+    }
+
+    if (capacity > this->entries.size()) {
+        this->rehash(capacity);
+    }
+}
+
+/**
+ * Retrieves the amount of codes in the index
+ *
+ * @return                          amount of codes
+ */
+size_t StockCodeIndex::getSize() const {
+    return this->size;
+}
+
+/**
+ * Hashes a stock code
+ *
+ * @param code                      stock code to hash
+ * @return                          hash of code
+ */
+uint32_t StockCodeIndex::hashCode(string_view code) {
+    // Widened first, so the shift is defined where size_t is 32 bits
+    uint64_t hash = std::hash<string_view>()(code);
+
+    // Folds in the high bits, since only the low bits pick a position
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+/**
+ * Finds the position of a code's entry, or of the empty entry that ends its
+ * probe sequence if the code is not indexed
+ *
+ * @param code                      stock code to find
+ * @param hash                      hash of code
+ * @return                          position in the table
+ */
+size_t StockCodeIndex::probe(string_view code, uint32_t hash) const {
+    size_t mask = this->entries.size() - 1;
+    size_t position = hash & mask;
+
+    while (true) {
+        const Entry &entry = this->entries[position];
+
+        if (entry.code.data() == nullptr ||
+            (entry.hash == hash && entry.code == code)) {
+            return position;
+        }
+
+        position = (position + 1) & mask;
+    }
+}
+
+/**
+ * Resizes the table, re-inserting every entry
+ *
+ * @param capacity                  new capacity (a power of two)
+ */
+void StockCodeIndex::rehash(size_t capacity) {
+    vector<Entry> oldEntries(capacity);
+    oldEntries.swap(this->entries);
+
+    size_t mask = capacity - 1;
+
+    for (const Entry &entry : oldEntries) {
+        if (entry.code.data() != nullptr) {
+            size_t position = entry.hash & mask;
+
+            while (this->entries[position].code.data() != nullptr) {
+                position = (position + 1) & mask;
+            }
+
+            this->entries[position] = entry;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+ *
+ * File        : StockCodeIndex.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a hash index of stock items by their
+ *               stock code.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef STOCKCODEINDEX_H
+#define STOCKCODEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+/**
+ * Open addressing (linear probing) hash table from stock code to the slot of
+ * the item with that code. The index does not own the codes, each one must
+ * stay valid for as long as it is in the index.
+ */
+class StockCodeIndex {
+private:
+    // An entry of the table, empty when its code is null
+    struct Entry {
+        std::string_view code;
+        uint32_t hash;
+        uint32_t slot;
+    };
+
+    // Table of entries, its size is always a power of two
+    std::vector<Entry> entries;
+
+    // Amount of entries in use
+    size_t size;
+
+    // Hashes a stock code
+    static uint32_t hashCode(std::string_view code);
+
+    // Finds the position of a code's entry, or the empty entry ending its
+    // probe sequence
+    size_t probe(std::string_view code, uint32_t hash) const;
+
+    // Grows the table to the given capacity, re-inserting every entry
+    void rehash(size_t capacity);
+
+public:
+    // StockCodeIndex Constructor
+    StockCodeIndex();
+
+    // Adds a code to the index, unless it is already indexed
+    bool insert(std::string_view code, uint32_t slot);
+
+    // Removes a code from the index if it is indexed to the given slot
+    bool erase(std::string_view code, uint32_t slot);
+
+    // Finds the slot of a code, returning false if it is not indexed
+    bool find(std::string_view code, uint32_t &slot) const;
+
+    // Moves every slot to its new slot after others were removed, the new
+    // slots keeping the order of the old
+    void renumber(const std::vector<uint32_t> &newSlots);
+
+    // Removes every code from the index
+    void clear();
+
+    // Allocates space for an amount of codes ahead of adding them
+    void reserve(size_t size);
+
+    // Retrieves the amount of codes in the index
+    size_t getSize() const;
+};
+
+#endif /* STOCKCODEINDEX_H */
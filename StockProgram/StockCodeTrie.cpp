@@ -0,0 +1,793 @@
+/******************************************************************************
+ *
+ * File        : StockCodeTrie.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a compressed trie of stock codes.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <queue>
+#include "StockCodeTrie.h"
+
+using namespace std;
+
+// Largest stock amount below a node with no items
+static const int32_t NO_AMOUNT = numeric_limits<int32_t>::min();
+
+// Longest code the trie holds, as labels and paths store their lengths in
+// 16 bits
+static const size_t MAX_CODE_LENGTH = numeric_limits<uint16_t>::max();
+
+/**
+ * Constructs an empty trie, holding only its root
+ */
+StockCodeTrie::StockCodeTrie() : size(0) {
+    this->clear();
+}
+
+/**
+ * Retrieves the label of the edge into a node
+ *
+ * @param node                      node of the label
+ * @return                          characters of the label
+ */
+string_view StockCodeTrie::label(uint32_t node) const {
+    return string_view(this->labels).substr(this->nodes[node].labelStart,
+                                            this->nodes[node].labelLength);
+}
+
+/**
+ * Adds a node with no children and no item to the trie, reusing a removed
+ * node if there is one
+ *
+ * @param labelStart                start of the node's label in the labels
+ * @param labelLength               length of the node's label
+ * @return                          new node
+ */
+uint32_t StockCodeTrie::newNode(uint32_t labelStart, uint32_t labelLength) {
+    char firstCharacter = labelLength > 0 ? this->labels[labelStart] : 0;
+    Node node = {labelStart, static_cast<uint16_t>(labelLength),
+                 firstCharacter, NONE, NONE, NONE, 0, NO_AMOUNT};
+
+    if (!this->freeNodes.empty()) {
+        uint32_t reused = this->freeNodes.back();
+        this->freeNodes.pop_back();
+        this->nodes[reused] = node;
+
+        return reused;
+    }
+
+    this->nodes.push_back(node);
+
+    return this->nodes.size() - 1;
+}
+
+/**
+ * Follows a code from the root, through every label it matches in full
+ *
+ * @param code                      code to follow
+ * @param path                      set to the nodes passed through, from the
+ *                                  root
+ * @return                          node the code ends at, NONE if the code
+ *                                  ends part way through a label or leaves
+ *                                  the trie
+ */
+uint32_t StockCodeTrie::findNode(string_view code,
+                                 vector<uint32_t> &path) const {
+    uint32_t node = 0;
+    path.assign(1, node);
+
+    while (!code.empty()) {
+        uint32_t child = this->nodes[node].firstChild;
+
+        while (child != NONE && this->nodes[child].firstCharacter != code[0]) {
+            child = this->nodes[child].nextSibling;
+        }
+
+        if (child == NONE || code.substr(0, this->nodes[child].labelLength)
+                             != this->label(child)) {
+            return NONE;
+        }
+
+        code.remove_prefix(this->nodes[child].labelLength);
+        node = child;
+        path.push_back(node);
+    }
+
+    return node;
+}
+
+/**
+ * Recomputes the largest stock amount below each node of a path, from the
+ * bottom up, after the items below the last node have changed
+ *
+ * @param path                      nodes from the root down
+ */
+void StockCodeTrie::refreshBestAmounts(const vector<uint32_t> &path) {
+    for (size_t i = path.size(); i-- > 0;) {
+        Node &node = this->nodes[path[i]];
+        int32_t bestAmount = node.slot == NONE ? NO_AMOUNT : node.amount;
+
+        for (uint32_t child = node.firstChild; child != NONE;
+             child = this->nodes[child].nextSibling) {
+            bestAmount = max(bestAmount, this->nodes[child].bestAmount);
+        }
+
+        node.bestAmount = bestAmount;
+    }
+}
+
+/**
+ * Adds a code to the trie, unless it is already in it (the first item added
+ * with a code keeps it) or is longer than the trie holds. An edge whose
+ * label only partly matches the code is split where they differ, the new
+ * node reusing the start of the label.
+ *
+ * @param code                      stock code to add
+ * @param slot                      slot of the item with the code
+ * @param amount                    stock amount of the item
+ * @return                          true if the code was added
+ */
+bool StockCodeTrie::insert(string_view code, uint32_t slot, int amount) {
+    if (code.size() > MAX_CODE_LENGTH) {
+        return false;
+    }
+
+    vector<uint32_t> path(1, 0);
+    path.reserve(16);
+    uint32_t node = 0;
+    size_t position = 0;
+
+    while (position < code.size()) {
+        // Finds the child starting with the next character, or where one
+        // would go to keep the children in order
+        uint32_t previous = NONE;
+        uint32_t child = this->nodes[node].firstChild;
+
+        while (child != NONE &&
+               this->nodes[child].firstCharacter < code[position]) {
+            previous = child;
+            child = this->nodes[child].nextSibling;
+        }
+
+        if (child == NONE ||
+            this->nodes[child].firstCharacter != code[position]) {
+            // No child shares the next character, so the rest of the code
+            // becomes the label of a new leaf
+            uint32_t labelStart = this->labels.size();
+            this->labels.append(code.substr(position));
+            uint32_t leaf = this->newNode(labelStart, code.size() - position);
+
+            this->nodes[leaf].nextSibling = child;
+            if (previous == NONE) {
+                this->nodes[node].firstChild = leaf;
+            } else {
+                this->nodes[previous].nextSibling = leaf;
+            }
+
+            node = leaf;
+            path.push_back(node);
+            break;
+        }
+
+        string_view childLabel = this->label(child);
+        string_view rest = code.substr(position);
+        size_t common = 1;
+
+        while (common < childLabel.size() && common < rest.size() &&
+               childLabel[common] == rest[common]) {
+            common++;
+        }
+
+        if (common < childLabel.size()) {
+            // Splits the edge, the new node taking the shared characters
+            uint32_t middle = this->newNode(this->nodes[child].labelStart,
+                                            common);
+            Node &split = this->nodes[child];
+
+            this->nodes[middle].firstChild = child;
+            this->nodes[middle].nextSibling = split.nextSibling;
+            this->nodes[middle].bestAmount = split.bestAmount;
+            split.labelStart += common;
+            split.labelLength -= common;
+            split.firstCharacter = this->labels[split.labelStart];
+            split.nextSibling = NONE;
+
+            if (previous == NONE) {
+                this->nodes[node].firstChild = middle;
+            } else {
+                this->nodes[previous].nextSibling = middle;
+            }
+
+            child = middle;
+        }
+
+        node = child;
+        path.push_back(node);
+        position += common;
+    }
+
+    if (this->nodes[node].slot != NONE) {
+        return false;
+    }
+
+    this->nodes[node].slot = slot;
+    this->nodes[node].amount = amount;
+    this->size++;
+
+    // Adding an item can only raise the largest amounts above it
+    for (uint32_t passed : path) {
+        this->nodes[passed].bestAmount = max(this->nodes[passed].bestAmount,
+                                             amount);
+    }
+
+    return true;
+}
+
+/**
+ * Removes a code from the trie, if it is held for the given slot. Nodes
+ * left with no item and no children are removed too.
+ *
+ * @param code                      stock code to remove
+ * @param slot                      slot of the item with the code
+ * @return                          true if the code was removed
+ */
+bool StockCodeTrie::erase(string_view code, uint32_t slot) {
+    vector<uint32_t> path;
+    uint32_t node = this->findNode(code, path);
+
+    if (node == NONE || this->nodes[node].slot != slot) {
+        return false;
+    }
+
+    this->nodes[node].slot = NONE;
+    this->size--;
+
+    // Unlinks empty nodes, working up towards the root
+    while (path.size() > 1 && this->nodes[path.back()].slot == NONE &&
+           this->nodes[path.back()].firstChild == NONE) {
+        uint32_t empty = path.back();
+        path.pop_back();
+
+        uint32_t *link = &this->nodes[path.back()].firstChild;
+        while (*link != empty) {
+            link = &this->nodes[*link].nextSibling;
+        }
+
+        *link = this->nodes[empty].nextSibling;
+        this->freeNodes.push_back(empty);
+    }
+
+    this->refreshBestAmounts(path);
+
+    return true;
+}
+
+/**
+ * Updates the stock amount of a code, if it is held for the given slot, and
+ * the largest stock amounts of the nodes above it
+ *
+ * @param code                      stock code of the item
+ * @param slot                      slot of the item
+ * @param amount                    new stock amount of the item
+ * @return                          true if the amount was updated
+ */
+bool StockCodeTrie::updateAmount(string_view code, uint32_t slot,
+                                 int amount) {
+    vector<uint32_t> path;
+    uint32_t node = this->findNode(code, path);
+
+    if (node == NONE || this->nodes[node].slot != slot) {
+        return false;
+    }
+
+    int32_t oldAmount = this->nodes[node].amount;
+    this->nodes[node].amount = amount;
+
+    // A raised amount only needs comparing with the largest above it, a
+    // lowered one needs the largest recomputing from the children
+    if (amount >= oldAmount) {
+        for (uint32_t passed : path) {
+            this->nodes[passed].bestAmount = max(
+                    this->nodes[passed].bestAmount, amount);
+        }
+    } else {
+        this->refreshBestAmounts(path);
+    }
+
+    return true;
+}
+
+/**
+ * Finds the slot of the item with a code
+ *
+ * @param code                      stock code to find
+ * @param slot                      set to the slot of the item
+ * @return                          false if the code is not in the trie
+ */
+bool StockCodeTrie::find(string_view code, uint32_t &slot) const {
+    vector<uint32_t> path;
+    uint32_t node = this->findNode(code, path);
+
+    if (node == NONE || this->nodes[node].slot == NONE) {
+        return false;
+    }
+
+    slot = this->nodes[node].slot;
+    return true;
+}
+
+/**
+ * Moves every slot in the trie to its new slot, once the items in other
+ * slots have been removed from it and the slots compacted. Codes keep
+ * their nodes.
+ *
+ * @param newSlots                  new slot of each old slot, in the same
+ *                                  order as the old slots
+ */
+void StockCodeTrie::renumber(const vector<uint32_t> &newSlots) {
+    for (Node &node : this->nodes) {
+        if (node.slot != NONE) {
+            node.slot = newSlots[node.slot];
+        }
+    }
+}
+
+/**
+ * Removes every code from the trie, leaving only its root
+ */
+void StockCodeTrie::clear() {
+    this->nodes.clear();
+    this->labels.clear();
+    this->freeNodes.clear();
+    this->size = 0;
+    this->newNode(0, 0);
+}
+
+/**
+ * Retrieves the nodes of the trie, the root first. Removed nodes waiting to
+ * be reused are included, holding no slot.
+ *
+ * @return                          nodes of the trie
+ */
+const vector<StockCodeTrie::Node> &StockCodeTrie::getNodes() const {
+    return this->nodes;
+}
+
+/**
+ * Retrieves the characters of every label, which the nodes refer to
+ *
+ * @return                          characters of the labels
+ */
+string_view StockCodeTrie::getLabels() const {
+    return this->labels;
+}
+
+/**
+ * Replaces the trie with nodes and labels stored from another trie, checking
+ * they still form a trie: every node is reached from the root once, labels
+ * lie within the labels, children are in order and each slot is held once.
+ * The stock amounts are taken from the items' current amounts, so the
+ * largest amounts below each node are recomputed. Nodes not reached are
+ * kept to be reused.
+ *
+ * @param storedNodes               nodes of the stored trie, the root first
+ * @param storedLabels              characters of the stored labels
+ * @param amounts                   stock amount of the item in each slot
+ * @return                          false if the nodes do not form a trie,
+ *                                  the trie then being left empty
+ */
+bool StockCodeTrie::restore(vector<Node> storedNodes, string storedLabels,
+                            const vector<int> &amounts) {
+    this->clear();
+
+    if (storedNodes.empty() || storedNodes.size() >= NONE ||
+        storedNodes[0].labelLength != 0) {
+        return false;
+    }
+
+    vector<bool> reached(storedNodes.size(), false);
+    vector<bool> heldSlots(amounts.size(), false);
+    size_t codeCount = 0;
+
+    // Nodes in the order they were reached, parents before their children,
+    // and the nodes still to visit with the length of the code to them
+    vector<uint32_t> order;
+    order.reserve(storedNodes.size());
+    vector<pair<uint32_t, size_t>> pending = {{0, 0}};
+    reached[0] = true;
+
+    while (!pending.empty()) {
+        pair<uint32_t, size_t> visited = pending.back();
+        pending.pop_back();
+        order.push_back(visited.first);
+
+        Node &node = storedNodes[visited.first];
+
+        if (node.slot != NONE) {
+            if (node.slot >= amounts.size() || heldSlots[node.slot]) {
+                return false;
+            }
+
+            heldSlots[node.slot] = true;
+            node.amount = amounts[node.slot];
+            codeCount++;
+        }
+
+        bool firstChild = true;
+        char previousCharacter = 0;
+
+        for (uint32_t child = node.firstChild; child != NONE;
+             child = storedNodes[child].nextSibling) {
+            if (child >= storedNodes.size() || reached[child]) {
+                return false;
+            }
+
+            const Node &childNode = storedNodes[child];
+            size_t codeLength = visited.second + childNode.labelLength;
+
+            if (childNode.labelLength == 0 ||
+                childNode.labelStart > storedLabels.size() ||
+                childNode.labelLength >
+                storedLabels.size() - childNode.labelStart ||
+                childNode.firstCharacter !=
+                storedLabels[childNode.labelStart] ||
+                codeLength > MAX_CODE_LENGTH ||
+                (!firstChild &&
+                 childNode.firstCharacter <= previousCharacter)) {
+                return false;
+            }
+
+            reached[child] = true;
+            firstChild = false;
+            previousCharacter = childNode.firstCharacter;
+            pending.emplace_back(child, codeLength);
+        }
+    }
+
+    // Recomputes the largest amounts from the bottom up
+    for (size_t i = order.size(); i-- > 0;) {
+        Node &node = storedNodes[order[i]];
+        int32_t bestAmount = node.slot == NONE ? NO_AMOUNT : node.amount;
+
+        for (uint32_t child = node.firstChild; child != NONE;
+             child = storedNodes[child].nextSibling) {
+            bestAmount = max(bestAmount, storedNodes[child].bestAmount);
+        }
+
+        node.bestAmount = bestAmount;
+    }
+
+    this->nodes.swap(storedNodes);
+    this->labels.swap(storedLabels);
+    this->size = codeCount;
+
+    for (uint32_t node = 0; node < this->nodes.size(); node++) {
+        if (!reached[node]) {
+            this->nodes[node].slot = NONE;
+            this->freeNodes.push_back(node);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Retrieves the amount of codes in the trie
+ *
+ * @return                          amount of codes
+ */
+size_t StockCodeTrie::getSize() const {
+    return this->size;
+}
+
+/**
+ * Retrieves the bytes of memory allocated for the nodes and labels of the
+ * trie
+ *
+ * @return                          bytes allocated
+ */
+size_t StockCodeTrie::getMemoryUsage() const {
+    return sizeof(*this) + this->nodes.capacity() * sizeof(Node) +
+           this->labels.capacity() +
+           this->freeNodes.capacity() * sizeof(uint32_t);
+}
+
+/**
+ * Lays the nodes out again so that the children of each node are next to
+ * each other, as they are scattered by adding codes one at a time, and
+ * frees removed nodes and unused labels. Searches then read fewer cache
+ * lines, so this is worth doing once a whole inventory has been added.
+ */
+void StockCodeTrie::compact() {
+    vector<Node> compacted;
+    string compactedLabels;
+    compacted.reserve(this->nodes.size() - this->freeNodes.size());
+    compactedLabels.reserve(this->labels.size());
+
+    compacted.push_back(this->nodes[0]);
+
+    // Nodes whose children are still to be copied, and their copies
+    vector<pair<uint32_t, uint32_t>> pending = {{0, 0}};
+
+    while (!pending.empty()) {
+        pair<uint32_t, uint32_t> copied = pending.back();
+        pending.pop_back();
+
+        uint32_t previous = NONE;
+        compacted[copied.second].firstChild = NONE;
+
+        for (uint32_t child = this->nodes[copied.first].firstChild;
+             child != NONE; child = this->nodes[child].nextSibling) {
+            uint32_t copy = compacted.size();
+
+            compacted.push_back(this->nodes[child]);
+            compacted[copy].labelStart = compactedLabels.size();
+            compacted[copy].nextSibling = NONE;
+            compactedLabels += this->label(child);
+
+            if (previous == NONE) {
+                compacted[copied.second].firstChild = copy;
+            } else {
+                compacted[previous].nextSibling = copy;
+            }
+
+            previous = copy;
+            pending.emplace_back(child, copy);
+        }
+    }
+
+    this->nodes.swap(compacted);
+    this->labels.swap(compactedLabels);
+    this->freeNodes.clear();
+    this->freeNodes.shrink_to_fit();
+}
+
+/**
+ * Finds the codes starting with a prefix, the items with the most stock
+ * first (and items with equal stock in order of code)
+ *
+ * @param prefix                    start of the codes to find
+ * @param limit                     most codes to find
+ * @return                          slots of the items with the codes
+ */
+vector<uint32_t> StockCodeTrie::findPrefix(string_view prefix,
+                                           size_t limit) const {
+    uint32_t node = 0;
+    string path;
+
+    // Follows the prefix, which may end part way through a label
+    while (path.size() < prefix.size()) {
+        uint32_t child = this->nodes[node].firstChild;
+        char next = prefix[path.size()];
+
+        while (child != NONE && this->nodes[child].firstCharacter != next) {
+            child = this->nodes[child].nextSibling;
+        }
+
+        if (child == NONE) {
+            return vector<uint32_t>();
+        }
+
+        string_view childLabel = this->label(child);
+        string_view rest = prefix.substr(path.size(), childLabel.size());
+
+        if (childLabel.substr(0, rest.size()) != rest) {
+            return vector<uint32_t>();
+        }
+
+        path += childLabel;
+        node = child;
+    }
+
+    Candidate candidate = {this->nodes[node].bestAmount, node, 0,
+                           static_cast<uint16_t>(path.size()), false};
+
+    return this->rankByAmount({candidate}, path, limit);
+}
+
+/**
+ * Finds the codes within an edit distance (the fewest characters inserted,
+ * removed, replaced or swapped with their neighbour) of a code, the items
+ * with the most stock first. For
+ * completing mistyped partial codes, codes can instead be found that start
+ * with any text within the distance of the code.
+ *
+ * @param code                      code to find codes close to
+ * @param maxDistance               largest edit distance to accept
+ * @param matchPrefix               true to find codes starting with text
+ *                                  close to the code
+ * @param limit                     most codes to find
+ * @return                          slots of the items with the codes
+ */
+vector<uint32_t> StockCodeTrie::findFuzzy(string_view code,
+                                          unsigned int maxDistance,
+                                          bool matchPrefix,
+                                          size_t limit) const {
+    // Row of edit distances from each prefix of the code to the root
+    vector<unsigned int> rows(code.size() + 1);
+    for (size_t i = 0; i <= code.size(); i++) {
+        rows[i] = i;
+    }
+
+    string path;
+    string paths;
+    vector<Candidate> matches;
+    this->collectFuzzy(0, path, rows, code, maxDistance, matchPrefix,
+                       matches, paths);
+
+    return this->rankByAmount(move(matches), move(paths), limit);
+}
+
+/**
+ * Walks down from a node, extending a row of edit distances between each
+ * prefix of the code and the path so far with each character of the labels.
+ * Branches are abandoned once no distance in the row is within the largest
+ * accepted, as longer paths can only be further away.
+ *
+ * @param node                      node to walk from
+ * @param path                      characters leading to the node
+ * @param rows                      rows of edit distances, the last for the
+ *                                  path so far
+ * @param code                      code to find codes close to
+ * @param maxDistance               largest edit distance to accept
+ * @param matchPrefix               true to match every code below a path
+ *                                  close to the code
+ * @param matches                   nodes and items matched
+ * @param paths                     paths of the matches, which each match
+ *                                  holds a range of
+ */
+void StockCodeTrie::collectFuzzy(uint32_t node, string &path,
+                                 vector<unsigned int> &rows, string_view code,
+                                 unsigned int maxDistance, bool matchPrefix,
+                                 vector<Candidate> &matches,
+                                 string &paths) const {
+    size_t width = code.size() + 1;
+    size_t pathSize = path.size();
+    size_t rowsSize = rows.size();
+    string_view nodeLabel = this->label(node);
+    bool matched = false;
+
+    // The root, with an empty label, is checked against the first row
+    for (size_t i = 0; i <= nodeLabel.size() && !matched; i++) {
+        if (i > 0) {
+            char character = nodeLabel[i - 1];
+            char previousCharacter = i > 1 ? nodeLabel[i - 2]
+                                           : path.empty() ? 0 : path.back();
+            size_t previous = rows.size() - width;
+            bool transposable = rows.size() >= 2 * width;
+
+            rows.push_back(rows[previous] + 1);
+            for (size_t j = 1; j < width; j++) {
+                unsigned int distance = min({rows[previous + j] + 1,
+                                             rows.back() + 1,
+                                             rows[previous + j - 1] +
+                                             (code[j - 1] != character)});
+
+                // Two neighbouring characters typed the wrong way round
+                if (transposable && j > 1 && code[j - 1] == previousCharacter &&
+                    code[j - 2] == character) {
+                    distance = min(distance,
+                                   rows[previous - width + j - 2] + 1);
+                }
+
+                rows.push_back(distance);
+            }
+        }
+
+        const unsigned int *row = &rows[rows.size() - width];
+
+        if (matchPrefix && row[width - 1] <= maxDistance) {
+            matched = true;
+        } else if (*min_element(row, row + width) > maxDistance) {
+            rows.resize(rowsSize);
+            return;
+        }
+    }
+
+    path += nodeLabel;
+
+    Candidate match = {this->nodes[node].bestAmount, node,
+                       static_cast<uint32_t>(paths.size()),
+                       static_cast<uint16_t>(path.size()), false};
+
+    if (matched) {
+        // Every code below the node starts with text close to the code
+        matches.push_back(match);
+        paths += path;
+    } else {
+        if (this->nodes[node].slot != NONE && rows.back() <= maxDistance) {
+            match.amount = this->nodes[node].amount;
+            match.item = true;
+            matches.push_back(match);
+            paths += path;
+        }
+
+        for (uint32_t child = this->nodes[node].firstChild; child != NONE;
+             child = this->nodes[child].nextSibling) {
+            this->collectFuzzy(child, path, rows, code, maxDistance,
+                               matchPrefix, matches, paths);
+        }
+    }
+
+    path.resize(pathSize);
+    rows.resize(rowsSize);
+}
+
+/**
+ * Ranks the items of candidate nodes and items by stock amount, items with
+ * equal stock in order of code. Candidates are visited best first, a node
+ * by the largest stock amount below it, so only the nodes that could hold
+ * one of the best items are visited. Ties are visited in order of path,
+ * which puts every code below a node before any later code.
+ *
+ * @param candidates                nodes (with every item below them) and
+ *                                  items to rank
+ * @param paths                     paths of the candidates, which each
+ *                                  candidate holds a range of
+ * @param limit                     most items to rank
+ * @return                          slots of the best items, best first
+ */
+vector<uint32_t> StockCodeTrie::rankByAmount(vector<Candidate> candidates,
+                                             string paths,
+                                             size_t limit) const {
+    // Lambda for retrieving the path of a candidate
+    auto pathOf = [&paths](const Candidate &candidate) {
+        return string_view(paths).substr(candidate.pathStart,
+                                         candidate.pathLength);
+    };
+
+    // Lambda for checking whether a candidate is visited after another
+    auto later = [&pathOf](const Candidate &candidate1,
+                           const Candidate &candidate2) {
+        if (candidate1.amount != candidate2.amount) {
+            return candidate1.amount < candidate2.amount;
+        }
+
+        int order = pathOf(candidate1).compare(pathOf(candidate2));
+        if (order != 0) {
+            return order > 0;
+        }
+        return !candidate1.item && candidate2.item;
+    };
+
+    priority_queue<Candidate, vector<Candidate>, decltype(later)> queue(
+            later, move(candidates));
+    vector<uint32_t> slots;
+
+    while (!queue.empty() && slots.size() < limit) {
+        Candidate candidate = queue.top();
+        queue.pop();
+
+        const Node &node = this->nodes[candidate.node];
+
+        if (candidate.item) {
+            slots.push_back(node.slot);
+            continue;
+        }
+
+        if (node.slot != NONE) {
+            queue.push({node.amount, candidate.node, candidate.pathStart,
+                        candidate.pathLength, true});
+        }
+
+        // Each child's path is the node's path followed by its label
+        for (uint32_t child = node.firstChild; child != NONE;
+             child = this->nodes[child].nextSibling) {
+            uint32_t pathStart = paths.size();
+            paths.append(paths, candidate.pathStart, candidate.pathLength);
+            paths += this->label(child);
+
+            queue.push({this->nodes[child].bestAmount, child, pathStart,
+                        static_cast<uint16_t>(paths.size() - pathStart),
+                        false});
+        }
+    }
+
+    return slots;
+}
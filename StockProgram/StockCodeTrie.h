@@ -0,0 +1,170 @@
+/******************************************************************************
+ *
+ * File        : StockCodeTrie.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a compressed trie of stock codes,
+ *               for completing partial codes and finding codes close to a
+ *               mistyped one, ranked by stock amount.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef STOCKCODETRIE_H
+#define STOCKCODETRIE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * Radix tree of stock codes, each edge labelled with the run of characters
+ * its codes share, mapping each code to the slot of its item. Nodes are kept
+ * in one array and labels in one string, rather than allocated separately,
+ * and a label is never copied again when its edge is split.
+ * Each node also keeps the largest stock amount below it, so the items with
+ * the most stock under a prefix are found without visiting every code.
+ */
+class StockCodeTrie {
+public:
+    // A node of the trie, reached through the label of the edge into it
+    struct Node {
+        // Label of the edge into the node, a range of the labels, and its
+        // first character (so children are found without reading labels)
+        uint32_t labelStart;
+        uint16_t labelLength;
+        char firstCharacter;
+
+        // First child, children being in order of their first character
+        uint32_t firstChild;
+
+        // Next child of the same parent
+        uint32_t nextSibling;
+
+        // Slot of the item whose code ends at the node (NONE if none) and
+        // its stock amount
+        uint32_t slot;
+        int32_t amount;
+
+        // Largest stock amount of any item at or below the node
+        int32_t bestAmount;
+    };
+
+private:
+    // Marks a missing node or slot
+    static const uint32_t NONE = std::numeric_limits<uint32_t>::max();
+
+    // A node or item waiting to be visited when ranking items by stock
+    struct Candidate {
+        // Stock amount of the item, or largest below the node
+        int32_t amount;
+
+        // Node, or node the item's code ends at
+        uint32_t node;
+
+        // Code of the item, or characters leading to the node, as a range
+        // of the paths of the search
+        uint32_t pathStart;
+        uint16_t pathLength;
+
+        // Whether the candidate is the item of its node
+        bool item;
+    };
+
+    // Nodes of the trie, the root (with an empty label) first
+    std::vector<Node> nodes;
+
+    // Characters of every label
+    std::string labels;
+
+    // Nodes removed from the trie, to be reused
+    std::vector<uint32_t> freeNodes;
+
+    // Amount of codes in the trie
+    size_t size;
+
+    // Retrieves the label of a node
+    std::string_view label(uint32_t node) const;
+
+    // Adds a node to the trie, reusing a removed one if there is one
+    uint32_t newNode(uint32_t labelStart, uint32_t labelLength);
+
+    // Follows a code from the root, noting each node passed through
+    uint32_t findNode(std::string_view code,
+                      std::vector<uint32_t> &path) const;
+
+    // Recomputes the largest stock amount below each node of a path
+    void refreshBestAmounts(const std::vector<uint32_t> &path);
+
+    // Finds the fuzzy matches below a node, for findFuzzy
+    void collectFuzzy(uint32_t node, std::string &path,
+                      std::vector<unsigned int> &rows, std::string_view code,
+                      unsigned int maxDistance, bool matchPrefix,
+                      std::vector<Candidate> &matches,
+                      std::string &paths) const;
+
+    // Ranks the items of candidates by stock amount, up to a limit
+    std::vector<uint32_t> rankByAmount(std::vector<Candidate> candidates,
+                                       std::string paths, size_t limit) const;
+
+public:
+    // StockCodeTrie Constructor
+    StockCodeTrie();
+
+    // Adds a code to the trie, unless it is already in it
+    bool insert(std::string_view code, uint32_t slot, int amount);
+
+    // Removes a code from the trie if it is held for the given slot
+    bool erase(std::string_view code, uint32_t slot);
+
+    // Updates the stock amount of a code if it is held for the given slot
+    bool updateAmount(std::string_view code, uint32_t slot, int amount);
+
+    // Finds the slot of a code, returning false if it is not in the trie
+    bool find(std::string_view code, uint32_t &slot) const;
+
+    // Moves every slot to its new slot after others were removed, the new
+    // slots keeping the order of the old
+    void renumber(const std::vector<uint32_t> &newSlots);
+
+    // Removes every code from the trie
+    void clear();
+
+    // Retrieves the nodes of the trie and the characters of their labels,
+    // so they can be stored and restored without adding every code again
+    const std::vector<Node> &getNodes() const;
+    std::string_view getLabels() const;
+
+    // Replaces the trie with stored nodes and labels, returning false (and
+    // leaving the trie empty) if they do not form a trie of the slots
+    bool restore(std::vector<Node> storedNodes, std::string storedLabels,
+                 const std::vector<int> &amounts);
+
+    // Retrieves the amount of codes in the trie
+    size_t getSize() const;
+
+    // Retrieves the bytes of memory allocated for the trie
+    size_t getMemoryUsage() const;
+
+    // Lays the nodes out again, each node's children next to each other
+    void compact();
+
+    // Finds the codes starting with a prefix, most stock first
+    std::vector<uint32_t> findPrefix(
+            std::string_view prefix,
+            size_t limit = std::numeric_limits<size_t>::max()) const;
+
+    // Finds the codes within an edit distance of a code (or starting with
+    // text within the distance of it), most stock first
+    std::vector<uint32_t> findFuzzy(
+            std::string_view code, unsigned int maxDistance,
+            bool matchPrefix = false,
+            size_t limit = std::numeric_limits<size_t>::max()) const;
+};
+
+#endif /* STOCKCODETRIE_H */
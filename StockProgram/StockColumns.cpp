@@ -0,0 +1,225 @@
+/******************************************************************************
+ *
+ * File        : StockColumns.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define the columnar storage of an inventory's
+ *               stock items.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include "StockColumns.h"
+#include "StringPool.h"
+
+using namespace std;
+
+/**
+ * Constructs empty columns
+ */
+StockColumns::StockColumns() {
+}
+
+/**
+ * Adds an item to the end of the columns
+ *
+ * @param item                      item to add
+ * @return                          slot the item was stored in
+ */
+uint32_t StockColumns::add(StockItem *item) {
+    uint32_t slot = this->items.size();
+
+    this->items.push_back(item);
+    this->componentTypes.push_back(item->getType());
+    this->stockAmounts.push_back(0);
+    this->unitPrices.push_back(0);
+    this->values.push_back(0);
+    this->deviceTypes.push_back(DeviceType::NPN);
+    this->codeIds.push_back(0);
+
+    this->update(slot);
+
+    return slot;
+}
+
+/**
+ * Refreshes the attributes stored for the item in a slot, after the item has
+ * been changed
+ *
+ * @param slot                      slot of item to refresh
+ */
+void StockColumns::update(uint32_t slot) {
+    StockItem *item = this->items[slot];
+
+    this->stockAmounts[slot] = item->getStockAmount();
+    this->unitPrices[slot] = item->getUnitPrice();
+    this->codeIds[slot] = item->getStockCodeId();
+
+    // Stores the attributes specific to each type of item
+    switch (this->componentTypes[slot]) {
+        case ComponentType::Resistor:
+            this->values[slot] = static_cast<Resistor *>(item)
+                    ->getResistance();
+            break;
+        case ComponentType::Capacitor:
+            this->values[slot] = static_cast<Capacitor *>(item)
+                    ->getCapacitance();
+            break;
+        case ComponentType::Transistor:
+            this->deviceTypes[slot] = static_cast<Transistor *>(item)
+                    ->getDeviceType();
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Removes the items in some slots, moving the attributes of every item after
+ * the first of them down in one pass, so the slots stay dense and keep the
+ * order the items were added
+ *
+ * @param slots                     slots of items to remove, in increasing
+ *                                  order
+ */
+void StockColumns::remove(const vector<uint32_t> &slots) {
+    if (slots.empty()) {
+        return;
+    }
+
+    uint32_t slot = slots.front();
+    size_t next = 0;
+
+    for (uint32_t oldSlot = slot; oldSlot < this->items.size(); oldSlot++) {
+        if (next < slots.size() && slots[next] == oldSlot) {
+            next++;
+            continue;
+        }
+
+        this->items[slot] = this->items[oldSlot];
+        this->componentTypes[slot] = this->componentTypes[oldSlot];
+        this->stockAmounts[slot] = this->stockAmounts[oldSlot];
+        this->unitPrices[slot] = this->unitPrices[oldSlot];
+        this->values[slot] = this->values[oldSlot];
+        this->deviceTypes[slot] = this->deviceTypes[oldSlot];
+        this->codeIds[slot] = this->codeIds[oldSlot];
+        slot++;
+    }
+
+    this->items.resize(slot);
+    this->componentTypes.resize(slot);
+    this->stockAmounts.resize(slot);
+    this->unitPrices.resize(slot);
+    this->values.resize(slot);
+    this->deviceTypes.resize(slot);
+    this->codeIds.resize(slot);
+}
+
+/**
+ * Removes every item from the columns
+ */
+void StockColumns::clear() {
+    this->componentTypes.clear();
+    this->stockAmounts.clear();
+    this->unitPrices.clear();
+    this->values.clear();
+    this->deviceTypes.clear();
+    this->codeIds.clear();
+    this->items.clear();
+}
+
+/**
+ * Retrieves the amount of slots in the columns
+ *
+ * @return                          amount of slots
+ */
+size_t StockColumns::getSize() const {
+    return this->items.size();
+}
+
+/**
+ * Retrieves a stock code by its id, which is its handle in the global
+ * string pool
+ *
+ * @param codeId                    id of the code
+ * @return                          stock code
+ */
+string_view StockColumns::getCode(uint32_t codeId) const {
+    return StringPool::global().get(codeId);
+}
+
+/**
+ * Finds the id of a stock code without interning it
+ *
+ * @param code                      stock code to find
+ * @param codeId                    set to the id of the code if found
+ * @return                          true if the code has been interned
+ */
+bool StockColumns::findCode(string_view code, uint32_t &codeId) const {
+    return StringPool::global().find(code, codeId);
+}
+
+/**
+ * Retrieves the component type column
+ *
+ * @return                          component type of each slot
+ */
+const vector<ComponentType> &StockColumns::getComponentTypes() const {
+    return this->componentTypes;
+}
+
+/**
+ * Retrieves the stock amount column
+ *
+ * @return                          stock amount of each slot
+ */
+const vector<int> &StockColumns::getStockAmounts() const {
+    return this->stockAmounts;
+}
+
+/**
+ * Retrieves the unit price column
+ *
+ * @return                          unit price of each slot
+ */
+const vector<int> &StockColumns::getUnitPrices() const {
+    return this->unitPrices;
+}
+
+/**
+ * Retrieves the resistance/capacitance column
+ *
+ * @return                          resistance or capacitance of each slot
+ */
+const vector<double> &StockColumns::getValues() const {
+    return this->values;
+}
+
+/**
+ * Retrieves the device type column
+ *
+ * @return                          device type of each slot
+ */
+const vector<DeviceType> &StockColumns::getDeviceTypes() const {
+    return this->deviceTypes;
+}
+
+/**
+ * Retrieves the interned stock code column
+ *
+ * @return                          stock code id of each slot
+ */
+const vector<uint32_t> &StockColumns::getCodeIds() const {
+    return this->codeIds;
+}
+
+/**
+ * Retrieves the stock item of each slot
+ *
+ * @return                          stock item of each slot
+ */
+const vector<StockItem *> &StockColumns::getItems() const {
+    return this->items;
+}
@@ -0,0 +1,95 @@
+/******************************************************************************
+ *
+ * File        : StockColumns.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define the columnar storage of an
+ *               inventory's stock items.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef STOCKCOLUMNS_H
+#define STOCKCOLUMNS_H
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "StockItem.h"
+
+/**
+ * Stores the attributes of stock items as contiguous arrays (one per
+ * attribute) so that scans over many items only touch the attributes they
+ * need. Each item occupies one slot, in the order the items were added.
+ */
+class StockColumns {
+private:
+    // Component type of each item
+    std::vector<ComponentType> componentTypes;
+
+    // Stock amount of each item
+    std::vector<int> stockAmounts;
+
+    // Unit price of each item in pence
+    std::vector<int> unitPrices;
+
+    // Resistance in ohms of resistors, capacitance in picofarads of
+    // capacitors, 0 for all other items
+    std::vector<double> values;
+
+    // Device type of transistors (NPN for all other items)
+    std::vector<DeviceType> deviceTypes;
+
+    // Stock code of each item, as its handle in the global string pool
+    std::vector<uint32_t> codeIds;
+
+    // Stock item the attributes of each slot belong to
+    std::vector<StockItem *> items;
+
+public:
+    // StockColumns Constructor
+    StockColumns();
+
+    // Columns are tied to the items they store, so cannot be copied
+    StockColumns(const StockColumns &columns) = delete;
+    StockColumns &operator=(const StockColumns &columns) = delete;
+
+    // Columns can be moved to a new owner
+    StockColumns(StockColumns &&columns) = default;
+    StockColumns &operator=(StockColumns &&columns) = default;
+
+    // Adds an item to the columns, returning its slot
+    uint32_t add(StockItem *item);
+
+    // Refreshes the attributes stored for the item in a slot
+    void update(uint32_t slot);
+
+    // Removes the items in some slots, moving the items after them down so
+    // the slots stay dense and in order
+    void remove(const std::vector<uint32_t> &slots);
+
+    // Removes every item from the columns
+    void clear();
+
+    // Retrieves the amount of slots in the columns
+    size_t getSize() const;
+
+    // Retrieves a stock code by its id
+    std::string_view getCode(uint32_t codeId) const;
+
+    // Finds the id of a stock code, returning false if it is not interned
+    bool findCode(std::string_view code, uint32_t &codeId) const;
+
+    // Retrieves each column
+    const std::vector<ComponentType> &getComponentTypes() const;
+    const std::vector<int> &getStockAmounts() const;
+    const std::vector<int> &getUnitPrices() const;
+    const std::vector<double> &getValues() const;
+    const std::vector<DeviceType> &getDeviceTypes() const;
+    const std::vector<uint32_t> &getCodeIds() const;
+    const std::vector<StockItem *> &getItems() const;
+};
+
+#endif /* STOCKCOLUMNS_H */
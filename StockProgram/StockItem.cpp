@@ -12,10 +12,49 @@
  *
  ******************************************************************************/
 
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
 #include "StockItem.h"
+#include "StringPool.h"
 
 using namespace std;
 
+// COMPONENT TYPE (ENUM) CODE
+
+/**
+ * Retrieves the display name of a component type
+ *
+ * @param componentType         component type to name
+ * @return                      name of component type
+ */
+const string &componentTypeName(ComponentType componentType) {
+    static const string names[] = {"Resistor", "Capacitor", "Diode",
+                                   "Transistor", "Integrated Circuit"};
+
+    return names[static_cast<int>(componentType)];
+}
+
+/**
+ * Finds the component type with a display name
+ *
+ * @param name                  display name of component type
+ * @param componentType         set to the matching component type
+ * @return                      true if a component type has the name
+ */
+bool componentTypeNamed(string_view name, ComponentType &componentType) {
+    for (int i = 0; i < COMPONENT_TYPE_COUNT; i++) {
+        if (componentTypeName(static_cast<ComponentType>(i)) == name) {
+            componentType = static_cast<ComponentType>(i);
+            return true;
+        }
+    }
+
+    return false;
+}
+
 // STOCKITEM CODE
 
 /**
@@ -26,21 +65,70 @@ using namespace std;
  * @param amount                stock amount
  * @param price                 unit price of item
  */
-StockItem::StockItem(const string &compType, const string &code, int amount,
+StockItem::StockItem(ComponentType compType, string_view code, int amount,
                      int price) {
     this->componentType = compType;
-    this->stockCode = code;
+    this->stockCodeId = StringPool::global().intern(code);
+    this->stockAmount = 0;
+    this->unitPrice = 0;
+    this->observer = nullptr;
+    this->slot = 0;
+    this->reservationCount = 0;
 
     this->setStockAmount(amount);
     this->setUnitPrice(price);
 }
 
+/**
+ * Constructs a copy of a stock item. The copy is not attached to the
+ * original's inventory, only the inventory that adds it may attach it, and
+ * holds none of the original's reservations.
+ *
+ * @param item                  item to copy
+ */
+StockItem::StockItem(const StockItem &item)
+        : componentType(item.componentType), stockCodeId(item.stockCodeId),
+          stockAmount(item.stockAmount.load()), unitPrice(item.unitPrice),
+          observer(nullptr), slot(0), reservationCount(0) {
+}
+
+/**
+ * Assigns the details of another stock item to this item, which stays
+ * attached to its own inventory (if any) rather than the other item's
+ *
+ * @param item                  item to copy
+ * @return                      this item
+ */
+StockItem &StockItem::operator=(const StockItem &item) {
+    this->componentType = item.componentType;
+    this->stockCodeId = item.stockCodeId;
+    this->stockAmount.store(item.stockAmount.load());
+    this->unitPrice = item.unitPrice;
+
+    return *this;
+}
+
+/**
+ * Destructs a stock item
+ */
+StockItem::~StockItem() {
+}
+
 /**
  * Retrieves the component type of an item
  *
  * @return                      item's component type
  */
-string StockItem::getComponentType() {
+string_view StockItem::getComponentType() const {
+    return componentTypeName(this->componentType);
+}
+
+/**
+ * Retrieves the component type of an item as its enum value
+ *
+ * @return                      item's component type
+ */
+ComponentType StockItem::getType() const {
     return this->componentType;
 }
 
@@ -49,8 +137,18 @@ string StockItem::getComponentType() {
  *
  * @return                      stock code of item
  */
-string StockItem::getStockCode() const {
-    return this->stockCode;
+string_view StockItem::getStockCode() const {
+    return StringPool::global().get(this->stockCodeId);
+}
+
+/**
+ * Retrieves the handle of this item's stock code in the global string pool,
+ * which equals the handle of any other item with the same code
+ *
+ * @return                      handle of stock code
+ */
+uint32_t StockItem::getStockCodeId() const {
+    return this->stockCodeId;
 }
 
 /**
@@ -59,7 +157,7 @@ string StockItem::getStockCode() const {
  * @return                      stock amount of item
  */
 int StockItem::getStockAmount() const {
-    return this->stockAmount;
+    return this->stockAmount.load();
 }
 
 /**
@@ -72,12 +170,24 @@ int StockItem::getUnitPrice() const {
 }
 
 /**
- * Sets the stock code of an item to a new code
+ * Sets the stock code of an item to a new code, unless the observer refuses
+ * it
  *
  * @param code                  new stock code
+ * @throws invalid_argument     if the observer refuses the code
  */
-void StockItem::setStockCode(const string &code) {
-    this->stockCode = code;
+void StockItem::setStockCode(string_view code) {
+    if (this->observer != nullptr) {
+        this->observer->stockCodeChanging(*this, code);
+    }
+
+    // Pooled strings are never freed, so the old code stays valid
+    string_view oldCode = this->getStockCode();
+    this->stockCodeId = StringPool::global().intern(code);
+
+    if (this->observer != nullptr) {
+        this->observer->stockCodeChanged(*this, oldCode);
+    }
 }
 
 /**
@@ -88,7 +198,11 @@ void StockItem::setStockCode(const string &code) {
 void StockItem::setStockAmount(int amount) {
     // Error checking for stock amount ensuring it must be greater than zero
     if (amount >= 0) {
-        this->stockAmount = amount;
+        int oldAmount = this->stockAmount.exchange(amount);
+
+        if (this->observer != nullptr) {
+            this->observer->stockAmountChanged(*this, oldAmount);
+        }
     } else {
         throw invalid_argument("Stock amount for item must be greater than 0.");
     }
@@ -102,12 +216,115 @@ void StockItem::setStockAmount(int amount) {
 void StockItem::setUnitPrice(int price) {
     // Error checking for unit price ensuring it must be greater than zero
     if (price > 0) {
+        int oldPrice = this->unitPrice;
         this->unitPrice = price;
+
+        if (this->observer != nullptr) {
+            this->observer->unitPriceChanged(*this, oldPrice);
+        }
     } else {
         throw invalid_argument("Unit price for item must be greater than 0.");
     }
 }
 
+/**
+ * Takes an amount of stock from this item, only if at least that much is
+ * left, so the stock amount never goes below zero. Many threads may take
+ * stock from the same item at once, as the amount is changed by compare and
+ * swap rather than under a lock. The observer is not notified (see
+ * Inventory::syncStockAmounts).
+ *
+ * @param quantity              amount of stock to take
+ * @return                      true if the stock was taken
+ */
+bool StockItem::tryTakeStock(int quantity) {
+    if (quantity <= 0) {
+        throw invalid_argument("Quantity of stock must be greater than 0.");
+    }
+
+    int amount = this->stockAmount.load(memory_order_relaxed);
+
+    // Retries with the latest amount whenever another thread changes it
+    // first
+    while (amount >= quantity) {
+        if (this->stockAmount.compare_exchange_weak(amount,
+                                                    amount - quantity)) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Puts back an amount of stock taken from this item. Safe to call from many
+ * threads at once, and the observer is not notified.
+ *
+ * @param quantity              amount of stock to put back
+ */
+void StockItem::returnStock(int quantity) {
+    if (quantity <= 0) {
+        throw invalid_argument("Quantity of stock must be greater than 0.");
+    }
+
+    this->stockAmount.fetch_add(quantity);
+}
+
+/**
+ * Counts a reservation of this item's stock as pending, until it is settled
+ * by settleReservation. Safe to call from many threads at once.
+ */
+void StockItem::holdReservation() {
+    this->reservationCount.fetch_add(1);
+}
+
+/**
+ * Counts a reservation of this item's stock as settled, having been
+ * committed or released. Safe to call from many threads at once.
+ */
+void StockItem::settleReservation() {
+    this->reservationCount.fetch_sub(1);
+}
+
+/**
+ * Checks whether any reservation of this item's stock is still pending, in
+ * which case the item must not be destroyed
+ *
+ * @return                      true if a reservation is pending
+ */
+bool StockItem::hasPendingReservations() const {
+    return this->reservationCount.load() > 0;
+}
+
+/**
+ * Attaches an observer to be notified of any changes to this item
+ *
+ * @param observer              observer to notify (null to detach)
+ * @param slot                  position of item in observer's storage
+ */
+void StockItem::attach(StockItemObserver *observer, uint32_t slot) {
+    this->observer = observer;
+    this->slot = slot;
+}
+
+/**
+ * Retrieves the position of the item in its observer's storage
+ *
+ * @return                      slot of item
+ */
+uint32_t StockItem::getSlot() const {
+    return this->slot;
+}
+
+/**
+ * Notifies the observer (if any) that a type specific attribute has changed
+ */
+void StockItem::notifyAttributeChanged() {
+    if (this->observer != nullptr) {
+        this->observer->attributeChanged(*this);
+    }
+}
+
 /**
  * Overloads the output operator to stream details specific to the item.
  *
@@ -129,12 +346,26 @@ ostream &operator<<(ostream &os, const StockItem &item) {
  * @param price                 unit price of item
  * @param resistanceCode        code representing resistance
  */
-Resistor::Resistor(const string &code, int amount, int price,
+Resistor::Resistor(string_view code, int amount, int price,
                    const string &resistanceCode)
-        : StockItem("Resistor", code, amount, price) {
+        : StockItem(ComponentType::Resistor, code, amount, price) {
     this->setResistance(resistanceCode);
 }
 
+/**
+ * Constructs a new resistor whose resistance has already been decoded,
+ *
+ * @param code                  stock code of item
+ * @param amount                stock amount
+ * @param price                 unit price of item
+ * @param resistance            resistance of item in ohms
+ */
+Resistor::Resistor(string_view code, int amount, int price,
+                   double resistance)
+        : StockItem(ComponentType::Resistor, code, amount, price) {
+    this->resistance = resistance;
+}
+
 /**
  * Retrieves the resistance of this item in Ohms
  *
@@ -151,6 +382,17 @@ double Resistor::getResistance() const {
  */
 void Resistor::setResistance(const string &resistanceCode) {
     this->resistance = Resistor::calculateResistance(resistanceCode);
+    this->notifyAttributeChanged();
+}
+
+/**
+ * Sets the resistance of a resistor already decoded into ohms
+ *
+ * @param resistance            resistance in ohms
+ */
+void Resistor::setResistance(double resistance) {
+    this->resistance = resistance;
+    this->notifyAttributeChanged();
 }
 
 /**
@@ -159,33 +401,58 @@ void Resistor::setResistance(const string &resistanceCode) {
  * @param resistanceCode        resistor code to calculate
  * @return                      resistance of item
  */
-double Resistor::calculateResistance(string resistanceCode) {
+double Resistor::calculateResistance(string_view resistanceCode) {
     double specialCharAmount = 1;
 
+    // Codes are short, so they are copied onto the stack rather than the heap
+    // (long codes fall back to a heap copy)
+    char stackCode[64];
+    string heapCode;
+    char *code = stackCode;
+
+    if (resistanceCode.size() >= sizeof(stackCode)) {
+        heapCode.assign(resistanceCode.data(), resistanceCode.size());
+        code = &heapCode[0];
+    } else {
+        memcpy(stackCode, resistanceCode.data(), resistanceCode.size());
+        stackCode[resistanceCode.size()] = '\0';
+    }
+
     // iterates through code converting special characters to a
     // decimal point to then be multiplied by
-    for (char &c : resistanceCode) {
-        switch (c) {
+    for (char *c = code; *c != '\0'; c++) {
+        switch (*c) {
             case ('M'): {
-                c = '.';
+                *c = '.';
                 specialCharAmount = 1000000;
                 break;
             }
             case ('K'): {
-                c = '.';
+                *c = '.';
                 specialCharAmount = 1000;
                 break;
             }
             case ('R'): {
-                c = '.';
+                *c = '.';
                 specialCharAmount = 1;
                 break;
             }
         }
     }
 
+    // Converts the number with the same error handling as stod
+    char *end;
+    errno = 0;
+    double value = strtod(code, &end);
+
+    if (end == code) {
+        throw invalid_argument("Invalid resistance code.");
+    } else if (errno == ERANGE) {
+        throw out_of_range("Resistance code out of range.");
+    }
+
     // Stores final resistance value in ohms
-    double ohms = stod(resistanceCode) * specialCharAmount;
+    double ohms = value * specialCharAmount;
 
     return ohms;
 }
@@ -197,9 +464,10 @@ double Resistor::calculateResistance(string resistanceCode) {
  * @return                     outstream with resistor info
  */
 ostream &Resistor::print(ostream &os) const {
-    return os << "Component Type: " << this->componentType << endl
-              << "Stock Code: " << this->stockCode << endl
-              << "Stock Amount: " << this->stockAmount << endl
+    return os << "Component Type: " << componentTypeName(this->componentType)
+              << endl
+              << "Stock Code: " << this->getStockCode() << endl
+              << "Stock Amount: " << this->getStockAmount() << endl
               << "Unit Price: " << this->unitPrice << "p" << endl
               << "Total Resistance: " << fixed << setprecision(2)
               << this->resistance << "ohms" << endl;
@@ -215,18 +483,32 @@ ostream &Resistor::print(ostream &os) const {
  * @param price                     unit price of item
  * @param capacitance               capacitance as string e.g 100pf, 10nf
  */
-Capacitor::Capacitor(const string &code, int amount, int price,
+Capacitor::Capacitor(string_view code, int amount, int price,
                      const string &capacitance)
-        : StockItem("Capacitor", code, amount, price) {
+        : StockItem(ComponentType::Capacitor, code, amount, price) {
     this->setCapacitance(capacitance);
 }
 
 /**
- * Retrieves the capacitance of this item in Farads
+ * Constructs a new capacitor whose capacitance has already been decoded,
+ *
+ * @param code                      stock code of item
+ * @param amount                    stock amount
+ * @param price                     unit price of item
+ * @param capacitance               capacitance of item in picofarads
+ */
+Capacitor::Capacitor(string_view code, int amount, int price,
+                     double capacitance)
+        : StockItem(ComponentType::Capacitor, code, amount, price) {
+    this->capacitance = capacitance;
+}
+
+/**
+ * Retrieves the capacitance of this item in picofarads
  *
  * @return                          capacitance of item
  */
-int Capacitor::getCapacitance() const {
+double Capacitor::getCapacitance() const {
     return this->capacitance;
 }
 
@@ -237,6 +519,17 @@ int Capacitor::getCapacitance() const {
  */
 void Capacitor::setCapacitance(const string &capacitance) {
     this->capacitance = Capacitor::convertToPicoFarads(capacitance);
+    this->notifyAttributeChanged();
+}
+
+/**
+ * Sets the capacitance of a capacitor already decoded into picofarads
+ *
+ * @param capacitance           capacitance in picofarads
+ */
+void Capacitor::setCapacitance(double capacitance) {
+    this->capacitance = capacitance;
+    this->notifyAttributeChanged();
 }
 
 /**
@@ -245,19 +538,35 @@ void Capacitor::setCapacitance(const string &capacitance) {
  * @param capacitance               capacitance as string e.g 100pf, 10nf
  * @return                          capacitance of item in picofarads
  */
-double Capacitor::convertToPicoFarads(const string capacitance) {
-    string picoFaradString;
+double Capacitor::convertToPicoFarads(string_view capacitance) {
+    long long picoFaradDigits = 0;
+    size_t digitCount = 0;
+    bool digitsOutOfRange = false;
     double picoFaradAmount = 0;
 
     // Loops through each character in the capacitance string,
     // to figure out the capacitance in picofarads
     for (const char &c : capacitance) {
-        // Stores number values only in picoFaradString
+        // Accumulates number values only
         if (isdigit(c)) {
-            picoFaradString += c;
+            // Stops accumulating once past the range of an int, which is
+            // only an error if a suffix follows (as stoi was only called
+            // then)
+            if (!digitsOutOfRange) {
+                picoFaradDigits = picoFaradDigits * 10 + (c - '0');
+                digitsOutOfRange =
+                        picoFaradDigits > numeric_limits<int>::max();
+            }
+            digitCount++;
         } else {
-            // Performs conversion to picofarads once suffix is reached
-            picoFaradAmount = stoi(picoFaradString);
+            // Performs conversion to picofarads once suffix is reached,
+            // with the checks stoi would make on the digits
+            if (digitCount == 0) {
+                throw invalid_argument("Invalid capacitance.");
+            } else if (digitsOutOfRange) {
+                throw out_of_range("Capacitance out of range.");
+            }
+            picoFaradAmount = picoFaradDigits;
 
             switch (c) {
                 case 'm' : { // Convert millifards to picofarads
@@ -290,9 +599,10 @@ double Capacitor::convertToPicoFarads(const string capacitance) {
  * @return                     outstream with capacitor info
  */
 ostream &Capacitor::print(ostream &os) const {
-    return os << "Component Type: " << this->componentType << endl
-              << "Stock Code: " << this->stockCode << endl
-              << "Stock Amount: " << this->stockAmount << endl
+    return os << "Component Type: " << componentTypeName(this->componentType)
+              << endl
+              << "Stock Code: " << this->getStockCode() << endl
+              << "Stock Amount: " << this->getStockAmount() << endl
               << "Unit Price: " << this->unitPrice << "p" << endl
               << "Total Capacitance: " << fixed << setprecision(0)
               << this->capacitance << "pf" << endl;
@@ -307,8 +617,8 @@ ostream &Capacitor::print(ostream &os) const {
  * @param amount                    stock amount
  * @param price                     unit price of item
  */
-Diode::Diode(const string &code, int amount, int price)
-        : StockItem("Diode", code, amount, price) {
+Diode::Diode(string_view code, int amount, int price)
+        : StockItem(ComponentType::Diode, code, amount, price) {
 
 }
 
@@ -319,34 +629,45 @@ Diode::Diode(const string &code, int amount, int price)
  * @return                     outstream with diode info
  */
 ostream &Diode::print(ostream &os) const {
-    return os << "Component Type: " << this->componentType << endl
-              << "Stock Code: " << this->stockCode << endl
-              << "Stock Amount: " << this->stockAmount << endl
+    return os << "Component Type: " << componentTypeName(this->componentType)
+              << endl
+              << "Stock Code: " << this->getStockCode() << endl
+              << "Stock Amount: " << this->getStockAmount() << endl
               << "Unit Price: " << this->unitPrice << "p" << endl;
 }
 
 // DEVICE TYPE (ENUM) CODE
 
 /**
- * Overloads the output operator to stream name of a device.
+ * Retrieves the name of a device type
  *
- * @param os                        the output stream to send info to
- * @param deviceType                deviceType to stream name about
- * @return                          outstream with deviceType name
+ * @param deviceType                device type to name
+ * @return                          name of device type
  */
-ostream &operator<<(ostream &os, const DeviceType &deviceType) {
+string_view deviceTypeName(DeviceType deviceType) {
     switch (deviceType) {
         case DeviceType::NPN :
-            return os << "NPN";
+            return "NPN";
         case DeviceType::PNP :
-            return os << "PNP";
+            return "PNP";
         case DeviceType::FET :
-            return os << "FET";
+            return "FET";
         default:
-            return os;
+            return "";
     }
 }
 
+/**
+ * Overloads the output operator to stream name of a device.
+ *
+ * @param os                        the output stream to send info to
+ * @param deviceType                deviceType to stream name about
+ * @return                          outstream with deviceType name
+ */
+ostream &operator<<(ostream &os, const DeviceType &deviceType) {
+    return os << deviceTypeName(deviceType);
+}
+
 // TRANSISTOR CODE
 
 /**
@@ -357,12 +678,26 @@ ostream &operator<<(ostream &os, const DeviceType &deviceType) {
  * @param price                     unit price of item
  * @param deviceType                device type of transistor
  */
-Transistor::Transistor(const string &code, int amount, int price,
+Transistor::Transistor(string_view code, int amount, int price,
                        const string &deviceType)
-        : StockItem("Transistor", code, amount, price) {
+        : StockItem(ComponentType::Transistor, code, amount, price) {
     this->setDeviceType(deviceType);
 }
 
+/**
+ * Constructs a new transistor whose device type has already been decoded,
+ *
+ * @param code                      stock code of item
+ * @param amount                    stock amount
+ * @param price                     unit price of item
+ * @param deviceType                device type of transistor
+ */
+Transistor::Transistor(string_view code, int amount, int price,
+                       DeviceType deviceType)
+        : StockItem(ComponentType::Transistor, code, amount, price) {
+    this->deviceType = deviceType;
+}
+
 /**
  * Retrieves the device type of this transistor
  *
@@ -378,20 +713,37 @@ DeviceType Transistor::getDeviceType() const {
  * @param deviceType                new device type of transistor
  */
 void Transistor::setDeviceType(const string &deviceType) {
-    DeviceType newDeviceType;
+    this->deviceType = Transistor::parseDeviceType(deviceType);
+    this->notifyAttributeChanged();
+}
 
+/**
+ * Sets the device type of a transistor already decoded
+ *
+ * @param deviceType            device type of transistor
+ */
+void Transistor::setDeviceType(DeviceType deviceType) {
+    this->deviceType = deviceType;
+    this->notifyAttributeChanged();
+}
+
+/**
+ * Converts a device type name into its enum value
+ *
+ * @param deviceType                device type name {NPN, PNP, FET}
+ * @return                          matching device type
+ */
+DeviceType Transistor::parseDeviceType(string_view deviceType) {
     // Converts from string to Device enum type
     if (deviceType == "NPN") {
-        newDeviceType = DeviceType::NPN;
+        return DeviceType::NPN;
     } else if (deviceType == "PNP") {
-        newDeviceType = DeviceType::PNP;
+        return DeviceType::PNP;
     } else if (deviceType == "FET") {
-        newDeviceType = DeviceType::FET;
+        return DeviceType::FET;
     } else {
         throw invalid_argument("Invalid device type for transistor.");
     }
-
-    this->deviceType = newDeviceType;
 }
 
 /**
@@ -401,9 +753,10 @@ void Transistor::setDeviceType(const string &deviceType) {
  * @return                     outstream with transistor info
  */
 ostream &Transistor::print(ostream &os) const {
-    return os << "Component Type: " << this->componentType << endl
-              << "Stock Code: " << this->stockCode << endl
-              << "Stock Amount: " << this->stockAmount << endl
+    return os << "Component Type: " << componentTypeName(this->componentType)
+              << endl
+              << "Stock Code: " << this->getStockCode() << endl
+              << "Stock Amount: " << this->getStockAmount() << endl
               << "Unit Price: " << this->unitPrice << "p" << endl
               << "Device Type: " << this->deviceType << endl;
 }
@@ -418,10 +771,10 @@ ostream &Transistor::print(ostream &os) const {
  * @param price                     unit price of item
  * @param description               integrated circuit description
  */
-IntegratedCircuit::IntegratedCircuit(const string &code, int amount, int price,
-                                     const string &description)
-        : StockItem("Integrated Circuit", code, amount, price) {
-    this->description = description;
+IntegratedCircuit::IntegratedCircuit(string_view code, int amount, int price,
+                                     string_view description)
+        : StockItem(ComponentType::IntegratedCircuit, code, amount, price) {
+    this->descriptionId = StringPool::global().intern(description);
 }
 
 /**
@@ -429,8 +782,19 @@ IntegratedCircuit::IntegratedCircuit(const string &code, int amount, int price,
  *
  * @return                          integrated circuit description
  */
-string IntegratedCircuit::getDescription() const {
-    return this->description;
+string_view IntegratedCircuit::getDescription() const {
+    return StringPool::global().get(this->descriptionId);
+}
+
+/**
+ * Retrieves the handle of this integrated circuit's description in the
+ * global string pool, which equals the handle of any other item with the
+ * same description
+ *
+ * @return                          handle of description
+ */
+uint32_t IntegratedCircuit::getDescriptionId() const {
+    return this->descriptionId;
 }
 
 /**
@@ -438,8 +802,9 @@ string IntegratedCircuit::getDescription() const {
  *
  * @param description               new integrated circuit description
  */
-void IntegratedCircuit::setDescription(const string &description) {
-    this->description = description;
+void IntegratedCircuit::setDescription(string_view description) {
+    this->descriptionId = StringPool::global().intern(description);
+    this->notifyAttributeChanged();
 }
 
 /**
@@ -449,9 +814,10 @@ void IntegratedCircuit::setDescription(const string &description) {
  * @return                     outstream with integrated circuit info
  */
 ostream &IntegratedCircuit::print(ostream &os) const {
-    return os << "Component Type: " << this->componentType << endl
-              << "Stock Code: " << this->stockCode << endl
-              << "Stock Amount: " << this->stockAmount << endl
+    return os << "Component Type: " << componentTypeName(this->componentType)
+              << endl
+              << "Stock Code: " << this->getStockCode() << endl
+              << "Stock Amount: " << this->getStockAmount() << endl
               << "Unit Price: " << this->unitPrice << "p" << endl
-              << "Description: " << this->description << endl;
+              << "Description: " << this->getDescription() << endl;
 }
@@ -15,8 +15,64 @@
 #ifndef STOCKITEM_H
 #define STOCKITEM_H
 
+#include <atomic>
+#include <cstdint>
 #include <iostream>
 #include <iomanip>
+#include <string>
+#include <string_view>
+
+// Component types of a stock item
+enum class ComponentType : uint8_t {
+    Resistor, Capacitor, Diode, Transistor, IntegratedCircuit
+};
+
+// Amount of component types
+const int COMPONENT_TYPE_COUNT = 5;
+
+// Retrieves the display name of a component type
+const std::string &componentTypeName(ComponentType componentType);
+
+// Finds the component type with a display name
+bool componentTypeNamed(std::string_view name, ComponentType &componentType);
+
+class StockItem;
+
+/**
+ * Interface for being notified of changes made to a stock item, letting an
+ * owner keep anything derived from its items up to date
+ */
+class StockItemObserver {
+public:
+    // StockItemObserver Destructor
+    virtual ~StockItemObserver() {}
+
+    // Called before the stock code of an item changes, throwing to refuse
+    // the new code
+    virtual void stockCodeChanging(StockItem &item,
+                                   std::string_view newCode) {}
+
+    // Called after the stock code of an item has changed
+    virtual void stockCodeChanged(StockItem &item,
+                                  std::string_view oldCode) {}
+
+    // Called after the stock amount of an item has changed
+    virtual void stockAmountChanged(StockItem &item, int oldAmount) {}
+
+    // Called after the unit price of an item has changed
+    virtual void unitPriceChanged(StockItem &item, int oldPrice) {}
+
+    // Called after an attribute specific to the item's type has changed
+    virtual void attributeChanged(StockItem &item) {}
+
+    // Called after an item has been added to an inventory watched by the
+    // observer
+    virtual void itemAdded(StockItem &item) {}
+
+    // Called before an item is removed from an inventory watched by the
+    // observer
+    virtual void itemRemoved(StockItem &item) {}
+};
 
 /**
  * Models an abstract stock item
@@ -24,27 +80,57 @@
 class StockItem {
 protected:
     // Item's component type (resistor, capacitor, diode, etc)
-    std::string componentType;
+    ComponentType componentType;
 
-    // Unique stock code of an item.
-    std::string stockCode;
+    // Unique stock code of an item, as its handle in the global string pool
+    uint32_t stockCodeId;
 
-    // Number of items left in stock.
-    int stockAmount;
+    // Number of items left in stock. Atomic, so that order fulfilment
+    // threads can take stock from the same item at once.
+    std::atomic<int> stockAmount;
 
     // Unit price of item stored in pence.
     int unitPrice;
 
+    // Observer notified of changes to the item (null if not observed)
+    StockItemObserver *observer;
+
+    // Position of the item in its observer's storage
+    uint32_t slot;
+
+    // Number of reservations of the item's stock still pending. Atomic, as
+    // orders are reserved and settled from many threads at once.
+    std::atomic<int> reservationCount;
+
     // StockItem Constructor
-    StockItem(const std::string &compType, const std::string &code, int amount,
+    StockItem(ComponentType compType, std::string_view code, int amount,
               int price);
 
+    // StockItem Copy Constructor
+    StockItem(const StockItem &item);
+
+    // StockItem Assignment Operator Overload
+    StockItem &operator=(const StockItem &item);
+
+    // Notifies the observer that a type specific attribute has changed
+    void notifyAttributeChanged();
+
 public:
+    // StockItem Destructor
+    virtual ~StockItem();
+
     // Retrieves the component type of a stock item - abstract method
-    std::string getComponentType();
+    std::string_view getComponentType() const;
+
+    // Retrieves the component type of a stock item as its enum value
+    ComponentType getType() const;
 
     // Retrieves stock code of item
-    std::string getStockCode() const;
+    std::string_view getStockCode() const;
+
+    // Retrieves the handle of the item's stock code in the global string
+    // pool
+    uint32_t getStockCodeId() const;
 
     // Retrieves stock amount of item
     int getStockAmount() const;
@@ -53,7 +139,7 @@ public:
     int getUnitPrice() const;
 
     // Sets the stock code of item
-    void setStockCode(const std::string &code);
+    void setStockCode(std::string_view code);
 
     // Sets the stock amount of item
     void setStockAmount(int amount);
@@ -61,6 +147,28 @@ public:
     // Sets the unit price of item
     void setUnitPrice(int price);
 
+    // Takes an amount of stock if that much is left, safely from many
+    // threads at once (the observer is not notified)
+    bool tryTakeStock(int quantity);
+
+    // Puts back an amount of stock taken, safely from many threads at once
+    // (the observer is not notified)
+    void returnStock(int quantity);
+
+    // Counts a reservation of the item's stock as pending/settled, safely
+    // from many threads at once
+    void holdReservation();
+    void settleReservation();
+
+    // Checks whether any reservation of the item's stock is still pending
+    bool hasPendingReservations() const;
+
+    // Attaches an observer to be notified of changes to the item
+    void attach(StockItemObserver *observer, uint32_t slot);
+
+    // Retrieves the position of the item in its observer's storage
+    uint32_t getSlot() const;
+
     // Provides details of this object for output stream
     // (helper method for output operator, must be overriden by sub classes)
     virtual std::ostream &print(std::ostream &os) const = 0;
@@ -79,17 +187,24 @@ private:
 
 public:
     // Resistor Constructor
-    Resistor(const std::string &code, int amount, int price,
+    Resistor(std::string_view code, int amount, int price,
              const std::string &resistanceCode);
 
+    // Resistor Constructor (resistance already decoded into ohms)
+    Resistor(std::string_view code, int amount, int price,
+             double resistance);
+
     // Retrieves the resistance of this resistor in ohms
     double getResistance() const;
 
     // Set resistance amount using code
     void setResistance(const std::string &resistanceCode);
 
+    // Sets the resistance already decoded into ohms
+    void setResistance(double resistance);
+
     // Converts a resistor's code value to resistance in ohms
-    static double calculateResistance(std::string resistanceCode);
+    static double calculateResistance(std::string_view resistanceCode);
 
     // Provides details of resistor in output stream
     std::ostream &print(std::ostream &os) const override;
@@ -105,17 +220,24 @@ private:
 
 public:
     // Capacitor constructor
-    Capacitor(const std::string &code, int amount, int price,
+    Capacitor(std::string_view code, int amount, int price,
               const std::string &capacitance);
 
+    // Capacitor constructor (capacitance already decoded into picofarads)
+    Capacitor(std::string_view code, int amount, int price,
+              double capacitance);
+
     // Retrieves capacitance of capacitor
-    int getCapacitance() const;
+    double getCapacitance() const;
 
     // Set capacitance amount of capacitor
     void setCapacitance(const std::string &capacitance);
 
+    // Sets the capacitance already decoded into picofarads
+    void setCapacitance(double capacitance);
+
     // Converts capacitance string into picofarads
-    static double convertToPicoFarads(const std::string capacitance);
+    static double convertToPicoFarads(std::string_view capacitance);
 
     // Provides details of capacitor as a string
     std::ostream &print(std::ostream &os) const override;
@@ -128,17 +250,23 @@ class Diode : public StockItem {
 private:
 public:
     // Diode constructor
-    Diode(const std::string &code, int amount, int price);
+    Diode(std::string_view code, int amount, int price);
 
     // Provides details of diode as a string
     std::ostream &print(std::ostream &os) const override;
 };
 
 // Device types for a transistor
-enum class DeviceType {
+enum class DeviceType : uint8_t {
     NPN, PNP, FET
 };
 
+// Retrieves the name of a device type
+std::string_view deviceTypeName(DeviceType deviceType);
+
+// Output operator for the name of a device type
+std::ostream &operator<<(std::ostream &os, const DeviceType &deviceType);
+
 /**
  * Models a transistor stock item
  */
@@ -149,15 +277,25 @@ private:
 
 public:
     // Transistor constructor
-    Transistor(const std::string &code, int amount, int price,
+    Transistor(std::string_view code, int amount, int price,
                const std::string &deviceType);
 
+    // Transistor constructor (device type already decoded)
+    Transistor(std::string_view code, int amount, int price,
+               DeviceType deviceType);
+
     // Retrieves the device type of this transistor
     DeviceType getDeviceType() const;
 
     // Sets the device type of a transistor
     void setDeviceType(const std::string &deviceType);
 
+    // Sets the device type of a transistor already decoded
+    void setDeviceType(DeviceType deviceType);
+
+    // Converts a device type name {NPN, PNP, FET} into its enum value
+    static DeviceType parseDeviceType(std::string_view deviceType);
+
     // Provides details of transistor as a string
     std::ostream &print(std::ostream &os) const override;
 };
@@ -167,19 +305,23 @@ public:
  */
 class IntegratedCircuit : public StockItem {
 private:
-    // Brief description of integrated circuit
-    std::string description;
+    // Brief description of integrated circuit, as its handle in the global
+    // string pool
+    uint32_t descriptionId;
 
 public:
     // IntegratedCircuit constructor
-    IntegratedCircuit(const std::string &code, int amount, int price,
-                      const std::string &description);
+    IntegratedCircuit(std::string_view code, int amount, int price,
+                      std::string_view description);
 
     // Retrieves the description of this integrated circuit
-    std::string getDescription() const;
+    std::string_view getDescription() const;
+
+    // Retrieves the handle of the description in the global string pool
+    uint32_t getDescriptionId() const;
 
     // Sets the description of an integrated circuit
-    void setDescription(const std::string &description);
+    void setDescription(std::string_view description);
 
     // Provides details of intergrated circuit as a string
     std::ostream &print(std::ostream &os) const override;
@@ -12,21 +12,22 @@
  ******************************************************************************/
 
 
+#include <chrono>
 #include <cstdlib>
-#include <fstream>
-#include <sstream>
+#include <memory>
+#include <stdexcept>
 
 #include "StockItem.h"
+#include "Aggregation.h"
 #include "Inventory.h"
+#include "InventoryReader.h"
+#include "InventorySnapshot.h"
+#include "QueryLanguage.h"
+#include "ReportWriter.h"
+#include "WriteAheadLog.h"
 
 using namespace std;
 
-// Reads and loads in an inventory file
-Inventory readInventoryFile(string &file);
-
-// Trims whitespace of a given string
-string &trim(string &str);
-
 // Answers their respective questions from the worksheet
 void answerQuestion1(Inventory &inv);
 void answerQuestion2(Inventory &inv);
@@ -34,12 +35,78 @@ void answerQuestion3(Inventory &inv);
 void answerQuestion4(Inventory &inv);
 void answerQuestion5(Inventory &inv);
 
+// Answers queries read from an input stream until it ends
+void answerQueries(Inventory &inv, istream &input);
+
+// Prints the in stock resistor/capacitor nearest a value
+void answerNearest(Inventory &inv, string_view request);
+
+// Prints the integrated circuits with the terms of a search in their
+// description
+void answerFind(Inventory &inv, string_view request);
+
+// Prints the items with the most stock whose codes complete a partial code
+void answerCodes(Inventory &inv, string_view partialCode);
+
 
 
 int main(int argc, char **argv) {
-    // Loads up inventory
+    // Inventory to load, either an inventory file or a snapshot of one
     string inventoryFileName = "inventory.txt";
-    Inventory charltinsInventory = readInventoryFile(inventoryFileName);
+    string snapshotFileName;
+    string logFileName;
+    bool interactive = false;
+
+    // Reads in command line arguments
+    for (int i = 1; i < argc; i++) {
+        string argument = argv[i];
+
+        if (argument == "--save-snapshot" && i + 1 < argc) {
+            snapshotFileName = argv[++i];
+        } else if (argument == "--log" && i + 1 < argc) {
+            logFileName = argv[++i];
+        } else if (argument == "--repl") {
+            interactive = true;
+        } else {
+            inventoryFileName = argument;
+        }
+    }
+
+    // Loads up inventory
+    Inventory charltinsInventory =
+            isInventorySnapshot(inventoryFileName)
+            ? readInventorySnapshot(inventoryFileName)
+            : readParallelInventoryFile(inventoryFileName);
+
+    // Replays the changes logged since the inventory was saved, then logs
+    // every change made from now on
+    unique_ptr<WriteAheadLog> changeLog;
+
+    if (!logFileName.empty()) {
+        changeLog.reset(new WriteAheadLog(logFileName));
+        changeLog->replay(charltinsInventory);
+        charltinsInventory.watch(changeLog.get());
+    }
+
+    // Saves a snapshot of the inventory for faster loading next time, which
+    // holds every logged change so far
+    if (!snapshotFileName.empty()) {
+        if (changeLog) {
+            if (!changeLog->checkpoint(charltinsInventory,
+                                       snapshotFileName)) {
+                cerr << "Unable to checkpoint write-ahead log " << logFileName
+                     << " into snapshot " << snapshotFileName << endl;
+            }
+        } else {
+            writeInventorySnapshot(charltinsInventory, snapshotFileName);
+        }
+    }
+
+    // Keeps the inventory loaded, answering queries instead of questions
+    if (interactive) {
+        answerQueries(charltinsInventory, cin);
+        return EXIT_SUCCESS;
+    }
 
     answerQuestion1(charltinsInventory);
 
@@ -60,8 +127,16 @@ int main(int argc, char **argv) {
  * @param inv           inventory to answer questions with
  */
 void answerQuestion1(Inventory &inv) {
-    inv.sortByPrice(true);
-    cout << "Question 1:" << endl << inv;
+    ReportWriter report(cout);
+
+    report.write("Question 1:\nInventory Size: ").writeInteger(inv.getSize())
+            .write("\n\n");
+
+    // Prints each item in price order, without sorting the inventory
+    inv.getPriceIndex().forEachAscending([&inv, &report](uint32_t slot) {
+        report.writeItem(*inv.getItemInSlot(slot)).write('\n');
+        return true;
+    });
 }
 
 /**
@@ -70,24 +145,18 @@ void answerQuestion1(Inventory &inv) {
  * @param inv           inventory to answer questions with
  */
 void answerQuestion2(Inventory &inv) {
-    // Stores details on component with highest stock amount
-    StockItem *maxStockItem;
-    int maxStockAmount = 0;
-
-    // For each item retrieves its stock amount comparing with maximum
-    for (int i = 0; i < inv.getSize(); i++) {
-        StockItem *item = inv[i];
+    const StockColumns &columns = inv.getColumns();
 
-        int stockAmount = item->getStockAmount();
-
-        // Checks if this item beats the maximum stock amount,
-        // replacing it if true
-        if (maxStockAmount < stockAmount) {
-            maxStockItem = item;
-            maxStockAmount = stockAmount;
-        }
+    // Finds the highest stock amount, then the first item with it
+    int minStockAmount, maxStockAmount;
+    if (!findStockAmountRange(columns, minStockAmount, maxStockAmount) ||
+        maxStockAmount <= 0) {
+        return;
     }
 
+    StockItem *maxStockItem =
+            columns.getItems()[findStockAmount(columns, maxStockAmount)];
+
     cout << "Question 2: " << endl
          << "The component with the largest number of components in stock is: "
          << endl << *maxStockItem << endl;
@@ -99,22 +168,14 @@ void answerQuestion2(Inventory &inv) {
  * @param inv           inventory to answer questions with
  */
 void answerQuestion3(Inventory &inv) {
-    string componentType = "Transistor";
-    DeviceType deviceType = DeviceType::NPN;
-    int totalStock = 0;
-
-    // Gets all transistors in inventory
-    vector<StockItem *> transistorInventory = inv.search(componentType);
+    ColumnFilter npnTransistors;
+    npnTransistors.matchComponentType = true;
+    npnTransistors.componentType = ComponentType::Transistor;
+    npnTransistors.matchDeviceType = true;
+    npnTransistors.deviceType = DeviceType::NPN;
 
-    // For each transistor check if it is an NPN and increment the total stock
-    for (StockItem *item : transistorInventory) {
-        // Casts item to transistor to be able to access transistor methods
-        Transistor *transistor = dynamic_cast<Transistor *>(item);
-
-        if (transistor->getDeviceType() == deviceType) {
-            totalStock += transistor->getStockAmount();
-        }
-    }
+    // Totals the stock of every NPN transistor
+    long long totalStock = sumStockAmounts(inv.getColumns(), npnTransistors);
 
     cout << "Question 3: " << endl << "There are " << totalStock
          << " NPN transistors in stock" << "." << endl << endl;
@@ -126,22 +187,13 @@ void answerQuestion3(Inventory &inv) {
  * @param inv           inventory to answer questions with
  */
 void answerQuestion4(Inventory &inv) {
-    string componentType = "Resistor";
-    double totalResistance = 0;
-
-    // Gets all resistors in inventory
-    vector<StockItem *> resistorInventory = inv.search(componentType);
+    ColumnFilter resistorsInStock;
+    resistorsInStock.matchComponentType = true;
+    resistorsInStock.componentType = ComponentType::Resistor;
+    resistorsInStock.inStockOnly = true;
 
-    // For each resistor check if it is in stock and increment total resistance
-    for (StockItem *item : resistorInventory) {
-        // Casts item to resistor to be able to access resistor methods
-        Resistor *resistor = dynamic_cast<Resistor *>(item);
-
-        // Increases total resistance if in stock
-        if (resistor->getStockAmount() > 0) {
-            totalResistance += resistor->getResistance();
-        }
-    }
+    // Totals the resistance of every resistor in stock
+    double totalResistance = sumValues(inv.getColumns(), resistorsInStock);
 
     cout << "Question 4: " << endl
          << "The total resistance of all resistors in stock is "
@@ -156,22 +208,9 @@ void answerQuestion4(Inventory &inv) {
  */
 void answerQuestion5(Inventory &inv) {
     int priceLimit = 10;
-    int stockItemsAboveLimit = 0;
-
-    inv.sortByPrice(false);
 
-    // Loops through inventory, incrementing count if item price is above 10
-    for (int i = 0; i < inv.getSize(); i++) {
-        StockItem *item = inv[i];
-
-        // Checks if item price is above 10, breaks early due to inventory
-        // being sorted meaning no need to carry on searching
-        if (item->getUnitPrice() > priceLimit) {
-            stockItemsAboveLimit++;
-        } else {
-            break;
-        }
-    }
+    // Counts the items above the price limit using the price index
+    int stockItemsAboveLimit = inv.getPriceIndex().countAbove(priceLimit);
 
     cout << "Question 5: " << endl << "Amount of stock items above "
          << priceLimit << "p is " << stockItemsAboveLimit << "." << endl
@@ -179,109 +218,169 @@ void answerQuestion5(Inventory &inv) {
 }
 
 /**
- * Reads and loads in an inventory file
+ * Answers queries written in the query language, one a line, until the input
+ * ends or a line reads quit. Each query is compiled and planned once, and
+ * its answer is followed by how long it took. A query preceded by explain
+ * prints its plan instead of running it, a line such as
+ * 'nearest resistor 10K' finds the nearest substitute in stock, and one such
+ * as 'codes RES_1' completes a partial stock code.
  *
- * @param file              inventory file to read in
- * @return                  inventory object filled with data from file
+ * @param inv           inventory to answer queries with
+ * @param input         stream to read queries from
  */
-Inventory readInventoryFile(string &file) {
-    Inventory inv;
+void answerQueries(Inventory &inv, istream &input) {
+    typedef chrono::steady_clock Clock;
 
-    ifstream fileStream(file);
+    QueryCache queryCache;
+    string line;
 
-    if (fileStream) {
-        string line;
-        const char DELIMITER = ',';
+    cout << "Loaded " << inv.getSize() << " items. Enter queries such as "
+         << "'count transistor where device=NPN', or quit." << endl;
 
-        // For each line in the file, creates a stock item
-        while (getline(fileStream, line)) {
-            // Allows line to be manipulated as a stream so as to store each
-            // word on the line
-            stringstream stringStream(line);
-            string word;
+    while (cout << "> " << flush && getline(input, line)) {
+        string_view text = trim(string_view(line));
+        bool explain = text.substr(0, 8) == "explain ";
 
-            // Stores the details of a stock item from a line
-            vector<string> stockItemDetails;
+        if (text.empty()) {
+            continue;
+        } else if (text == "quit" || text == "exit") {
+            break;
+        } else if (explain) {
+            text.remove_prefix(8);
+        }
 
-            // For each word on a line trim whitespace and add to list
-            while (getline(stringStream, word, DELIMITER)) {
-                trim(word);
-                stockItemDetails.push_back(word);
+        try {
+            if (text.substr(0, 8) == "nearest ") {
+                answerNearest(inv, text.substr(8));
+                continue;
+            } else if (text.substr(0, 5) == "find ") {
+                answerFind(inv, text.substr(5));
+                continue;
+            } else if (text.substr(0, 6) == "codes ") {
+                answerCodes(inv, trim(text.substr(6)));
+                continue;
             }
 
-            try {
-                StockItem *newItem;
-
-                // Creates a new stock item of the correct type
-                if (stockItemDetails.at(0) == "resistor") {
-                    newItem = new Resistor(stockItemDetails.at(1),
-                                           stoi(stockItemDetails.at(2)),
-                                           stoi(stockItemDetails.at(3)),
-                                           stockItemDetails.at(4));
-                } else if (stockItemDetails.at(0) == "capacitor") {
-                    newItem = new Capacitor(stockItemDetails.at(1),
-                                            stoi(stockItemDetails.at(2)),
-                                            stoi(stockItemDetails.at(3)),
-                                            stockItemDetails.at(4));
-                } else if (stockItemDetails.at(0) == "transistor") {
-                    newItem = new Transistor(stockItemDetails.at(1),
-                                             stoi(stockItemDetails.at(2)),
-                                             stoi(stockItemDetails.at(3)),
-                                             stockItemDetails.at(4));
-                } else if (stockItemDetails.at(0) == "diode") {
-                    newItem = new Diode(stockItemDetails.at(1),
-                                        stoi(stockItemDetails.at(2)),
-                                        stoi(stockItemDetails.at(3)));
-                } else if (stockItemDetails.at(0) == "IC") {
-                    newItem = new IntegratedCircuit(stockItemDetails.at(1),
-                                                    stoi(stockItemDetails.at(
-                                                            2)),
-                                                    stoi(stockItemDetails.at(
-                                                            3)),
-                                                    stockItemDetails.at(4));
-                } else {
-                    throw invalid_argument(
-                            "Invalid component " + stockItemDetails.at(0) +
-                            " could not be added");
-                }
-
-                // Adds the newly created item to inventory
-                inv.add(newItem);
-
-            } catch (exception e) {
-                cerr << "Failed to add item to inventory." << endl;
-            }
+            Clock::time_point start = Clock::now();
+            bool cached;
+            const CompiledQuery &compiled = queryCache.compile(text, inv,
+                                                               cached);
 
+            if (explain) {
+                cout << compiled.plan.describe()
+                     << (cached ? " [cached]" : "") << endl;
+                continue;
+            }
 
+            QueryResult result = compiled.query.run(inv, compiled.plan);
+            double milliseconds = chrono::duration<double, milli>(
+                    Clock::now() - start).count();
+
+            compiled.query.print(cout, inv, result);
+            cout << "(" << result.slots.size() << " items, " << fixed
+                 << setprecision(3) << milliseconds << " ms, "
+                 << compiled.plan.describe()
+                 << (cached ? ", cached plan" : "") << ")" << endl;
+        } catch (const logic_error &error) {
+            // Covers values out of range as well as malformed queries, so
+            // one bad line never ends the session
+            cerr << "Invalid query: " << error.what() << endl;
         }
-    } else {
-        cerr << "Unable to open file " << file << endl;
     }
+}
 
-    fileStream.close();
+/**
+ * Prints the resistor or capacitor in stock with the value nearest the one
+ * requested, such as 'resistor 9K5' or 'capacitor 100nF'
+ *
+ * @param inv           inventory to search
+ * @param request       component type and value (as a part code) wanted
+ */
+void answerNearest(Inventory &inv, string_view request) {
+    size_t space = request.find(' ');
+    string_view typeName = request.substr(0, space);
+    string_view value = space == string_view::npos
+                        ? string_view() : trim(request.substr(space + 1));
+
+    StockItem *nearest;
+
+    if (typeName == "resistor") {
+        nearest = inv.findNearestValue(ComponentType::Resistor,
+                                       Resistor::calculateResistance(value));
+    } else if (typeName == "capacitor") {
+        nearest = inv.findNearestValue(ComponentType::Capacitor,
+                                       Capacitor::convertToPicoFarads(value));
+    } else {
+        throw invalid_argument("Expected resistor or capacitor.");
+    }
 
-    return inv;
+    if (nearest == nullptr) {
+        cout << "None in stock." << endl;
+    } else {
+        cout << *nearest << endl;
+    }
 }
 
 /**
- * Trims whitespace of a given string
+ * Prints the integrated circuits whose descriptions have every term of a
+ * search, such as 'find 4-bit count*', or any of them, such as
+ * 'find any timer counter'
  *
- * Please note that this has been modified from a version of another trim
- * function found here:
- * http://www.martinbroadhurst.com/how-to-trim-a-stdstring.html
- *
- * @param str               string to trim whitespace of
- * @return                  trimmed string
+ * @param inv           inventory to search
+ * @param request       terms to search for, optionally preceded by any
  */
-string &trim(string &str) {
-    const string whiteSpace = "\t\n\v\f\r ";
+void answerFind(Inventory &inv, string_view request) {
+    typedef chrono::steady_clock Clock;
+
+    TermMatch match = TermMatch::All;
 
-    // Removes whitespace from end of string
-    str.erase(str.find_last_not_of(whiteSpace) + 1);
+    if (request.substr(0, 4) == "any ") {
+        match = TermMatch::Any;
+        request.remove_prefix(4);
+    }
 
-    // Removes whitespace from front of string
-    str.erase(0, str.find_first_not_of(whiteSpace));
+    Clock::time_point start = Clock::now();
+    vector<StockItem *> results = inv.searchDescriptions(request, match);
+    double milliseconds = chrono::duration<double, milli>(
+            Clock::now() - start).count();
+
+    for (StockItem *item : results) {
+        cout << *item << endl;
+    }
 
-    return str;
+    cout << "(" << results.size() << " items, " << fixed << setprecision(3)
+         << milliseconds << " ms, description index)" << endl;
 }
 
+/**
+ * Prints the ten items with the most stock whose codes start with a partial
+ * code, such as 'codes RES_1'. When no code starts with it, the codes
+ * starting with text one typing mistake away from it are printed instead.
+ *
+ * @param inv           inventory to search
+ * @param partialCode   start of the stock codes wanted
+ */
+void answerCodes(Inventory &inv, string_view partialCode) {
+    typedef chrono::steady_clock Clock;
+
+    const size_t limit = 10;
+
+    Clock::time_point start = Clock::now();
+    vector<StockItem *> results = inv.searchCodePrefix(partialCode, limit);
+    bool fuzzy = results.empty();
+
+    if (fuzzy) {
+        results = inv.searchCodeFuzzy(partialCode, 1, true, limit);
+    }
+
+    double microseconds = chrono::duration<double, micro>(
+            Clock::now() - start).count();
+
+    for (StockItem *item : results) {
+        cout << *item << endl;
+    }
+
+    cout << "(" << results.size() << " items, " << fixed << setprecision(1)
+         << microseconds << " us, "
+         << (fuzzy ? "fuzzy " : "") << "code trie)" << endl;
+}
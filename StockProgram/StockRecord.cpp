@@ -0,0 +1,280 @@
+/******************************************************************************
+ *
+ * File        : StockRecord.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define stock records, which hold every component
+ *               type by value, and a table of them.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <iomanip>
+#include "StockRecord.h"
+
+using namespace std;
+
+/**
+ * Constructs a new stock record with the given details
+ *
+ * @param codeId                    id of the item's stock code in its table
+ * @param amount                    stock amount
+ * @param price                     unit price of item
+ * @param attributes                attributes of the item's component type
+ */
+StockRecord::StockRecord(uint32_t codeId, int amount, int price,
+                         ComponentAttributes attributes)
+        : codeId(codeId), stockAmount(amount), unitPrice(price),
+          attributes(attributes) {
+}
+
+/**
+ * Constructs a new, empty table of stock records
+ */
+StockRecordTable::StockRecordTable() {
+}
+
+/**
+ * Constructs a new table holding a copy of each of a list of stock items
+ *
+ * @param items                     items to copy, in order
+ */
+StockRecordTable::StockRecordTable(const vector<StockItem *> &items) {
+    this->records.reserve(items.size());
+
+    for (const StockItem *item : items) {
+        this->add(*item);
+    }
+}
+
+/**
+ * Adds text to the table
+ *
+ * @param text                      text to add
+ * @return                          id of the text
+ */
+uint32_t StockRecordTable::addText(string_view text) {
+    this->texts.emplace_back(text);
+
+    return this->texts.size() - 1;
+}
+
+/**
+ * Adds a copy of a stock item to the end of the table, as a record holding
+ * the attributes of its component type
+ *
+ * @param item                      item to copy
+ */
+void StockRecordTable::add(const StockItem &item) {
+    ComponentAttributes attributes;
+
+    switch (item.getType()) {
+        case ComponentType::Resistor:
+            attributes = ResistorAttributes{
+                    static_cast<const Resistor &>(item).getResistance()};
+            break;
+        case ComponentType::Capacitor:
+            attributes = CapacitorAttributes{
+                    static_cast<const Capacitor &>(item).getCapacitance()};
+            break;
+        case ComponentType::Diode:
+            attributes = DiodeAttributes{};
+            break;
+        case ComponentType::Transistor:
+            attributes = TransistorAttributes{
+                    static_cast<const Transistor &>(item).getDeviceType()};
+            break;
+        case ComponentType::IntegratedCircuit:
+            attributes = IntegratedCircuitAttributes{this->addText(
+                    static_cast<const IntegratedCircuit &>(item)
+                            .getDescription())};
+            break;
+    }
+
+    this->records.emplace_back(this->addText(item.getStockCode()),
+                               item.getStockAmount(), item.getUnitPrice(),
+                               attributes);
+}
+
+/**
+ * Reserves space for an amount of records, so adding that many does not
+ * move the records already in the table
+ *
+ * @param recordCount               amount of records to make room for
+ */
+void StockRecordTable::reserve(size_t recordCount) {
+    this->records.reserve(recordCount);
+}
+
+/**
+ * Retrieves the amount of records in the table
+ *
+ * @return                          amount of records
+ */
+size_t StockRecordTable::getSize() const {
+    return this->records.size();
+}
+
+/**
+ * Retrieves the record at a position of the table
+ *
+ * @param i                         position of the record
+ * @return                          record at the position
+ */
+const StockRecord &StockRecordTable::operator[](size_t i) const {
+    return this->records[i];
+}
+
+/**
+ * Retrieves an iterator to the first record
+ *
+ * @return                          iterator to the first record
+ */
+vector<StockRecord>::const_iterator StockRecordTable::begin() const {
+    return this->records.begin();
+}
+
+/**
+ * Retrieves an iterator past the last record
+ *
+ * @return                          iterator past the last record
+ */
+vector<StockRecord>::const_iterator StockRecordTable::end() const {
+    return this->records.end();
+}
+
+/**
+ * Retrieves the stock code of a record of the table
+ *
+ * @param record                    record of the table
+ * @return                          stock code of the record
+ */
+const string &StockRecordTable::getStockCode(const StockRecord &record) const {
+    return this->texts[record.getCodeId()];
+}
+
+/**
+ * Retrieves the description of a record of an integrated circuit
+ *
+ * @param record                    record of the table
+ * @return                          description, empty for records of other
+ *                                  component types
+ */
+const string &StockRecordTable::getDescription(
+        const StockRecord &record) const {
+    static const string NO_DESCRIPTION;
+
+    const IntegratedCircuitAttributes *integratedCircuit =
+            get_if<IntegratedCircuitAttributes>(&record.getAttributes());
+
+    return integratedCircuit == nullptr
+           ? NO_DESCRIPTION : this->texts[integratedCircuit->descriptionId];
+}
+
+/**
+ * Provides details of a record for an output stream, in the same format as
+ * the stock item class of its component type
+ *
+ * @param os                        the output stream to send info to
+ * @param record                    record of the table
+ * @return                          outstream with details of the record
+ */
+ostream &StockRecordTable::print(ostream &os,
+                                 const StockRecord &record) const {
+    os << "Component Type: " << componentTypeName(record.getType()) << endl
+       << "Stock Code: " << this->getStockCode(record) << endl
+       << "Stock Amount: " << record.getStockAmount() << endl
+       << "Unit Price: " << record.getUnitPrice() << "p" << endl;
+
+    switch (record.getType()) {
+        case ComponentType::Resistor:
+            return os << "Total Resistance: " << fixed << setprecision(2)
+                      << record.getValue() << "ohms" << endl;
+        case ComponentType::Capacitor:
+            return os << "Total Capacitance: " << fixed << setprecision(0)
+                      << record.getValue() << "pf" << endl;
+        case ComponentType::Transistor:
+            return os << "Device Type: " << record.getDeviceType() << endl;
+        case ComponentType::IntegratedCircuit:
+            return os << "Description: " << this->getDescription(record)
+                      << endl;
+        default:
+            return os;
+    }
+}
+
+/**
+ * Counts the records that pass a filter
+ *
+ * @param filter                    filter records must pass
+ * @return                          amount of records
+ */
+size_t StockRecordTable::countItems(const ColumnFilter &filter) const {
+    size_t count = 0;
+
+    for (const StockRecord &record : this->records) {
+        count += record.passes(filter);
+    }
+
+    return count;
+}
+
+/**
+ * Totals the stock amounts of the records that pass a filter
+ *
+ * @param filter                    filter records must pass
+ * @return                          total stock amount
+ */
+long long StockRecordTable::sumStockAmounts(const ColumnFilter &filter) const {
+    long long total = 0;
+
+    for (const StockRecord &record : this->records) {
+        if (record.passes(filter)) {
+            total += record.getStockAmount();
+        }
+    }
+
+    return total;
+}
+
+/**
+ * Totals the resistances of the resistors and capacitances of the
+ * capacitors that pass a filter, in table order so the total is exactly
+ * that of the inventory's columns
+ *
+ * @param filter                    filter records must pass
+ * @return                          total value
+ */
+double StockRecordTable::sumValues(const ColumnFilter &filter) const {
+    double total = 0;
+
+    for (const StockRecord &record : this->records) {
+        if (record.passes(filter)) {
+            total += record.getValue();
+        }
+    }
+
+    return total;
+}
+
+/**
+ * Totals the stock value (stock amount x unit price) of the records that
+ * pass a filter
+ *
+ * @param filter                    filter records must pass
+ * @return                          total stock value in pence
+ */
+long long StockRecordTable::sumStockValues(const ColumnFilter &filter) const {
+    long long total = 0;
+
+    for (const StockRecord &record : this->records) {
+        if (record.passes(filter)) {
+            total += static_cast<long long>(record.getStockAmount()) *
+                     record.getUnitPrice();
+        }
+    }
+
+    return total;
+}
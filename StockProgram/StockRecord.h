@@ -0,0 +1,238 @@
+/******************************************************************************
+ *
+ * File        : StockRecord.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define stock records, a closed alternative
+ *               to the stock item class hierarchy holding every component
+ *               type by value, and a table of them.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef STOCKRECORD_H
+#define STOCKRECORD_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+#include "Aggregation.h"
+#include "StockItem.h"
+
+// Attributes only resistors have
+struct ResistorAttributes {
+    // Resistance in ohms
+    double resistance;
+};
+
+// Attributes only capacitors have
+struct CapacitorAttributes {
+    // Capacitance in picofarads
+    double capacitance;
+};
+
+// Attributes only diodes have (none)
+struct DiodeAttributes {
+};
+
+// Attributes only transistors have
+struct TransistorAttributes {
+    // Device type {NPN, PNP, FET}
+    DeviceType deviceType;
+};
+
+// Attributes only integrated circuits have
+struct IntegratedCircuitAttributes {
+    // Brief description of the integrated circuit, as the id of its text
+    // in the record's table
+    uint32_t descriptionId;
+};
+
+// Attributes of any one component type, the alternatives being in the order
+// of the ComponentType values so that the index of the alternative held is
+// the component type
+typedef std::variant<ResistorAttributes, CapacitorAttributes,
+                     DiodeAttributes, TransistorAttributes,
+                     IntegratedCircuitAttributes> ComponentAttributes;
+
+/**
+ * A stock item held by value: the attributes every item has, and those of
+ * its component type in a variant. The set of component types is closed,
+ * so code handling each type is a switch on the component type (which the
+ * compiler can inline) rather than a virtual call or a dynamic_cast.
+ * Text is kept by the record's table, leaving records small and trivially
+ * copyable so that a scan reads as few bytes as it can.
+ */
+class StockRecord {
+private:
+    // Unique stock code of the item, as the id of its text in the table
+    uint32_t codeId;
+
+    // Number of items left in stock
+    int stockAmount;
+
+    // Unit price of the item in pence
+    int unitPrice;
+
+    // Attributes of the item's component type
+    ComponentAttributes attributes;
+
+public:
+    // StockRecord Constructor
+    StockRecord(uint32_t codeId, int amount, int price,
+                ComponentAttributes attributes);
+
+    // Retrieves the component type of the item
+    ComponentType getType() const {
+        return static_cast<ComponentType>(this->attributes.index());
+    }
+
+    // Retrieves the id of the item's stock code in its table
+    uint32_t getCodeId() const {
+        return this->codeId;
+    }
+
+    // Retrieves the stock amount of the item
+    int getStockAmount() const {
+        return this->stockAmount;
+    }
+
+    // Retrieves the unit price of the item
+    int getUnitPrice() const {
+        return this->unitPrice;
+    }
+
+    // Retrieves the attributes of the item's component type
+    const ComponentAttributes &getAttributes() const {
+        return this->attributes;
+    }
+
+    // Retrieves the resistance of a resistor or capacitance of a capacitor
+    // (0 for other items)
+    double getValue() const;
+
+    // Retrieves the device type of a transistor (NPN for other items)
+    DeviceType getDeviceType() const;
+
+    // Checks whether the item passes a filter
+    bool passes(const ColumnFilter &filter) const;
+};
+
+/**
+ * Retrieves the resistance of a resistor or capacitance of a capacitor
+ *
+ * @return                          value of the item, 0 for other items
+ */
+inline double StockRecord::getValue() const {
+    switch (this->getType()) {
+        case ComponentType::Resistor:
+            return std::get<ResistorAttributes>(this->attributes).resistance;
+        case ComponentType::Capacitor:
+            return std::get<CapacitorAttributes>(this->attributes)
+                    .capacitance;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Retrieves the device type of a transistor
+ *
+ * @return                          device type, NPN for other items
+ */
+inline DeviceType StockRecord::getDeviceType() const {
+    const TransistorAttributes *transistor =
+            std::get_if<TransistorAttributes>(&this->attributes);
+
+    return transistor == nullptr ? DeviceType::NPN : transistor->deviceType;
+}
+
+/**
+ * Checks whether the item passes a filter, as the same item would in the
+ * columns of an inventory
+ *
+ * @param filter                    filter to check
+ * @return                          true if the item passes
+ */
+inline bool StockRecord::passes(const ColumnFilter &filter) const {
+    return (!filter.matchComponentType ||
+            this->getType() == filter.componentType) &&
+           (!filter.matchDeviceType ||
+            (this->getType() == ComponentType::Transistor &&
+             this->getDeviceType() == filter.deviceType)) &&
+           (!filter.inStockOnly || this->stockAmount > 0);
+}
+
+/**
+ * Stock records stored by value one after another, in place of an array of
+ * pointers to stock items allocated separately. Scans read the records in
+ * order rather than following a pointer and a virtual table for each item.
+ * The table also holds the text of the records' stock codes and
+ * descriptions.
+ */
+class StockRecordTable {
+private:
+    // Records, in the order they were added
+    std::vector<StockRecord> records;
+
+    // Stock codes and descriptions of the records, by id
+    std::vector<std::string> texts;
+
+    // Adds text to the table, returning its id
+    uint32_t addText(std::string_view text);
+
+public:
+    // StockRecordTable Constructor
+    StockRecordTable();
+
+    // StockRecordTable Constructor (copying stock items, in order)
+    explicit StockRecordTable(const std::vector<StockItem *> &items);
+
+    // Adds a copy of a stock item to the end of the table
+    void add(const StockItem &item);
+
+    // Reserves space for an amount of records
+    void reserve(size_t recordCount);
+
+    // Retrieves the amount of records in the table
+    size_t getSize() const;
+
+    // Retrieves the record at a position
+    const StockRecord &operator[](size_t i) const;
+
+    // Iterators over the records
+    std::vector<StockRecord>::const_iterator begin() const;
+    std::vector<StockRecord>::const_iterator end() const;
+
+    // Retrieves the stock code of a record
+    const std::string &getStockCode(const StockRecord &record) const;
+
+    // Retrieves the description of an integrated circuit's record (empty
+    // for other records)
+    const std::string &getDescription(const StockRecord &record) const;
+
+    // Provides details of a record for an output stream, as the stock item
+    // it was copied from does
+    std::ostream &print(std::ostream &os, const StockRecord &record) const;
+
+    // Counts the records that pass a filter
+    size_t countItems(const ColumnFilter &filter) const;
+
+    // Totals the stock amounts of the records that pass a filter
+    long long sumStockAmounts(const ColumnFilter &filter) const;
+
+    // Totals the resistances/capacitances of the records that pass a filter
+    double sumValues(const ColumnFilter &filter) const;
+
+    // Totals the stock value (stock amount x unit price) in pence of the
+    // records that pass a filter
+    long long sumStockValues(const ColumnFilter &filter) const;
+};
+
+#endif /* STOCKRECORD_H */
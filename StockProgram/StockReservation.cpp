@@ -0,0 +1,104 @@
+/******************************************************************************
+ *
+ * File        : StockReservation.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a reservation of stock taken from an item
+ *               for an order, until the order is committed or released.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include "StockReservation.h"
+
+using namespace std;
+
+/**
+ * Constructs a reservation holding no stock
+ */
+StockReservation::StockReservation() : item(nullptr), quantity(0) {
+}
+
+/**
+ * Constructs a reservation of stock already taken from an item
+ *
+ * @param item                      item the stock was taken from
+ * @param quantity                  amount of stock taken
+ */
+StockReservation::StockReservation(StockItem *item, int quantity)
+        : item(item), quantity(quantity) {
+    this->item->holdReservation();
+}
+
+/**
+ * Destroys the reservation, putting its stock back if it is still pending
+ */
+StockReservation::~StockReservation() {
+    if (this->item != nullptr) {
+        this->item->returnStock(this->quantity);
+        this->item->settleReservation();
+    }
+}
+
+/**
+ * Moves a reservation, leaving the moved from reservation holding nothing
+ *
+ * @param reservation               reservation to move
+ */
+StockReservation::StockReservation(StockReservation &&reservation) noexcept
+        : item(reservation.item), quantity(reservation.quantity) {
+    reservation.item = nullptr;
+}
+
+/**
+ * Moves a reservation into this one, first releasing any stock this one
+ * holds
+ *
+ * @param reservation               reservation to move
+ * @return                          this reservation
+ */
+StockReservation &StockReservation::operator=(
+        StockReservation &&reservation) noexcept {
+    if (this != &reservation) {
+        if (this->item != nullptr) {
+            this->item->returnStock(this->quantity);
+            this->item->settleReservation();
+        }
+
+        this->item = reservation.item;
+        this->quantity = reservation.quantity;
+        reservation.item = nullptr;
+    }
+
+    return *this;
+}
+
+/**
+ * Checks whether the reservation still holds stock, having been neither
+ * committed nor released
+ *
+ * @return                          true if the reservation holds stock
+ */
+bool StockReservation::isPending() const {
+    return this->item != nullptr;
+}
+
+/**
+ * Retrieves the item the stock was taken from
+ *
+ * @return                          item, null if not pending
+ */
+StockItem *StockReservation::getItem() const {
+    return this->item;
+}
+
+/**
+ * Retrieves the amount of stock taken
+ *
+ * @return                          amount of stock
+ */
+int StockReservation::getQuantity() const {
+    return this->quantity;
+}
@@ -0,0 +1,61 @@
+/******************************************************************************
+ *
+ * File        : StockReservation.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a reservation of stock taken from an
+ *               item for an order, until the order is committed or released.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef STOCKRESERVATION_H
+#define STOCKRESERVATION_H
+
+#include "StockItem.h"
+
+/**
+ * Stock taken from an item for an order. The stock leaves the item as soon
+ * as it is reserved, so no other order can reserve it, and is either kept
+ * when the reservation is committed or put back when it is released. A
+ * reservation destroyed while still pending is released.
+ */
+class StockReservation {
+private:
+    // Item the stock was taken from (null once committed or released)
+    StockItem *item;
+
+    // Amount of stock taken
+    int quantity;
+
+    // StockReservation Constructor (for stock already taken)
+    StockReservation(StockItem *item, int quantity);
+
+    friend class Inventory;
+
+public:
+    // StockReservation Constructor (holding no stock)
+    StockReservation();
+
+    // StockReservation Destructor (releases pending stock)
+    ~StockReservation();
+
+    // Reservations can be moved, but not copied
+    StockReservation(StockReservation &&reservation) noexcept;
+    StockReservation &operator=(StockReservation &&reservation) noexcept;
+    StockReservation(const StockReservation &reservation) = delete;
+    StockReservation &operator=(const StockReservation &reservation) = delete;
+
+    // Checks whether the reservation still holds stock
+    bool isPending() const;
+
+    // Retrieves the item the stock was taken from (null if not pending)
+    StockItem *getItem() const;
+
+    // Retrieves the amount of stock taken
+    int getQuantity() const;
+};
+
+#endif /* STOCKRESERVATION_H */
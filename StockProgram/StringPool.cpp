@@ -0,0 +1,254 @@
+/******************************************************************************
+ *
+ * File        : StringPool.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define a pool of interned strings, each stored
+ *               once and referred to by a 32 bit handle.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include "StringPool.h"
+
+using namespace std;
+
+// Marks an empty entry of a shard's table
+static const uint32_t NO_HANDLE = UINT32_MAX;
+
+// Capacity of a shard's table when its first string is added
+static const size_t INITIAL_CAPACITY = 16;
+
+/**
+ * Constructs an empty pool
+ */
+StringPool::StringPool() : nextHandle(0) {
+    for (atomic<string_view *> &segment : this->segments) {
+        segment.store(nullptr, memory_order_relaxed);
+    }
+}
+
+/**
+ * Destroys the pool, freeing each segment of handles (the shards free their
+ * own blocks)
+ */
+StringPool::~StringPool() {
+    for (atomic<string_view *> &segment : this->segments) {
+        delete[] segment.load(memory_order_relaxed);
+    }
+}
+
+/**
+ * Retrieves the pool shared by every stock item, which lives until the
+ * program exits
+ *
+ * @return                          the global pool
+ */
+StringPool &StringPool::global() {
+    static StringPool pool;
+
+    return pool;
+}
+
+/**
+ * Interns a string, so that it is stored once however many times it is
+ * interned. Safe to call from several threads at once.
+ *
+ * @param text                      string to intern
+ * @return                          handle of the string
+ * @throws length_error             if the string is new and every handle
+ *                                  has been given out
+ */
+uint32_t StringPool::intern(string_view text) {
+    uint32_t hash = StringPool::hashString(text);
+    Shard &shard = this->shards[hash >> 28];
+    lock_guard<mutex> lock(shard.mutex);
+
+    // Keeps the table at most 3/4 full so probe sequences stay short
+    if ((shard.size + 1) * 4 > shard.entries.size() * 3) {
+        size_t capacity = max(INITIAL_CAPACITY, shard.entries.size() * 2);
+        vector<Entry> oldEntries(capacity, Entry{0, NO_HANDLE});
+        oldEntries.swap(shard.entries);
+
+        for (const Entry &entry : oldEntries) {
+            if (entry.handle != NO_HANDLE) {
+                size_t position = entry.hash & (capacity - 1);
+
+                while (shard.entries[position].handle != NO_HANDLE) {
+                    position = (position + 1) & (capacity - 1);
+                }
+
+                shard.entries[position] = entry;
+            }
+        }
+    }
+
+    Entry &entry = shard.entries[this->probe(shard, text, hash)];
+
+    if (entry.handle == NO_HANDLE) {
+        entry = {hash, this->newHandle(this->store(shard, text))};
+        shard.size++;
+    }
+
+    return entry.handle;
+}
+
+/**
+ * Finds the handle of a string without interning it
+ *
+ * @param text                      string to find
+ * @param handle                    set to the handle of the string if found
+ * @return                          true if the string has been interned
+ */
+bool StringPool::find(string_view text, uint32_t &handle) const {
+    uint32_t hash = StringPool::hashString(text);
+    const Shard &shard = this->shards[hash >> 28];
+    lock_guard<mutex> lock(shard.mutex);
+
+    if (shard.size == 0) {
+        return false;
+    }
+
+    const Entry &entry = shard.entries[this->probe(shard, text, hash)];
+
+    if (entry.handle == NO_HANDLE) {
+        return false;
+    }
+
+    handle = entry.handle;
+
+    return true;
+}
+
+/**
+ * Retrieves the amount of strings in the pool, which have the handles from
+ * 0 up to this amount
+ *
+ * @return                          amount of strings
+ */
+size_t StringPool::getSize() const {
+    return min<size_t>(this->nextHandle.load(), MAX_SEGMENTS * SEGMENT_SIZE);
+}
+
+/**
+ * Retrieves the bytes of memory allocated for the pool: its characters,
+ * tables and segments of handles
+ *
+ * @return                          bytes allocated
+ */
+size_t StringPool::getMemoryUsage() const {
+    size_t bytes = sizeof(*this);
+
+    for (const Shard &shard : this->shards) {
+        lock_guard<mutex> lock(shard.mutex);
+        bytes += shard.blockBytes + shard.entries.capacity() * sizeof(Entry);
+    }
+
+    size_t segmentCount = (this->getSize() + SEGMENT_SIZE - 1) /
+                          SEGMENT_SIZE;
+
+    return bytes + segmentCount * SEGMENT_SIZE * sizeof(string_view);
+}
+
+/**
+ * Hashes a string
+ *
+ * @param text                      string to hash
+ * @return                          hash of string
+ */
+uint32_t StringPool::hashString(string_view text) {
+    // Widened first, so the shift is defined where size_t is 32 bits
+    uint64_t hash = std::hash<string_view>()(text);
+
+    // Folds in the high bits, since the top bits pick a shard and the low
+    // bits a position
+    return static_cast<uint32_t>(hash ^ (hash >> 32));
+}
+
+/**
+ * Finds the position of a string's entry in a shard's table, or of the
+ * empty entry that ends its probe sequence if the string is not interned
+ *
+ * @param shard                     shard of the string
+ * @param text                      string to find
+ * @param hash                      hash of string
+ * @return                          position in the shard's table
+ */
+size_t StringPool::probe(const Shard &shard, string_view text,
+                         uint32_t hash) const {
+    size_t mask = shard.entries.size() - 1;
+    size_t position = hash & mask;
+
+    while (true) {
+        const Entry &entry = shard.entries[position];
+
+        if (entry.handle == NO_HANDLE ||
+            (entry.hash == hash && this->get(entry.handle) == text)) {
+            return position;
+        }
+
+        position = (position + 1) & mask;
+    }
+}
+
+/**
+ * Copies a string into the blocks of a shard, starting a new block when the
+ * last one is full
+ *
+ * @param shard                     shard to store the string in
+ * @param text                      string to store
+ * @return                          view of the stored copy
+ */
+string_view StringPool::store(Shard &shard, string_view text) {
+    if (shard.blocks.empty() || text.size() > BLOCK_SIZE - shard.blockUsed) {
+        size_t blockSize = text.size() > BLOCK_SIZE ? text.size()
+                                                    : BLOCK_SIZE;
+        shard.blocks.emplace_back(new char[blockSize]);
+        shard.blockUsed = 0;
+        shard.blockBytes += blockSize;
+    }
+
+    char *stored = shard.blocks.back().get() + shard.blockUsed;
+    memcpy(stored, text.data(), text.size());
+    shard.blockUsed += text.size();
+
+    return string_view(stored, text.size());
+}
+
+/**
+ * Gives a stored string the next handle, allocating the segment the handle
+ * falls in if it is the first of its segment
+ *
+ * @param stored                    view of the stored string
+ * @return                          handle of the string
+ */
+uint32_t StringPool::newHandle(string_view stored) {
+    uint32_t handle = this->nextHandle.fetch_add(1);
+
+    if (handle / SEGMENT_SIZE >= MAX_SEGMENTS) {
+        throw length_error("String pool is full.");
+    }
+
+    atomic<string_view *> &segment = this->segments[handle / SEGMENT_SIZE];
+    string_view *strings = segment.load(memory_order_acquire);
+
+    if (strings == nullptr) {
+        lock_guard<mutex> lock(this->segmentMutex);
+        strings = segment.load(memory_order_relaxed);
+
+        if (strings == nullptr) {
+            strings = new string_view[SEGMENT_SIZE];
+            segment.store(strings, memory_order_release);
+        }
+    }
+
+    strings[handle % SEGMENT_SIZE] = stored;
+
+    return handle;
+}
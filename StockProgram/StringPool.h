@@ -0,0 +1,149 @@
+/******************************************************************************
+ *
+ * File        : StringPool.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define a pool of interned strings, such as
+ *               stock codes and descriptions, each stored once and referred
+ *               to by a 32 bit handle.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+/**
+ * Interns strings, storing each distinct string once and handing out a 32
+ * bit handle for it. Strings are never removed, so a handle and a view of
+ * its string stay valid for as long as the pool exists.
+ * Interning may be done from several threads at once: the pool is split
+ * into shards by hash, each with its own lock. Retrieving a string by its
+ * handle takes no lock.
+ *
+ * Both limits below are deliberate, as they are what let handles be
+ * compared and strings be read without reference counts or locks:
+ * - Memory is never given back. The pool holds every distinct string ever
+ *   interned, including those of items since removed or changed, so a long
+ *   running process reloading inventories whose codes or descriptions keep
+ *   changing grows by the text of each new string.
+ * - There are at most MAX_SEGMENTS * SEGMENT_SIZE handles (just under
+ *   2^32) for the life of the pool, after which interning a new string
+ *   throws length_error.
+ */
+class StringPool {
+private:
+    // Amount of shards interning is split into
+    static const size_t SHARD_COUNT = 16;
+
+    // Handles are given out in segments of this many
+    static const size_t SEGMENT_SIZE = 1 << 16;
+
+    // Most segments there can be (handles run out after these, before the
+    // largest 32 bit value)
+    static const size_t MAX_SEGMENTS = (1 << 16) - 1;
+
+    // Characters are stored in blocks of this many (longer strings are
+    // given a block of their own)
+    static const size_t BLOCK_SIZE = 1 << 16;
+
+    // An entry of a shard's hash table, empty when it holds no handle
+    struct Entry {
+        uint32_t hash;
+        uint32_t handle;
+    };
+
+    // Strings with the same hash go to the same shard
+    struct Shard {
+        // Lock held while interning into the shard
+        mutable std::mutex mutex;
+
+        // Open addressing table of the handles of the shard's strings,
+        // its size always a power of two
+        std::vector<Entry> entries;
+
+        // Amount of entries in use
+        size_t size = 0;
+
+        // Blocks the characters of the shard's strings are stored in
+        std::vector<std::unique_ptr<char[]>> blocks;
+
+        // Characters used of the last block
+        size_t blockUsed = 0;
+
+        // Bytes allocated for blocks
+        size_t blockBytes = 0;
+    };
+
+    // Shards of the pool
+    Shard shards[SHARD_COUNT];
+
+    // Segments of the string of each handle, allocated as needed
+    std::atomic<std::string_view *> segments[MAX_SEGMENTS];
+
+    // Lock held while allocating a segment
+    std::mutex segmentMutex;
+
+    // Next handle to give out
+    std::atomic<uint32_t> nextHandle;
+
+    // Hashes a string
+    static uint32_t hashString(std::string_view text);
+
+    // Finds the position of a string's entry in a shard, or the empty entry
+    // ending its probe sequence
+    size_t probe(const Shard &shard, std::string_view text,
+                 uint32_t hash) const;
+
+    // Copies a string into a shard's blocks
+    std::string_view store(Shard &shard, std::string_view text);
+
+    // Gives a stored string a new handle
+    uint32_t newHandle(std::string_view stored);
+
+public:
+    // StringPool Constructor
+    StringPool();
+
+    // StringPool Destructor
+    ~StringPool();
+
+    // Pools hand out views of their strings, so cannot be copied or moved
+    StringPool(const StringPool &pool) = delete;
+    StringPool &operator=(const StringPool &pool) = delete;
+
+    // Retrieves the pool shared by every stock item
+    static StringPool &global();
+
+    // Interns a string, returning its handle (throws length_error once
+    // every handle has been given out)
+    uint32_t intern(std::string_view text);
+
+    // Finds the handle of a string without interning it, returning false if
+    // it has not been interned
+    bool find(std::string_view text, uint32_t &handle) const;
+
+    // Retrieves the string of a handle
+    std::string_view get(uint32_t handle) const {
+        return this->segments[handle / SEGMENT_SIZE].load(
+                std::memory_order_acquire)[handle % SEGMENT_SIZE];
+    }
+
+    // Retrieves the amount of strings in the pool
+    size_t getSize() const;
+
+    // Retrieves the bytes of memory allocated for the pool
+    size_t getMemoryUsage() const;
+};
+
+#endif /* STRINGPOOL_H */
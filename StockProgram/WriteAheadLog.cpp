@@ -0,0 +1,869 @@
+/******************************************************************************
+ *
+ * File        : WriteAheadLog.cpp
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A file to define an append only log of the changes made to
+ *               an inventory, written to disk in groups so a crash loses
+ *               none that were synced.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include "InventorySnapshot.h"
+#include "MappedFile.h"
+#include "WriteAheadLog.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Identifies a file as a write-ahead log
+static const char LOG_MAGIC[8] = {'S', 'T', 'O', 'C', 'K', 'L', 'O', 'G'};
+
+// Size of the header at the start of the log: its magic, version and
+// padding
+static const size_t LOG_HEADER_SIZE = 16;
+
+// Size of the frame before each record: its length and checksum
+static const size_t FRAME_SIZE = 8;
+
+/**
+ * Computes the CRC-32 (as used by zip) of some bytes
+ *
+ * @param data                      bytes to check
+ * @param size                      amount of bytes
+ * @return                          checksum of bytes
+ */
+static uint32_t crc32(const char *data, size_t size) {
+    // Lambda building the table of every byte's remainder, once
+    static const vector<uint32_t> table = []() {
+        vector<uint32_t> remainders(256);
+
+        for (uint32_t byte = 0; byte < 256; byte++) {
+            uint32_t remainder = byte;
+
+            for (int bit = 0; bit < 8; bit++) {
+                remainder = (remainder >> 1) ^
+                            ((remainder & 1) ? 0xEDB88320u : 0);
+            }
+
+            remainders[byte] = remainder;
+        }
+
+        return remainders;
+    }();
+
+    uint32_t checksum = 0xFFFFFFFFu;
+
+    for (size_t i = 0; i < size; i++) {
+        checksum = table[(checksum ^ static_cast<uint8_t>(data[i])) & 0xFF] ^
+                   (checksum >> 8);
+    }
+
+    return ~checksum;
+}
+
+/**
+ * Appends a number to a record, in the byte order of the machine
+ *
+ * @param record                    record to append to
+ * @param value                     number to append
+ */
+template <typename T>
+static void putValue(vector<char> &record, T value) {
+    size_t position = record.size();
+    record.resize(position + sizeof(T));
+    memcpy(record.data() + position, &value, sizeof(T));
+}
+
+/**
+ * Appends a string to a record, after its length
+ *
+ * @param record                    record to append to
+ * @param text                      string to append
+ */
+static void putString(vector<char> &record, string_view text) {
+    putValue<uint32_t>(record, text.size());
+    record.insert(record.end(), text.begin(), text.end());
+}
+
+/**
+ * Reads the fields of a record in the order they were appended
+ */
+class RecordReader {
+private:
+    // Next field to read and end of the record
+    const char *position;
+    const char *end;
+
+public:
+    /**
+     * Constructs a reader of a record
+     *
+     * @param record                contents of the record
+     */
+    explicit RecordReader(string_view record)
+            : position(record.data()), end(record.data() + record.size()) {
+    }
+
+    /**
+     * Reads a number
+     *
+     * @return                      number read
+     * @throws invalid_argument     if the record ends first
+     */
+    template <typename T>
+    T readValue() {
+        if (static_cast<size_t>(this->end - this->position) < sizeof(T)) {
+            throw invalid_argument("Write-ahead log record is too short.");
+        }
+
+        T value;
+        memcpy(&value, this->position, sizeof(T));
+        this->position += sizeof(T);
+
+        return value;
+    }
+
+    /**
+     * Reads a string
+     *
+     * @return                      view of the string in the record
+     * @throws invalid_argument     if the record ends first
+     */
+    string_view readString() {
+        uint32_t length = this->readValue<uint32_t>();
+
+        if (static_cast<size_t>(this->end - this->position) < length) {
+            throw invalid_argument("Write-ahead log record is too short.");
+        }
+
+        string_view text(this->position, length);
+        this->position += length;
+
+        return text;
+    }
+};
+
+/**
+ * Appends every detail of an item to a record: its type, code, amount,
+ * price and the attributes specific to its type
+ *
+ * @param record                    record to append to
+ * @param item                      item to append
+ */
+static void putItem(vector<char> &record, const StockItem &item) {
+    putValue<uint8_t>(record, static_cast<uint8_t>(item.getType()));
+    putString(record, item.getStockCode());
+    putValue<int32_t>(record, item.getStockAmount());
+    putValue<int32_t>(record, item.getUnitPrice());
+
+    // Appends the attributes specific to each type of item
+    switch (item.getType()) {
+        case ComponentType::Resistor:
+            putValue<double>(record, static_cast<const Resistor &>(item)
+                    .getResistance());
+            break;
+        case ComponentType::Capacitor:
+            putValue<double>(record, static_cast<const Capacitor &>(item)
+                    .getCapacitance());
+            break;
+        case ComponentType::Transistor:
+            putValue<uint8_t>(record, static_cast<uint8_t>(
+                    static_cast<const Transistor &>(item).getDeviceType()));
+            break;
+        case ComponentType::IntegratedCircuit:
+            putString(record, static_cast<const IntegratedCircuit &>(item)
+                    .getDescription());
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+ * Reads every detail of an item appended by putItem, creating the item in
+ * an arena
+ *
+ * @param reader                    reader of the record
+ * @param arena                     arena to create the item in
+ * @return                          item read
+ * @throws invalid_argument         if the record is too short or holds an
+ *                                  invalid component type
+ */
+static StockItem *readItem(RecordReader &reader, ItemArena &arena) {
+    ComponentType componentType = static_cast<ComponentType>(
+            reader.readValue<uint8_t>());
+    string_view code = reader.readString();
+    int amount = reader.readValue<int32_t>();
+    int price = reader.readValue<int32_t>();
+
+    switch (componentType) {
+        case ComponentType::Resistor:
+            return arena.create<Resistor>(code, amount, price,
+                                          reader.readValue<double>());
+        case ComponentType::Capacitor:
+            return arena.create<Capacitor>(code, amount, price,
+                                           reader.readValue<double>());
+        case ComponentType::Diode:
+            return arena.create<Diode>(code, amount, price);
+        case ComponentType::Transistor:
+            return arena.create<Transistor>(
+                    code, amount, price,
+                    static_cast<DeviceType>(reader.readValue<uint8_t>()));
+        case ComponentType::IntegratedCircuit:
+            return arena.create<IntegratedCircuit>(code, amount, price,
+                                                   reader.readString());
+        default:
+            throw invalid_argument("Invalid component in write-ahead log.");
+    }
+}
+
+/**
+ * Checks whether two items have the same type, code, amount, price and
+ * type specific attributes
+ *
+ * @param item1                     first item
+ * @param item2                     second item
+ * @return                          true if every detail matches
+ */
+static bool sameItem(const StockItem &item1, const StockItem &item2) {
+    if (item1.getType() != item2.getType() ||
+        item1.getStockCodeId() != item2.getStockCodeId() ||
+        item1.getStockAmount() != item2.getStockAmount() ||
+        item1.getUnitPrice() != item2.getUnitPrice()) {
+        return false;
+    }
+
+    switch (item1.getType()) {
+        case ComponentType::Resistor:
+            return static_cast<const Resistor &>(item1).getResistance() ==
+                   static_cast<const Resistor &>(item2).getResistance();
+        case ComponentType::Capacitor:
+            return static_cast<const Capacitor &>(item1).getCapacitance() ==
+                   static_cast<const Capacitor &>(item2).getCapacitance();
+        case ComponentType::Transistor:
+            return static_cast<const Transistor &>(item1).getDeviceType() ==
+                   static_cast<const Transistor &>(item2).getDeviceType();
+        case ComponentType::IntegratedCircuit:
+            return static_cast<const IntegratedCircuit &>(item1)
+                           .getDescriptionId() ==
+                   static_cast<const IntegratedCircuit &>(item2)
+                           .getDescriptionId();
+        default:
+            return true;
+    }
+}
+
+/**
+ * Finds each whole record of a log with a correct checksum, from the start
+ * up to the first that is torn or corrupt, as the last record written
+ * before a crash may be
+ *
+ * @param contents                  contents of the log
+ * @param apply                     function taking the contents of each
+ *                                  record found
+ * @return                          size of the log up to the last record
+ *                                  found
+ */
+template <typename ApplyFunction>
+static size_t scanRecords(string_view contents, ApplyFunction apply) {
+    size_t position = LOG_HEADER_SIZE;
+
+    while (contents.size() - position >= FRAME_SIZE) {
+        uint32_t length;
+        uint32_t checksum;
+        memcpy(&length, contents.data() + position, sizeof(length));
+        memcpy(&checksum, contents.data() + position + 4, sizeof(checksum));
+
+        size_t start = position + FRAME_SIZE;
+
+        if (length == 0 || contents.size() - start < length ||
+            crc32(contents.data() + start, length) != checksum) {
+            break;
+        }
+
+        apply(contents.substr(start, length));
+        position = start + length;
+    }
+
+    return position;
+}
+
+/**
+ * Writes bytes to a file, however many writes it takes
+ *
+ * @param fd                        descriptor of file
+ * @param data                      bytes to write
+ * @param size                      amount of bytes
+ * @return                          true if every byte was written
+ */
+static bool writeAll(int fd, const char *data, size_t size) {
+    while (size > 0) {
+        auto written = write(fd, data, size);
+
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return false;
+        }
+
+        data += written;
+        size -= written;
+    }
+
+    return true;
+}
+
+/**
+ * Makes what has been written to a file durable
+ *
+ * @param fd                        descriptor of file
+ * @return                          true if the file was synced
+ */
+static bool syncFile(int fd) {
+#if defined(_WIN32)
+    return _commit(fd) == 0;
+#elif defined(__linux__)
+    // Skips syncing the file's times, which recovery does not need
+    return fdatasync(fd) == 0;
+#else
+    return fsync(fd) == 0;
+#endif
+}
+
+/**
+ * Cuts a file down to a size
+ *
+ * @param fd                        descriptor of file
+ * @param size                      size to cut the file to
+ * @return                          true if the file was cut
+ */
+static bool truncateFile(int fd, size_t size) {
+#ifdef _WIN32
+    return _chsize_s(fd, size) == 0;
+#else
+    return ftruncate(fd, size) == 0;
+#endif
+}
+
+/**
+ * Makes a file written by name durable, along with its name in its
+ * directory
+ *
+ * @param fileName                  name of file
+ * @return                          true if the file was synced
+ */
+static bool syncFileNamed(const string &fileName) {
+    int fd = open(fileName.c_str(), O_RDONLY);
+
+    if (fd < 0) {
+        return false;
+    }
+
+    bool synced = syncFile(fd);
+    close(fd);
+
+#ifndef _WIN32
+    string directory = filesystem::path(fileName).parent_path().string();
+    int directoryFd = open(directory.empty() ? "." : directory.c_str(),
+                           O_RDONLY);
+
+    if (directoryFd >= 0) {
+        synced = fsync(directoryFd) == 0 && synced;
+        close(directoryFd);
+    }
+#endif
+
+    return synced;
+}
+
+/**
+ * Empties a file and writes the header of a log of the current version to
+ * it. A crash before the header is synced leaves the file empty, which is
+ * taken for a new log.
+ *
+ * @param fd                        descriptor of file, opened for appending
+ * @return                          true if the header was written and synced
+ */
+static bool writeHeader(int fd) {
+    char header[LOG_HEADER_SIZE] = {};
+    memcpy(header, LOG_MAGIC, sizeof(LOG_MAGIC));
+    memcpy(header + sizeof(LOG_MAGIC), &LOG_VERSION, sizeof(LOG_VERSION));
+
+    return truncateFile(fd, 0) && writeAll(fd, header, LOG_HEADER_SIZE) &&
+           syncFile(fd);
+}
+
+/**
+ * Opens a log file, creating it with a header if it does not exist, and
+ * cuts off any torn record at its end so new records follow the last whole
+ * one. A log of an older version with no records is given a header of the
+ * current version, while one with records keeps its version, so that each
+ * file holds records of one format. Starts the thread writing records to it.
+ *
+ * @param fileName                  name of log file
+ * @throws invalid_argument         if the file is not a log
+ * @throws runtime_error            if the file cannot be opened
+ */
+WriteAheadLog::WriteAheadLog(const string &fileName)
+        : fileName(fileName), version(LOG_VERSION), appendedCount(0),
+          durableCount(0),
+          syncCount(0), failed(false), closing(false) {
+    size_t validSize = 0;
+    size_t size = 0;
+
+    {
+        MappedFile file(fileName);
+        string_view contents = file.getContents();
+        size = file.getSize();
+
+        if (size > 0) {
+            if (size < LOG_HEADER_SIZE ||
+                memcmp(contents.data(), LOG_MAGIC, sizeof(LOG_MAGIC)) != 0) {
+                throw invalid_argument(fileName +
+                                       " is not a write-ahead log.");
+            }
+
+            memcpy(&this->version, contents.data() + sizeof(LOG_MAGIC),
+                   sizeof(this->version));
+
+            if (this->version < OLDEST_LOG_VERSION ||
+                this->version > LOG_VERSION) {
+                throw invalid_argument(fileName + " is a write-ahead log of "
+                                       "an unsupported version.");
+            }
+
+            validSize = scanRecords(contents, [](string_view) {});
+        }
+    }
+
+#ifdef _WIN32
+    this->fd = _open(fileName.c_str(), _O_RDWR | _O_CREAT | _O_APPEND |
+                                       _O_BINARY, _S_IREAD | _S_IWRITE);
+#else
+    this->fd = open(fileName.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+#endif
+
+    if (this->fd < 0) {
+        throw runtime_error("Could not open write-ahead log " + fileName +
+                            ".");
+    }
+
+    bool ready;
+
+    if (size == 0 || (this->version != LOG_VERSION &&
+                      validSize == LOG_HEADER_SIZE)) {
+        ready = writeHeader(this->fd);
+        this->version = LOG_VERSION;
+    } else if (validSize < size) {
+        ready = truncateFile(this->fd, validSize) && syncFile(this->fd);
+    } else {
+        ready = true;
+    }
+
+    if (!ready) {
+        close(this->fd);
+        throw runtime_error("Could not prepare write-ahead log " + fileName +
+                            ".");
+    }
+
+    this->writer = thread(&WriteAheadLog::writeRecords, this);
+}
+
+/**
+ * Closes the log, once every record appended has been written and synced
+ */
+WriteAheadLog::~WriteAheadLog() {
+    {
+        lock_guard<std::mutex> lock(this->mutex);
+        this->closing = true;
+    }
+
+    this->writeNeeded.notify_one();
+    this->writer.join();
+
+    close(this->fd);
+}
+
+/**
+ * Applies every record in the log to an inventory, such as one just loaded
+ * from the last snapshot. Adds items that are missing, and sets the values
+ * recorded on items that are there, so records the snapshot already holds
+ * do no harm. Changes to items that are missing are skipped, and an item
+ * removed is only removed if every detail recorded matches. Records name
+ * items by stock code, so the inventory's codes must be unique, as those of
+ * the watched inventory that logged them were. Should be called before the
+ * log watches the inventory, so the changes are not logged again.
+ *
+ * @param inventory                 inventory to apply the records to
+ * @return                          amount of records applied
+ * @throws invalid_argument         if a record holds invalid values, or
+ *                                  items of the inventory share a code
+ */
+size_t WriteAheadLog::replay(Inventory &inventory) {
+    if (inventory.hasDuplicateCodes()) {
+        throw invalid_argument("Cannot replay a write-ahead log into an "
+                               "inventory with items sharing a stock code.");
+    }
+
+    this->sync();
+
+    MappedFile file(this->fileName);
+    size_t recordCount = 0;
+
+    // Items read from records, destroyed once applied
+    ItemArena loggedItems;
+
+    scanRecords(file.getContents(), [&](string_view record) {
+        RecordReader reader(record);
+        LogRecordType type = static_cast<LogRecordType>(
+                reader.readValue<uint8_t>());
+        recordCount++;
+
+        if (type == LogRecordType::PutItem) {
+            StockItem *loggedItem = readItem(reader, loggedItems);
+            StockItem *item = inventory.find(loggedItem->getStockCode());
+
+            if (item == nullptr) {
+                inventory.addCopy(*loggedItem);
+            } else if (item->getType() != loggedItem->getType()) {
+                throw invalid_argument("Write-ahead log changes the type "
+                                       "of an item.");
+            } else {
+                item->setStockAmount(loggedItem->getStockAmount());
+                item->setUnitPrice(loggedItem->getUnitPrice());
+
+                // Sets the attributes specific to each type of item
+                switch (item->getType()) {
+                    case ComponentType::Resistor:
+                        static_cast<Resistor *>(item)->setResistance(
+                                static_cast<Resistor *>(loggedItem)
+                                        ->getResistance());
+                        break;
+                    case ComponentType::Capacitor:
+                        static_cast<Capacitor *>(item)->setCapacitance(
+                                static_cast<Capacitor *>(loggedItem)
+                                        ->getCapacitance());
+                        break;
+                    case ComponentType::Transistor:
+                        static_cast<Transistor *>(item)->setDeviceType(
+                                static_cast<Transistor *>(loggedItem)
+                                        ->getDeviceType());
+                        break;
+                    case ComponentType::IntegratedCircuit:
+                        static_cast<IntegratedCircuit *>(item)
+                                ->setDescription(
+                                        static_cast<IntegratedCircuit *>(
+                                                loggedItem)->getDescription());
+                        break;
+                    default:
+                        break;
+                }
+            }
+
+            loggedItems.destroy(loggedItem);
+        } else if (type == LogRecordType::StockAmount) {
+            string_view code = reader.readString();
+            int amount = reader.readValue<int32_t>();
+
+            if (StockItem *item = inventory.find(code)) {
+                item->setStockAmount(amount);
+            }
+        } else if (type == LogRecordType::UnitPrice) {
+            string_view code = reader.readString();
+            int price = reader.readValue<int32_t>();
+
+            if (StockItem *item = inventory.find(code)) {
+                item->setUnitPrice(price);
+            }
+        } else if (type == LogRecordType::StockCode) {
+            string_view oldCode = reader.readString();
+            string_view newCode = reader.readString();
+
+            if (StockItem *item = inventory.find(oldCode)) {
+                item->setStockCode(newCode);
+
+                if (inventory.hasDuplicateCodes()) {
+                    throw invalid_argument("Write-ahead log gives an item "
+                                           "the stock code of another.");
+                }
+            }
+        } else if (type == LogRecordType::RemoveItem &&
+                   this->version == 1) {
+            // Version 1 recorded only the code of an item removed
+            if (StockItem *item = inventory.find(reader.readString())) {
+                inventory.remove({item});
+            }
+        } else if (type == LogRecordType::RemoveItem) {
+            // Removes the item only if it has every detail logged, so an
+            // item added back under the code after the removal stays
+            StockItem *loggedItem = readItem(reader, loggedItems);
+            StockItem *item = inventory.find(loggedItem->getStockCode());
+
+            if (item != nullptr && sameItem(*item, *loggedItem)) {
+                inventory.remove({item});
+            }
+
+            loggedItems.destroy(loggedItem);
+        } else {
+            throw invalid_argument("Invalid record in write-ahead log.");
+        }
+    });
+
+    return recordCount;
+}
+
+/**
+ * Waits for every record appended so far to be written and synced to disk
+ *
+ * @throws runtime_error            if writing to the log has failed
+ */
+void WriteAheadLog::sync() {
+    unique_lock<std::mutex> lock(this->mutex);
+    uint64_t target = this->appendedCount;
+
+    this->recordsDurable.wait(lock, [this, target]() {
+        return this->durableCount >= target || this->failed;
+    });
+
+    if (this->failed) {
+        throw runtime_error("Could not write to write-ahead log " +
+                            this->fileName + ".");
+    }
+}
+
+/**
+ * Writes a snapshot of an inventory, then empties the log of the records
+ * the snapshot now holds. The snapshot is written beside its file and
+ * renamed over it once synced, so a crash leaves either snapshot whole, and
+ * the log is only emptied after. The inventory must not change meanwhile.
+ *
+ * @param inventory                 inventory the log has recorded
+ * @param snapshotFile              name of snapshot file
+ * @return                          true if the checkpoint was made
+ */
+bool WriteAheadLog::checkpoint(Inventory &inventory,
+                               const string &snapshotFile) {
+    this->sync();
+
+    string writingFile = snapshotFile + ".tmp";
+
+    if (!writeInventorySnapshot(inventory, writingFile) ||
+        !syncFileNamed(writingFile) ||
+        rename(writingFile.c_str(), snapshotFile.c_str()) != 0 ||
+        !syncFileNamed(snapshotFile)) {
+        return false;
+    }
+
+    lock_guard<std::mutex> lock(this->mutex);
+
+    // Records appended since the sync are not in the snapshot
+    if (!this->pending.empty() || this->durableCount != this->appendedCount) {
+        return false;
+    }
+
+    // An emptied log of an older version starts afresh in the current one
+    if (this->version != LOG_VERSION) {
+        if (!writeHeader(this->fd)) {
+            return false;
+        }
+
+        this->version = LOG_VERSION;
+        return true;
+    }
+
+    return truncateFile(this->fd, LOG_HEADER_SIZE) && syncFile(this->fd);
+}
+
+/**
+ * Retrieves the amount of records appended since the log was opened
+ *
+ * @return                          amount of records
+ */
+uint64_t WriteAheadLog::getAppendedCount() {
+    lock_guard<std::mutex> lock(this->mutex);
+
+    return this->appendedCount;
+}
+
+/**
+ * Retrieves the amount of syncs made to disk since the log was opened, each
+ * making a group of records durable
+ *
+ * @return                          amount of syncs
+ */
+uint64_t WriteAheadLog::getSyncCount() {
+    lock_guard<std::mutex> lock(this->mutex);
+
+    return this->syncCount;
+}
+
+/**
+ * Records an item's new stock code
+ *
+ * @param item                      item that changed
+ * @param oldCode                   previous stock code of item
+ */
+void WriteAheadLog::stockCodeChanged(StockItem &item, string_view oldCode) {
+    this->append(LogRecordType::StockCode, [&](vector<char> &record) {
+        putString(record, oldCode);
+        putString(record, item.getStockCode());
+    });
+}
+
+/**
+ * Records an item's new stock amount
+ *
+ * @param item                      item that changed
+ * @param oldAmount                 previous stock amount of item (unused)
+ */
+void WriteAheadLog::stockAmountChanged(StockItem &item, int) {
+    this->append(LogRecordType::StockAmount, [&](vector<char> &record) {
+        putString(record, item.getStockCode());
+        putValue<int32_t>(record, item.getStockAmount());
+    });
+}
+
+/**
+ * Records an item's new unit price
+ *
+ * @param item                      item that changed
+ * @param oldPrice                  previous unit price of item (unused)
+ */
+void WriteAheadLog::unitPriceChanged(StockItem &item, int) {
+    this->append(LogRecordType::UnitPrice, [&](vector<char> &record) {
+        putString(record, item.getStockCode());
+        putValue<int32_t>(record, item.getUnitPrice());
+    });
+}
+
+/**
+ * Records every detail of an item whose type specific attribute changed
+ *
+ * @param item                      item that changed
+ */
+void WriteAheadLog::attributeChanged(StockItem &item) {
+    this->itemAdded(item);
+}
+
+/**
+ * Records every detail of an item added
+ *
+ * @param item                      item added
+ */
+void WriteAheadLog::itemAdded(StockItem &item) {
+    this->append(LogRecordType::PutItem, [&](vector<char> &record) {
+        putItem(record, item);
+    });
+}
+
+/**
+ * Records every detail of an item removed, so replay leaves an item added
+ * back under its code (only its code in a log of version 1)
+ *
+ * @param item                      item being removed
+ */
+void WriteAheadLog::itemRemoved(StockItem &item) {
+    this->append(LogRecordType::RemoveItem, [&](vector<char> &record) {
+        if (this->version == 1) {
+            putString(record, item.getStockCode());
+        } else {
+            putItem(record, item);
+        }
+    });
+}
+
+/**
+ * Appends a record to the buffer, framed by its length and checksum, and
+ * wakes the writer if the buffer was empty. Waits while the buffer is full.
+ *
+ * @param type                      kind of change recorded
+ * @param encode                    function appending the record's fields
+ *                                  to a vector
+ * @throws runtime_error            if writing to the log has failed
+ */
+template <typename EncodeFunction>
+void WriteAheadLog::append(LogRecordType type, EncodeFunction encode) {
+    unique_lock<std::mutex> lock(this->mutex);
+
+    this->recordsDurable.wait(lock, [this]() {
+        return this->pending.size() < MAX_PENDING_BYTES || this->failed;
+    });
+
+    if (this->failed) {
+        throw runtime_error("Could not write to write-ahead log " +
+                            this->fileName + ".");
+    }
+
+    bool wasEmpty = this->pending.empty();
+    size_t start = this->pending.size();
+
+    // Leaves room for the frame, filled in once the record is encoded
+    this->pending.resize(start + FRAME_SIZE);
+    putValue<uint8_t>(this->pending, static_cast<uint8_t>(type));
+    encode(this->pending);
+
+    uint32_t length = this->pending.size() - start - FRAME_SIZE;
+    uint32_t checksum = crc32(this->pending.data() + start + FRAME_SIZE,
+                              length);
+    memcpy(this->pending.data() + start, &length, sizeof(length));
+    memcpy(this->pending.data() + start + 4, &checksum, sizeof(checksum));
+
+    this->appendedCount++;
+    lock.unlock();
+
+    if (wasEmpty) {
+        this->writeNeeded.notify_one();
+    }
+}
+
+/**
+ * Writes the records in the buffer to the file and syncs them, for as long
+ * as the log is open. Records appended while a group is being written and
+ * synced wait in the buffer, and are written together as the next group.
+ */
+void WriteAheadLog::writeRecords() {
+    vector<char> writing;
+    unique_lock<std::mutex> lock(this->mutex);
+
+    while (true) {
+        this->writeNeeded.wait(lock, [this]() {
+            return !this->pending.empty() || this->closing;
+        });
+
+        if (this->pending.empty()) {
+            break;
+        }
+
+        writing.swap(this->pending);
+        uint64_t groupEnd = this->appendedCount;
+        lock.unlock();
+
+        bool written = writeAll(this->fd, writing.data(), writing.size()) &&
+                       syncFile(this->fd);
+        writing.clear();
+
+        lock.lock();
+        this->failed = this->failed || !written;
+        this->durableCount = groupEnd;
+        this->syncCount++;
+        this->recordsDurable.notify_all();
+    }
+}
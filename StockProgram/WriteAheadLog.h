@@ -0,0 +1,139 @@
+/******************************************************************************
+ *
+ * File        : WriteAheadLog.h
+ *
+ * Date        : 17 October 2026
+ *
+ * Description : A header file to define an append only log of the changes
+ *               made to an inventory, written to disk in groups so a crash
+ *               loses none that were synced.
+ *
+ * Author      : Ali Jarjis
+ *
+ ******************************************************************************/
+
+#ifndef WRITEAHEADLOG_H
+#define WRITEAHEADLOG_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Inventory.h"
+
+// Current version of the log format, increased on any layout change.
+// Version 2 records every detail of an item removed, where version 1
+// recorded only its stock code.
+const uint32_t LOG_VERSION = 2;
+
+// Oldest version of the log format still read
+const uint32_t OLDEST_LOG_VERSION = 1;
+
+// Kinds of change recorded in the log (values must never change, new kinds
+// are only added at the end)
+enum class LogRecordType : uint8_t {
+    PutItem, StockAmount, UnitPrice, StockCode, RemoveItem
+};
+
+/**
+ * Logs every change made to a watched inventory, so that the inventory can
+ * be recovered after a crash from its last snapshot and the log.
+ *
+ * Each record is framed by its length and a CRC-32 of its contents, and
+ * holds the new value of what changed rather than the difference, so
+ * replaying a record twice does no harm. Changes are appended to a buffer
+ * in memory and a background thread writes the buffer and syncs it to disk
+ * whenever there is any, so every change made during one sync is made
+ * durable by the next (group commit). sync waits for the changes made so
+ * far to be durable.
+ */
+class WriteAheadLog : public StockItemObserver {
+private:
+    // Name of the log file
+    std::string fileName;
+
+    // Descriptor of the log file, opened for appending
+    int fd;
+
+    // Version of the log file's format, which records are written in until
+    // a checkpoint empties the file
+    uint32_t version;
+
+    // Lock guarding the buffer and sequence numbers
+    std::mutex mutex;
+
+    // Woken when there are records to write, or the log is closing
+    std::condition_variable writeNeeded;
+
+    // Woken when records have been made durable
+    std::condition_variable recordsDurable;
+
+    // Records appended and not yet written
+    std::vector<char> pending;
+
+    // Amount of records appended, and of those made durable
+    uint64_t appendedCount;
+    uint64_t durableCount;
+
+    // Amount of syncs made to disk
+    uint64_t syncCount;
+
+    // Whether writing to the file has failed
+    bool failed;
+
+    // Whether the log is closing
+    bool closing;
+
+    // Thread writing records to the file
+    std::thread writer;
+
+    // Appends a record, encoded by a function, to the buffer
+    template <typename EncodeFunction>
+    void append(LogRecordType type, EncodeFunction encode);
+
+    // Writes records to the file until the log closes
+    void writeRecords();
+
+public:
+    // Most bytes of records held in memory before appending waits
+    static const size_t MAX_PENDING_BYTES = 64 << 20;
+
+    // WriteAheadLog Constructor (opens or creates the log file)
+    explicit WriteAheadLog(const std::string &fileName);
+
+    // WriteAheadLog Destructor (writes and syncs every record)
+    ~WriteAheadLog();
+
+    // Logs cannot be copied
+    WriteAheadLog(const WriteAheadLog &log) = delete;
+    WriteAheadLog &operator=(const WriteAheadLog &log) = delete;
+
+    // Applies every record in the log to an inventory
+    size_t replay(Inventory &inventory);
+
+    // Waits for every record appended so far to be durable
+    void sync();
+
+    // Snapshots an inventory, then empties the log
+    bool checkpoint(Inventory &inventory, const std::string &snapshotFile);
+
+    // Retrieves the amount of records appended
+    uint64_t getAppendedCount();
+
+    // Retrieves the amount of syncs made to disk
+    uint64_t getSyncCount();
+
+    // Records the changes made to the items of a watched inventory
+    void stockCodeChanged(StockItem &item, std::string_view oldCode) override;
+    void stockAmountChanged(StockItem &item, int oldAmount) override;
+    void unitPriceChanged(StockItem &item, int oldPrice) override;
+    void attributeChanged(StockItem &item) override;
+    void itemAdded(StockItem &item) override;
+    void itemRemoved(StockItem &item) override;
+};
+
+#endif /* WRITEAHEADLOG_H */
@@ -35,17 +35,37 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 
 # Object Files
 OBJECTFILES= \
+	${OBJECTDIR}/Aggregation.o \
+	${OBJECTDIR}/ConcurrentInventory.o \
+	${OBJECTDIR}/DescriptionIndex.o \
 	${OBJECTDIR}/Inventory.o \
+	${OBJECTDIR}/InventoryReader.o \
+	${OBJECTDIR}/InventoryReloader.o \
+	${OBJECTDIR}/InventorySnapshot.o \
+	${OBJECTDIR}/MappedFile.o \
+	${OBJECTDIR}/ParametricIndex.o \
+	${OBJECTDIR}/PriceIndex.o \
+	${OBJECTDIR}/Query.o \
+	${OBJECTDIR}/QueryLanguage.o \
+	${OBJECTDIR}/ReportWriter.o \
+	${OBJECTDIR}/ShardedInventory.o \
+	${OBJECTDIR}/StockCodeIndex.o \
+	${OBJECTDIR}/StockCodeTrie.o \
+	${OBJECTDIR}/StockColumns.o \
 	${OBJECTDIR}/StockItem.o \
-	${OBJECTDIR}/StockProgram.o
+	${OBJECTDIR}/StockProgram.o \
+	${OBJECTDIR}/StockRecord.o \
+	${OBJECTDIR}/StockReservation.o \
+	${OBJECTDIR}/StringPool.o \
+	${OBJECTDIR}/WriteAheadLog.o
 
 
 # C Compiler Flags
 CFLAGS=
 
 # CC Compiler Flags
-CCFLAGS=
-CXXFLAGS=
+CCFLAGS=-std=c++17 -pthread
+CXXFLAGS=-std=c++17 -pthread
 
 # Fortran Compiler Flags
 FFLAGS=
@@ -54,7 +74,7 @@ FFLAGS=
 ASFLAGS=
 
 # Link Libraries and Options
-LDLIBSOPTIONS=
+LDLIBSOPTIONS=-pthread
 
 # Build Targets
 .build-conf: ${BUILD_SUBPROJECTS}
@@ -64,20 +84,120 @@ ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/stockprogram.exe: ${OBJECTFILES}
 	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
 	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/stockprogram ${OBJECTFILES} ${LDLIBSOPTIONS}
 
+${OBJECTDIR}/Aggregation.o: Aggregation.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Aggregation.o Aggregation.cpp
+
+${OBJECTDIR}/ConcurrentInventory.o: ConcurrentInventory.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ConcurrentInventory.o ConcurrentInventory.cpp
+
+${OBJECTDIR}/DescriptionIndex.o: DescriptionIndex.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/DescriptionIndex.o DescriptionIndex.cpp
+
 ${OBJECTDIR}/Inventory.o: Inventory.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
-	$(COMPILE.cc) -O2 -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Inventory.o Inventory.cpp
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Inventory.o Inventory.cpp
+
+${OBJECTDIR}/InventoryReader.o: InventoryReader.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/InventoryReader.o InventoryReader.cpp
+
+${OBJECTDIR}/InventoryReloader.o: InventoryReloader.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/InventoryReloader.o InventoryReloader.cpp
+
+${OBJECTDIR}/InventorySnapshot.o: InventorySnapshot.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/InventorySnapshot.o InventorySnapshot.cpp
+
+${OBJECTDIR}/MappedFile.o: MappedFile.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MappedFile.o MappedFile.cpp
+
+${OBJECTDIR}/ParametricIndex.o: ParametricIndex.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ParametricIndex.o ParametricIndex.cpp
+
+${OBJECTDIR}/PriceIndex.o: PriceIndex.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/PriceIndex.o PriceIndex.cpp
+
+${OBJECTDIR}/Query.o: Query.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Query.o Query.cpp
+
+${OBJECTDIR}/QueryLanguage.o: QueryLanguage.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/QueryLanguage.o QueryLanguage.cpp
+
+${OBJECTDIR}/ReportWriter.o: ReportWriter.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ReportWriter.o ReportWriter.cpp
+
+${OBJECTDIR}/ShardedInventory.o: ShardedInventory.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ShardedInventory.o ShardedInventory.cpp
+
+${OBJECTDIR}/StockCodeIndex.o: StockCodeIndex.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockCodeIndex.o StockCodeIndex.cpp
+
+${OBJECTDIR}/StockCodeTrie.o: StockCodeTrie.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockCodeTrie.o StockCodeTrie.cpp
+
+${OBJECTDIR}/StockColumns.o: StockColumns.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockColumns.o StockColumns.cpp
 
 ${OBJECTDIR}/StockItem.o: StockItem.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
-	$(COMPILE.cc) -O2 -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockItem.o StockItem.cpp
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockItem.o StockItem.cpp
 
 ${OBJECTDIR}/StockProgram.o: StockProgram.cpp
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
-	$(COMPILE.cc) -O2 -std=c++11 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockProgram.o StockProgram.cpp
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockProgram.o StockProgram.cpp
+
+${OBJECTDIR}/StockRecord.o: StockRecord.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockRecord.o StockRecord.cpp
+
+${OBJECTDIR}/StockReservation.o: StockReservation.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StockReservation.o StockReservation.cpp
+
+${OBJECTDIR}/StringPool.o: StringPool.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/StringPool.o StringPool.cpp
+
+${OBJECTDIR}/WriteAheadLog.o: WriteAheadLog.cpp
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -O2 -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/WriteAheadLog.o WriteAheadLog.cpp
 
 # Subprojects
 .build-subprojects: